@@ -8,6 +8,10 @@
    - Added function infrared_remote_get_button_by_name()
    - Added function infrared_remote_delete_button_by_name()
    - Added function infrared_remote_push_button()
+   - Added function infrared_remote_get_button_by_command()
+   - Added function infrared_remote_get_footprint()
+   - Added function infrared_remote_pop_button()
+   - Button names are interned in the command table or remote name pool
 */
 
 #include "infrared_remote.h"
@@ -17,17 +21,22 @@
 #include <stdlib.h>
 #include <m-array.h>
 #include <string.h>
+#include <strings.h>
 #include <ctype.h>
 #include <toolbox/path.h>
 #include <storage/storage.h>
 #include <core/common_defines.h>
 
+#include "../xremote_buttons.h"
+
 #define TAG "InfraredRemote"
 
 ARRAY_DEF(InfraredButtonArray, InfraredRemoteButton*, M_PTR_OPLIST);
+ARRAY_DEF(InfraredNamePool, char*, M_PTR_OPLIST);
 
 struct InfraredRemote {
     InfraredButtonArray_t buttons;
+    InfraredNamePool_t names;
     FuriString* name;
     FuriString* path;
 };
@@ -39,11 +48,54 @@ static void infrared_remote_clear_buttons(InfraredRemote* remote) {
         infrared_remote_button_free(*InfraredButtonArray_cref(it));
     }
     InfraredButtonArray_reset(remote->buttons);
+
+    /* Pooled names are referenced by buttons only */
+    InfraredNamePool_it_t name_it;
+    for(InfraredNamePool_it(name_it, remote->names); !InfraredNamePool_end_p(name_it);
+        InfraredNamePool_next(name_it)) {
+        free(*InfraredNamePool_cref(name_it));
+    }
+    InfraredNamePool_reset(remote->names);
+}
+
+static const char*
+    infrared_remote_intern_name(InfraredRemote* remote, const char* name, int* command) {
+    const char* interned = NULL;
+    *command = xremote_button_intern(name, &interned);
+    if(interned != NULL) return interned;
+
+    InfraredNamePool_it_t it;
+    for(InfraredNamePool_it(it, remote->names); !InfraredNamePool_end_p(it);
+        InfraredNamePool_next(it)) {
+        const char* pooled = *InfraredNamePool_cref(it);
+        if(!strcmp(pooled, name)) return pooled;
+    }
+
+    char* pooled = strdup(name);
+    InfraredNamePool_push_back(remote->names, pooled);
+    return pooled;
+}
+
+static void infrared_remote_button_set_interned_name(
+    InfraredRemote* remote,
+    InfraredRemoteButton* button,
+    const char* name) {
+    int command = -1;
+    const char* interned = infrared_remote_intern_name(remote, name, &command);
+    infrared_remote_button_set_name(button, interned, command);
+}
+
+static bool
+    infrared_remote_button_is_named(InfraredRemoteButton* button, const char* name, int command) {
+    /* Canonical names are equal only if their commands are equal */
+    if(command >= 0) return infrared_remote_button_get_command(button) == command;
+    return !strcasecmp(infrared_remote_button_get_name(button), name);
 }
 
 InfraredRemote* infrared_remote_alloc() {
     InfraredRemote* remote = malloc(sizeof(InfraredRemote));
     InfraredButtonArray_init(remote->buttons);
+    InfraredNamePool_init(remote->names);
     remote->name = furi_string_alloc();
     remote->path = furi_string_alloc();
     return remote;
@@ -52,6 +104,7 @@ InfraredRemote* infrared_remote_alloc() {
 void infrared_remote_free(InfraredRemote* remote) {
     infrared_remote_clear_buttons(remote);
     InfraredButtonArray_clear(remote->buttons);
+    InfraredNamePool_clear(remote->names);
     furi_string_free(remote->path);
     furi_string_free(remote->name);
     free(remote);
@@ -83,17 +136,35 @@ size_t infrared_remote_get_button_count(InfraredRemote* remote) {
     return InfraredButtonArray_size(remote->buttons);
 }
 
+size_t infrared_remote_get_footprint(InfraredRemote* remote) {
+    size_t size = sizeof(InfraredRemote);
+    size_t count = InfraredButtonArray_size(remote->buttons);
+    size += count * sizeof(InfraredRemoteButton*);
+
+    for(size_t i = 0; i < count; i++) {
+        InfraredRemoteButton* button = *InfraredButtonArray_get(remote->buttons, i);
+        size += infrared_remote_button_get_footprint(button);
+    }
+
+    /* Names from the command table are static and cost nothing */
+    for(size_t i = 0; i < InfraredNamePool_size(remote->names); i++)
+        size += strlen(*InfraredNamePool_get(remote->names, i)) + 1;
+
+    return size;
+}
+
 InfraredRemoteButton* infrared_remote_get_button(InfraredRemote* remote, size_t index) {
     furi_assert(index < InfraredButtonArray_size(remote->buttons));
     return *InfraredButtonArray_get(remote->buttons, index);
 }
 
 bool infrared_remote_find_button_by_name(InfraredRemote* remote, const char* name, size_t* index) {
+    const char* interned = NULL;
+    int command = xremote_button_intern(name, &interned);
+
     for(size_t i = 0; i < InfraredButtonArray_size(remote->buttons); i++) {
         InfraredRemoteButton* button = *InfraredButtonArray_get(remote->buttons, i);
-        FuriString* furi_name = infrared_remote_button_get_furi_name(button);
-
-        if(button && !furi_string_cmpi_str(furi_name, name)) {
+        if(button && infrared_remote_button_is_named(button, name, command)) {
             *index = i;
             return true;
         }
@@ -103,17 +174,22 @@ bool infrared_remote_find_button_by_name(InfraredRemote* remote, const char* nam
 
 InfraredRemoteButton*
     infrared_remote_get_button_by_name(InfraredRemote* remote, const char* name) {
+    size_t index = 0;
+    if(!infrared_remote_find_button_by_name(remote, name, &index)) return NULL;
+    return *InfraredButtonArray_get(remote->buttons, index);
+}
+
+InfraredRemoteButton* infrared_remote_get_button_by_command(InfraredRemote* remote, int command) {
     for(size_t i = 0; i < InfraredButtonArray_size(remote->buttons); i++) {
         InfraredRemoteButton* button = *InfraredButtonArray_get(remote->buttons, i);
-        FuriString* furi_name = infrared_remote_button_get_furi_name(button);
-        if(button && !furi_string_cmpi_str(furi_name, name)) return button;
+        if(button && infrared_remote_button_get_command(button) == command) return button;
     }
     return NULL;
 }
 
 bool infrared_remote_add_button(InfraredRemote* remote, const char* name, InfraredSignal* signal) {
     InfraredRemoteButton* button = infrared_remote_button_alloc();
-    infrared_remote_button_set_name(button, name);
+    infrared_remote_button_set_interned_name(remote, button, name);
     infrared_remote_button_set_signal(button, signal);
     InfraredButtonArray_push_back(remote->buttons, button);
     return infrared_remote_store(remote);
@@ -121,15 +197,23 @@ bool infrared_remote_add_button(InfraredRemote* remote, const char* name, Infrar
 
 void infrared_remote_push_button(InfraredRemote* remote, const char* name, InfraredSignal* signal) {
     InfraredRemoteButton* button = infrared_remote_button_alloc();
-    infrared_remote_button_set_name(button, name);
+    infrared_remote_button_set_interned_name(remote, button, name);
     infrared_remote_button_set_signal(button, signal);
     InfraredButtonArray_push_back(remote->buttons, button);
 }
 
+bool infrared_remote_pop_button(InfraredRemote* remote) {
+    InfraredRemoteButton* button;
+    if(!InfraredButtonArray_size(remote->buttons)) return false;
+    InfraredButtonArray_pop_back(&button, remote->buttons);
+    infrared_remote_button_free(button);
+    return true;
+}
+
 bool infrared_remote_rename_button(InfraredRemote* remote, const char* new_name, size_t index) {
     furi_assert(index < InfraredButtonArray_size(remote->buttons));
     InfraredRemoteButton* button = *InfraredButtonArray_get(remote->buttons, index);
-    infrared_remote_button_set_name(button, new_name);
+    infrared_remote_button_set_interned_name(remote, button, new_name);
     return infrared_remote_store(remote);
 }
 
@@ -210,7 +294,8 @@ bool infrared_remote_load(InfraredRemote* remote, FuriString* path) {
             InfraredRemoteButton* button = infrared_remote_button_alloc();
             can_read = infrared_signal_read(infrared_remote_button_get_signal(button), ff, buf);
             if(can_read) {
-                infrared_remote_button_set_name(button, furi_string_get_cstr(buf));
+                const char* name = furi_string_get_cstr(buf);
+                infrared_remote_button_set_interned_name(remote, button, name);
                 InfraredButtonArray_push_back(remote->buttons, button);
             } else {
                 infrared_remote_button_free(button);
@@ -8,6 +8,10 @@
    - Added function infrared_remote_get_button_by_name()
    - Added function infrared_remote_delete_button_by_name()
    - Added function infrared_remote_push_button()
+   - Added function infrared_remote_get_button_by_command()
+   - Added function infrared_remote_get_footprint()
+   - Added function infrared_remote_pop_button()
+   - Button names are interned in the command table or remote name pool
 */
 
 #pragma once
@@ -32,9 +36,12 @@ size_t infrared_remote_get_button_count(InfraredRemote* remote);
 InfraredRemoteButton* infrared_remote_get_button(InfraredRemote* remote, size_t index);
 bool infrared_remote_find_button_by_name(InfraredRemote* remote, const char* name, size_t* index);
 InfraredRemoteButton* infrared_remote_get_button_by_name(InfraredRemote* remote, const char* name);
+InfraredRemoteButton* infrared_remote_get_button_by_command(InfraredRemote* remote, int command);
+size_t infrared_remote_get_footprint(InfraredRemote* remote);
 
 bool infrared_remote_add_button(InfraredRemote* remote, const char* name, InfraredSignal* signal);
 void infrared_remote_push_button(InfraredRemote* remote, const char* name, InfraredSignal* signal);
+bool infrared_remote_pop_button(InfraredRemote* remote);
 bool infrared_remote_rename_button(InfraredRemote* remote, const char* new_name, size_t index);
 bool infrared_remote_delete_button(InfraredRemote* remote, size_t index);
 bool infrared_remote_delete_button_by_name(InfraredRemote* remote, const char* name);
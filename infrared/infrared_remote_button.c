@@ -5,7 +5,9 @@
    The original project is licensed under the GNU GPLv3
 
    Modifications made:
-   - Added function infrared_remote_button_get_furi_name()
+   - Button names are interned and no longer owned by the button
+   - Added function infrared_remote_button_get_command()
+   - Added function infrared_remote_button_get_footprint()
 */
 
 #include "infrared_remote_button.h"
@@ -13,33 +15,39 @@
 #include <stdlib.h>
 
 struct InfraredRemoteButton {
-    FuriString* name;
+    const char* name;
     InfraredSignal* signal;
+    int command;
 };
 
 InfraredRemoteButton* infrared_remote_button_alloc() {
     InfraredRemoteButton* button = malloc(sizeof(InfraredRemoteButton));
-    button->name = furi_string_alloc();
     button->signal = infrared_signal_alloc();
+    button->command = -1;
+    button->name = "";
     return button;
 }
 
 void infrared_remote_button_free(InfraredRemoteButton* button) {
-    furi_string_free(button->name);
     infrared_signal_free(button->signal);
     free(button);
 }
 
-void infrared_remote_button_set_name(InfraredRemoteButton* button, const char* name) {
-    furi_string_set(button->name, name);
+void infrared_remote_button_set_name(InfraredRemoteButton* button, const char* name, int command) {
+    button->command = command;
+    button->name = name;
 }
 
 const char* infrared_remote_button_get_name(InfraredRemoteButton* button) {
-    return furi_string_get_cstr(button->name);
+    return button->name;
 }
 
-FuriString* infrared_remote_button_get_furi_name(InfraredRemoteButton* button) {
-    return button->name;
+int infrared_remote_button_get_command(InfraredRemoteButton* button) {
+    return button->command;
+}
+
+size_t infrared_remote_button_get_footprint(InfraredRemoteButton* button) {
+    return sizeof(InfraredRemoteButton) + infrared_signal_get_footprint(button->signal);
 }
 
 void infrared_remote_button_set_signal(InfraredRemoteButton* button, InfraredSignal* signal) {
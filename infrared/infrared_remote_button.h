@@ -5,7 +5,9 @@
    The original project is licensed under the GNU GPLv3
 
    Modifications made:
-   - Added function infrared_remote_button_get_furi_name()
+   - Button names are interned and no longer owned by the button
+   - Added function infrared_remote_button_get_command()
+   - Added function infrared_remote_button_get_footprint()
 */
 
 #pragma once
@@ -17,9 +19,11 @@ typedef struct InfraredRemoteButton InfraredRemoteButton;
 InfraredRemoteButton* infrared_remote_button_alloc();
 void infrared_remote_button_free(InfraredRemoteButton* button);
 
-void infrared_remote_button_set_name(InfraredRemoteButton* button, const char* name);
+/* Name must outlive the button (static command table or remote name pool) */
+void infrared_remote_button_set_name(InfraredRemoteButton* button, const char* name, int command);
 const char* infrared_remote_button_get_name(InfraredRemoteButton* button);
-FuriString* infrared_remote_button_get_furi_name(InfraredRemoteButton* button);
+int infrared_remote_button_get_command(InfraredRemoteButton* button);
+size_t infrared_remote_button_get_footprint(InfraredRemoteButton* button);
 
 void infrared_remote_button_set_signal(InfraredRemoteButton* button, InfraredSignal* signal);
 InfraredSignal* infrared_remote_button_get_signal(InfraredRemoteButton* button);
@@ -6,6 +6,15 @@
 
    Modifications made:
    - Added function infrared_signal_transmit_times()
+   - Added function infrared_signal_set_raw_signal_ref()
+   - Added function infrared_signal_get_footprint()
+   - Added function infrared_signal_compact_raw()
+   - Raw signals are repeated by infrared_signal_transmit_times() with inter-frame gaps
+   - Added function infrared_signal_transmit_frame()
+   - Added function infrared_signal_encode_message()
+   - Added function infrared_signal_get_gap()
+   - Added function infrared_signal_read_body_ref()
+   - Added function infrared_signal_get_repeat_period()
 */
 
 #include "infrared_signal.h"
@@ -15,11 +24,26 @@
 #include <core/check.h>
 #include <infrared_worker.h>
 #include <infrared_transmit.h>
+#include <furi_hal_infrared.h>
 
 #define TAG "InfraredSignal"
 
+#define INFRARED_RAW_REPEAT_GAP_MIN   10000
+#define INFRARED_RAW_REPEAT_GAP       40000
+#define INFRARED_RAW_TOLERANCE_MIN    100
+#define INFRARED_RAW_TOLERANCE_DIVIDE 4
+
+typedef struct {
+    const uint32_t* timings;
+    size_t frame_size;
+    size_t index;
+    uint32_t gap;
+    int frames;
+} InfraredSignalRawTx;
+
 struct InfraredSignal {
     bool is_raw;
+    bool is_ref;
     union {
         InfraredMessage message;
         InfraredRawSignal raw;
@@ -28,7 +52,9 @@ struct InfraredSignal {
 
 static void infrared_signal_clear_timings(InfraredSignal* signal) {
     if(signal->is_raw) {
-        free(signal->payload.raw.timings);
+        /* Referenced timings are owned by the caller */
+        if(!signal->is_ref) free(signal->payload.raw.timings);
+        signal->is_ref = false;
         signal->payload.raw.timings_size = 0;
         signal->payload.raw.timings = NULL;
     }
@@ -180,6 +206,7 @@ InfraredSignal* infrared_signal_alloc() {
     InfraredSignal* signal = malloc(sizeof(InfraredSignal));
 
     signal->is_raw = false;
+    signal->is_ref = false;
     signal->payload.message.protocol = InfraredProtocolUnknown;
 
     return signal;
@@ -190,6 +217,13 @@ void infrared_signal_free(InfraredSignal* signal) {
     free(signal);
 }
 
+size_t infrared_signal_get_footprint(InfraredSignal* signal) {
+    size_t size = sizeof(InfraredSignal);
+    if(signal->is_raw && !signal->is_ref)
+        size += signal->payload.raw.timings_size * sizeof(uint32_t);
+    return size;
+}
+
 bool infrared_signal_is_raw(InfraredSignal* signal) {
     return signal->is_raw;
 }
@@ -210,9 +244,8 @@ void infrared_signal_set_signal(InfraredSignal* signal, const InfraredSignal* ot
     }
 }
 
-void infrared_signal_set_raw_signal(
+static bool infrared_signal_set_raw_params(
     InfraredSignal* signal,
-    const uint32_t* timings,
     size_t timings_size,
     uint32_t frequency,
     float duty_cycle) {
@@ -230,7 +263,7 @@ void infrared_signal_set_raw_signal(
     }
     // In case of timings out of bounds we just call return
     if((timings_size <= 0) || (timings_size > MAX_TIMINGS_AMOUNT)) {
-        return;
+        return false;
     }
 
     signal->is_raw = true;
@@ -239,10 +272,31 @@ void infrared_signal_set_raw_signal(
     signal->payload.raw.frequency = frequency;
     signal->payload.raw.duty_cycle = duty_cycle;
 
+    return true;
+}
+
+void infrared_signal_set_raw_signal(
+    InfraredSignal* signal,
+    const uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle) {
+    if(!infrared_signal_set_raw_params(signal, timings_size, frequency, duty_cycle)) return;
     signal->payload.raw.timings = malloc(timings_size * sizeof(uint32_t));
     memcpy(signal->payload.raw.timings, timings, timings_size * sizeof(uint32_t));
 }
 
+void infrared_signal_set_raw_signal_ref(
+    InfraredSignal* signal,
+    uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle) {
+    if(!infrared_signal_set_raw_params(signal, timings_size, frequency, duty_cycle)) return;
+    signal->payload.raw.timings = timings;
+    signal->is_ref = true;
+}
+
 InfraredRawSignal* infrared_signal_get_raw_signal(InfraredSignal* signal) {
     furi_assert(signal->is_raw);
     return &signal->payload.raw;
@@ -309,6 +363,40 @@ bool infrared_signal_search_and_read(
     return success;
 }
 
+bool infrared_signal_read_body_ref(
+    InfraredSignal* signal,
+    FlipperFormat* ff,
+    uint32_t* timings,
+    size_t max_size) {
+    FuriString* tmp = furi_string_alloc();
+    uint32_t timings_size, frequency;
+    float duty_cycle;
+    bool success = false;
+
+    do {
+        if(!flipper_format_read_string(ff, "type", tmp)) break;
+        if(furi_string_equal(tmp, "parsed")) {
+            success = infrared_signal_read_message(signal, ff);
+            break;
+        }
+
+        if(!furi_string_equal(tmp, "raw")) break;
+        if(!flipper_format_read_uint32(ff, "frequency", &frequency, 1)) break;
+        if(!flipper_format_read_float(ff, "duty_cycle", &duty_cycle, 1)) break;
+        if(!flipper_format_get_value_count(ff, "data", &timings_size)) break;
+
+        /* No allocation here, records larger than the buffer are rejected */
+        if(timings_size == 0 || timings_size > MIN(max_size, MAX_TIMINGS_AMOUNT)) break;
+        if(!flipper_format_read_uint32(ff, "data", timings, timings_size)) break;
+
+        infrared_signal_set_raw_signal_ref(signal, timings, timings_size, frequency, duty_cycle);
+        success = true;
+    } while(false);
+
+    furi_string_free(tmp);
+    return success;
+}
+
 void infrared_signal_transmit(InfraredSignal* signal) {
     if(signal->is_raw) {
         InfraredRawSignal* raw_signal = &signal->payload.raw;
@@ -324,15 +412,130 @@ void infrared_signal_transmit(InfraredSignal* signal) {
     }
 }
 
+static bool infrared_signal_raw_timing_match(uint32_t a, uint32_t b) {
+    uint32_t diff = a > b ? a - b : b - a;
+    uint32_t tolerance = (a > b ? a : b) / INFRARED_RAW_TOLERANCE_DIVIDE;
+    if(tolerance < INFRARED_RAW_TOLERANCE_MIN) tolerance = INFRARED_RAW_TOLERANCE_MIN;
+    return diff <= tolerance;
+}
+
+static size_t infrared_signal_raw_find_frame(InfraredRawSignal* raw) {
+    size_t frame_size = 0;
+    size_t i;
+
+    /* Frames start with a mark, so gaps can only be found at odd indexes */
+    for(i = 1; i < raw->timings_size; i += 2) {
+        if(raw->timings[i] >= INFRARED_RAW_REPEAT_GAP_MIN) {
+            frame_size = i;
+            break;
+        }
+    }
+
+    if(!frame_size) return 0;
+    size_t period = frame_size + 1;
+    bool complete = false;
+    size_t frames = 1;
+
+    /* Every following frame must match the first one and be separated by a gap */
+    for(size_t pos = period; pos + frame_size <= raw->timings_size; pos += period) {
+        for(i = 0; i < frame_size; i++)
+            if(!infrared_signal_raw_timing_match(raw->timings[pos + i], raw->timings[i])) break;
+
+        if(i < frame_size) break;
+        frames++;
+
+        if(pos + frame_size == raw->timings_size) {
+            complete = true;
+            break;
+        }
+
+        if(raw->timings[pos + frame_size] < INFRARED_RAW_REPEAT_GAP_MIN) break;
+    }
+
+    /* Whole capture must be consumed, otherwise it is not a plain repetition */
+    return (complete && frames > 1) ? frame_size : 0;
+}
+
+bool infrared_signal_compact_raw(InfraredSignal* signal) {
+    if(!signal->is_raw) return false;
+
+    InfraredRawSignal* raw = &signal->payload.raw;
+    size_t frame_size = infrared_signal_raw_find_frame(raw);
+    if(!frame_size) return false;
+
+    FURI_LOG_D(TAG, "raw repeat: frame %u of %u timings", frame_size, raw->timings_size);
+
+    /* Keep the gap after the first frame as a trailing space */
+    raw->timings_size = frame_size + 1;
+    if(!signal->is_ref)
+        raw->timings = realloc(raw->timings, raw->timings_size * sizeof(uint32_t));
+
+    return true;
+}
+
+static FuriHalInfraredTxGetDataState
+    infrared_signal_raw_tx_callback(void* context, uint32_t* duration, bool* level) {
+    InfraredSignalRawTx* tx = context;
+
+    if(tx->index < tx->frame_size) {
+        /* Frames always start with a mark */
+        *level = !(tx->index % 2);
+        *duration = tx->timings[tx->index++];
+
+        bool last = tx->index == tx->frame_size && tx->frames == 1;
+        return last ? FuriHalInfraredTxGetDataStateLastDone : FuriHalInfraredTxGetDataStateOk;
+    }
+
+    /* Space between the copies, then start the next one */
+    *level = false;
+    *duration = tx->gap;
+    tx->frames--;
+    tx->index = 0;
+
+    return FuriHalInfraredTxGetDataStateOk;
+}
+
+static size_t infrared_signal_raw_get_frame(const InfraredRawSignal* raw, uint32_t* gap) {
+    size_t frame_size = raw->timings_size;
+    *gap = INFRARED_RAW_REPEAT_GAP;
+
+    /* Trailing space is never sent, only a long one is the gap detected by compacting */
+    if(frame_size > 1 && frame_size % 2 == 0) {
+        uint32_t space = raw->timings[--frame_size];
+        if(space >= INFRARED_RAW_REPEAT_GAP_MIN) *gap = space;
+    }
+
+    return frame_size;
+}
+
+static void infrared_signal_transmit_raw_times(InfraredRawSignal* raw_signal, int times) {
+    InfraredSignalRawTx tx = {
+        .timings = raw_signal->timings,
+        .frames = times,
+        .index = 0,
+    };
+
+    tx.frame_size = infrared_signal_raw_get_frame(raw_signal, &tx.gap);
+    furi_check(!furi_hal_infrared_is_busy());
+
+    /* All copies are streamed in one transmission, so gaps have no scheduling jitter */
+    furi_hal_infrared_async_tx_set_data_isr_callback(infrared_signal_raw_tx_callback, &tx);
+    furi_hal_infrared_async_tx_start(raw_signal->frequency, raw_signal->duty_cycle);
+    furi_hal_infrared_async_tx_wait_termination();
+}
+
+uint32_t infrared_signal_get_gap(InfraredSignal* signal) {
+    if(!signal->is_raw) return 0;
+    uint32_t gap;
+
+    infrared_signal_raw_get_frame(&signal->payload.raw, &gap);
+    return gap;
+}
+
 void infrared_signal_transmit_times(InfraredSignal* signal, int times) {
     if(signal->is_raw) {
         InfraredRawSignal* raw_signal = &signal->payload.raw;
-        infrared_send_raw_ext(
-            raw_signal->timings,
-            raw_signal->timings_size,
-            true,
-            raw_signal->frequency,
-            raw_signal->duty_cycle);
+        infrared_signal_transmit_raw_times(raw_signal, times < 1 ? 1 : times);
     } else {
         InfraredMessage* message = &signal->payload.message;
         if(times < 1) {
@@ -342,3 +545,101 @@ void infrared_signal_transmit_times(InfraredSignal* signal, int times) {
         }
     }
 }
+
+void infrared_signal_transmit_frame(InfraredSignal* signal, bool repeat) {
+    if(signal->is_raw) {
+        InfraredRawSignal* raw_signal = &signal->payload.raw;
+        uint32_t gap;
+
+        /* Inter-frame gap is left to the caller */
+        size_t timings_size = infrared_signal_raw_get_frame(raw_signal, &gap);
+
+        infrared_send_raw_ext(
+            raw_signal->timings,
+            timings_size,
+            true,
+            raw_signal->frequency,
+            raw_signal->duty_cycle);
+    } else {
+        InfraredMessage message = signal->payload.message;
+        message.repeat = repeat;
+        infrared_send(&message, 1);
+    }
+}
+
+uint32_t infrared_signal_get_repeat_period(const InfraredMessage* message) {
+    InfraredEncoderHandler* handler = infrared_alloc_encoder();
+    infrared_reset_encoder(handler, message);
+
+    uint32_t duration = 0, period = 0;
+    bool level = false;
+    size_t frames = 0;
+
+    /* First repeat follows a longer frame, the next one shows the steady spacing */
+    for(size_t i = 0; frames < 3 && i < MAX_TIMINGS_AMOUNT; i++) {
+        InfraredStatus status = infrared_encode(handler, &duration, &level);
+        if(status == InfraredStatusError) break;
+        if(frames == 2) period += duration;
+        if(status == InfraredStatusDone) frames++;
+    }
+
+    infrared_free_encoder(handler);
+    return frames == 3 ? period : 0;
+}
+
+size_t infrared_signal_encode_message(
+    const InfraredMessage* message,
+    int times,
+    uint32_t* timings,
+    size_t max_size) {
+    /* Same amount of transmissions as infrared_send() would do */
+    int min_times = infrared_get_protocol_min_repeat_count(message->protocol);
+    if(times < min_times) times = min_times;
+
+    InfraredEncoderHandler* handler = infrared_alloc_encoder();
+    infrared_reset_encoder(handler, message);
+
+    uint32_t duration = 0, merged = 0;
+    bool level = false, merged_level = true;
+    size_t count = 0;
+
+    while(times > 0) {
+        InfraredStatus status = infrared_encode(handler, &duration, &level);
+        if(status == InfraredStatusError) {
+            count = 0;
+            break;
+        } else if(status == InfraredStatusDone) {
+            times--;
+        }
+
+        /* Raw timings start with a mark and alternate levels */
+        if(!count && !merged && !level) continue;
+
+        if(level == merged_level) {
+            merged += duration;
+            continue;
+        }
+
+        if(count >= max_size) {
+            count = 0;
+            break;
+        }
+
+        if(timings != NULL) timings[count] = merged;
+        merged_level = level;
+        merged = duration;
+        count++;
+    }
+
+    /* Flush the last merged timing or give up if it does not fit */
+    if(count >= max_size) {
+        count = 0;
+    } else if(count) {
+        if(timings != NULL) timings[count] = merged;
+        count++;
+    }
+
+    infrared_free_encoder(handler);
+    return count;
+}
+
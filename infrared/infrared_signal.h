@@ -6,6 +6,15 @@
 
    Modifications made:
    - Added function infrared_signal_transmit_times()
+   - Added function infrared_signal_set_raw_signal_ref()
+   - Added function infrared_signal_get_footprint()
+   - Added function infrared_signal_compact_raw()
+   - Raw signals are repeated by infrared_signal_transmit_times() with inter-frame gaps
+   - Added function infrared_signal_transmit_frame()
+   - Added function infrared_signal_encode_message()
+   - Added function infrared_signal_get_gap()
+   - Added function infrared_signal_read_body_ref()
+   - Added function infrared_signal_get_repeat_period()
 */
 
 #pragma once
@@ -40,6 +49,13 @@ void infrared_signal_set_raw_signal(
     size_t timings_size,
     uint32_t frequency,
     float duty_cycle);
+/* Timings are referenced, not copied, and must outlive the signal or its next update */
+void infrared_signal_set_raw_signal_ref(
+    InfraredSignal* signal,
+    uint32_t* timings,
+    size_t timings_size,
+    uint32_t frequency,
+    float duty_cycle);
 InfraredRawSignal* infrared_signal_get_raw_signal(InfraredSignal* signal);
 
 void infrared_signal_set_message(InfraredSignal* signal, const InfraredMessage* message);
@@ -51,6 +67,27 @@ bool infrared_signal_search_and_read(
     InfraredSignal* signal,
     FlipperFormat* ff,
     const FuriString* name);
+/* Reads the body after the name key, raw timings go to the caller's buffer and are referenced */
+bool infrared_signal_read_body_ref(
+    InfraredSignal* signal,
+    FlipperFormat* ff,
+    uint32_t* timings,
+    size_t max_size);
 
 void infrared_signal_transmit(InfraredSignal* signal);
-void infrared_signal_transmit_times(InfraredSignal* signal, int times);
\ No newline at end of file
+/* Keeps one frame of a periodic raw capture followed by the inter-frame gap */
+bool infrared_signal_compact_raw(InfraredSignal* signal);
+void infrared_signal_transmit_times(InfraredSignal* signal, int times);
+void infrared_signal_transmit_frame(InfraredSignal* signal, bool repeat);
+/* Silence in microseconds to keep after the signal, encoders already include it */
+uint32_t infrared_signal_get_gap(InfraredSignal* signal);
+
+/* Microseconds between the starts of two frames as infrared_send() repeats them, 0 on error */
+uint32_t infrared_signal_get_repeat_period(const InfraredMessage* message);
+/* Encodes message with repeats to mark/space timings, only counts them if timings is NULL */
+size_t infrared_signal_encode_message(
+    const InfraredMessage* message,
+    int times,
+    uint32_t* timings,
+    size_t max_size);
+size_t infrared_signal_get_footprint(InfraredSignal* signal);
\ No newline at end of file
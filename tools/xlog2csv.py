@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+# This source is part of "flipper-xremote" project
+# 2023 - Sandro Kalatozishvili (s.kalatoz@gmail.com)
+#
+# Converts the binary capture log written by the analyzer to CSV.
+# Usage: ./xlog2csv.py XRemote_Captures.xlog [output.csv]
+
+import csv
+import struct
+import sys
+
+LOG_MAGIC = b"XRLG"
+LOG_VERSION = 1
+
+RECORD_SESSION = 1
+RECORD_MESSAGE = 2
+RECORD_RAW = 3
+RECORD_DROPPED = 4
+
+FLAG_TRUNCATED = 1 << 0
+
+COLUMNS = [
+    "session", "time_ms", "type", "protocol", "address", "command",
+    "repeat", "frequency", "truncated", "value", "timings"
+]
+
+
+def read_varints(data):
+    values = []
+    value = 0
+    shift = 0
+
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+
+        if not byte & 0x80:
+            values.append(value)
+            value = 0
+            shift = 0
+
+    return values
+
+
+def parse_records(data):
+    if data[:4] != LOG_MAGIC:
+        raise ValueError("not an XRemote capture log")
+    if data[4] != LOG_VERSION:
+        raise ValueError("unsupported log version: %d" % data[4])
+
+    offset = 8
+    session = 0
+
+    while offset + 8 <= len(data):
+        rtype, flags, length, time_ms = struct.unpack_from("<BBHI", data, offset)
+        payload = data[offset + 8:offset + 8 + length]
+        offset += 8 + length
+
+        if len(payload) != length:
+            print("warning: incomplete record at the end of the log", file=sys.stderr)
+            break
+
+        row = dict.fromkeys(COLUMNS, "")
+        row["time_ms"] = time_ms
+
+        if rtype == RECORD_SESSION:
+            session += 1
+            row["type"] = "session"
+            row["value"] = struct.unpack_from("<I", payload)[0]
+        elif rtype == RECORD_MESSAGE:
+            address, command, repeat, name_len = struct.unpack_from("<IIBB", payload)
+            row["type"] = "message"
+            row["protocol"] = payload[10:10 + name_len].decode("ascii", "replace")
+            row["address"] = "0x%X" % address
+            row["command"] = "0x%X" % command
+            row["repeat"] = repeat
+        elif rtype == RECORD_RAW:
+            row["type"] = "raw"
+            row["frequency"] = struct.unpack_from("<I", payload)[0]
+            row["truncated"] = 1 if flags & FLAG_TRUNCATED else 0
+            row["timings"] = " ".join(str(t) for t in read_varints(payload[4:]))
+        elif rtype == RECORD_DROPPED:
+            row["type"] = "dropped"
+            row["value"] = struct.unpack_from("<I", payload)[0]
+        else:
+            row["type"] = "unknown_%d" % rtype
+
+        row["session"] = session
+        yield row
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: %s <log.xlog> [output.csv]" % sys.argv[0], file=sys.stderr)
+        return 1
+
+    with open(sys.argv[1], "rb") as log_file:
+        data = log_file.read()
+
+    output = open(sys.argv[2], "w", newline="") if len(sys.argv) > 2 else sys.stdout
+    writer = csv.DictWriter(output, fieldnames=COLUMNS)
+    writer.writeheader()
+
+    for row in parse_records(data):
+        writer.writerow(row)
+
+    if output is not sys.stdout:
+        output.close()
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
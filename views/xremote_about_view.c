@@ -10,27 +10,26 @@
 #include "../xremote.h"
 
 static void xremote_about_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
-    UNUSED(model);
     char version[32];
 
     canvas_set_font(canvas, FontSecondary);
     xremote_get_version(version, sizeof(version));
 
-    canvas_draw_str_aligned(canvas, 0, 30, AlignLeft, AlignTop, "Version:");
-    canvas_draw_str_aligned(canvas, 35, 30, AlignLeft, AlignTop, version);
+    canvas_draw_str_aligned(canvas, 0, 24, AlignLeft, AlignTop, "Version:");
+    canvas_draw_str_aligned(canvas, 35, 24, AlignLeft, AlignTop, version);
 
-    canvas_draw_str_aligned(canvas, 0, 40, AlignLeft, AlignTop, "License: GPLv3");
-    canvas_draw_str_aligned(canvas, 0, 50, AlignLeft, AlignTop, "Author: kala13x");
+    canvas_draw_str_aligned(canvas, 0, 33, AlignLeft, AlignTop, "License: GPLv3");
+    canvas_draw_str_aligned(canvas, 0, 42, AlignLeft, AlignTop, "Author: kala13x");
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 53, "Diag", XRemoteIconEnter);
 
-    elements_slightly_rounded_frame(canvas, 9, 78, 45, 33);
-    canvas_draw_str_aligned(canvas, 0, 69, AlignLeft, AlignTop, "Contact:");
-    canvas_draw_str_aligned(canvas, 13, 80, AlignLeft, AlignTop, "s.kalatoz");
-    canvas_draw_str_aligned(canvas, 28, 91, AlignLeft, AlignTop, "@");
-    canvas_draw_str_aligned(canvas, 11, 100, AlignLeft, AlignTop, "gmail.com");
+    elements_slightly_rounded_frame(canvas, 9, 80, 45, 33);
+    canvas_draw_str_aligned(canvas, 0, 71, AlignLeft, AlignTop, "Contact:");
+    canvas_draw_str_aligned(canvas, 13, 82, AlignLeft, AlignTop, "s.kalatoz");
+    canvas_draw_str_aligned(canvas, 28, 93, AlignLeft, AlignTop, "@");
+    canvas_draw_str_aligned(canvas, 11, 102, AlignLeft, AlignTop, "gmail.com");
 }
 
 static void xremote_about_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
-    UNUSED(model);
     char version[32];
 
     canvas_set_font(canvas, FontSecondary);
@@ -47,6 +46,7 @@ static void xremote_about_view_draw_horizontal(Canvas* canvas, XRemoteViewModel*
     canvas_draw_str_aligned(canvas, 12, 32, AlignLeft, AlignTop, "s.kalatoz");
     canvas_draw_str_aligned(canvas, 27, 43, AlignLeft, AlignTop, "@");
     canvas_draw_str_aligned(canvas, 10, 52, AlignLeft, AlignTop, "gmail.com");
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 64, 30, "Diag", XRemoteIconEnter);
 }
 
 static void xremote_about_view_draw_callback(Canvas* canvas, void* context) {
@@ -65,8 +65,32 @@ static void xremote_about_view_draw_callback(Canvas* canvas, void* context) {
     xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
 }
 
+static bool xremote_about_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+    if(event->key != InputKeyOk) return false;
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            if(event->type == InputTypePress)
+                model->ok_pressed = true;
+            else if(event->type == InputTypeRelease)
+                model->ok_pressed = false;
+        },
+        true);
+
+    if(event->type == InputTypeShort)
+        view_dispatcher_switch_to_view(app_ctx->view_dispatcher, XRemoteViewDiagnostics);
+
+    return true;
+}
+
 XRemoteView* xremote_about_view_alloc(void* app_ctx) {
-    XRemoteView* view = xremote_view_alloc(app_ctx, NULL, xremote_about_view_draw_callback);
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_about_view_input_callback, xremote_about_view_draw_callback);
 
     with_view_model(
         xremote_view_get_view(view), XRemoteViewModel * model, { model->context = app_ctx; }, true);
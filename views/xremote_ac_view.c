@@ -0,0 +1,147 @@
+/*!
+ *  @file flipper-xremote/views/xremote_ac_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Air conditioner page view components and functionality.
+ */
+
+#include "xremote_ac_view.h"
+#include "../xremote_ac.h"
+
+static void xremote_ac_view_draw_temp(Canvas* canvas, XRemoteAC* ac, uint8_t x, uint8_t y) {
+    char text[16];
+    snprintf(text, sizeof(text), "%lu", xremote_ac_get_temp(ac));
+
+    /* Big numbers font has only digits, unit is drawn with the regular one */
+    canvas_set_font(canvas, FontBigNumbers);
+    canvas_draw_str_aligned(canvas, x, y, AlignRight, AlignCenter, text);
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, x + 2, y - 7, AlignLeft, AlignTop, "C");
+}
+
+static void xremote_ac_view_draw_state(Canvas* canvas, XRemoteAC* ac, uint8_t x, uint8_t y) {
+    char text[32];
+
+    snprintf(text, sizeof(text), "Mode: %s", xremote_ac_get_mode_str(ac));
+    canvas_draw_str_aligned(canvas, x, y, AlignLeft, AlignTop, text);
+
+    snprintf(text, sizeof(text), "Fan: %s", xremote_ac_get_fan_str(ac));
+    canvas_draw_str_aligned(canvas, x, y + 10, AlignLeft, AlignTop, text);
+}
+
+static void xremote_ac_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteAC* ac = model->context;
+    const char* power = xremote_ac_is_power_on(ac) ? "Off" : "On";
+
+    xremote_ac_view_draw_temp(canvas, ac, 36, 30);
+    xremote_ac_view_draw_state(canvas, ac, 0, 40);
+
+    xremote_canvas_draw_button(canvas, model->up_pressed, 23, 62, XRemoteIconArrowUp);
+    xremote_canvas_draw_button(canvas, model->left_pressed, 0, 80, XRemoteIconArrowLeft);
+    xremote_canvas_draw_button(canvas, model->down_pressed, 23, 80, XRemoteIconArrowDown);
+    xremote_canvas_draw_button(canvas, model->right_pressed, 46, 80, XRemoteIconArrowRight);
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 100, power, XRemoteIconEnter);
+}
+
+static void xremote_ac_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteAC* ac = model->context;
+    const char* power = xremote_ac_is_power_on(ac) ? "Off" : "On";
+
+    canvas_draw_str_aligned(canvas, 0, 0, AlignLeft, AlignTop, xremote_ac_get_name(ac));
+    xremote_ac_view_draw_temp(canvas, ac, 36, 20);
+    xremote_ac_view_draw_state(canvas, ac, 0, 32);
+
+    xremote_canvas_draw_button(canvas, model->up_pressed, 90, 20, XRemoteIconArrowUp);
+    xremote_canvas_draw_button(canvas, model->left_pressed, 70, 38, XRemoteIconArrowLeft);
+    xremote_canvas_draw_button(canvas, model->down_pressed, 90, 38, XRemoteIconArrowDown);
+    xremote_canvas_draw_button(canvas, model->right_pressed, 110, 38, XRemoteIconArrowRight);
+
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, power);
+}
+
+static void xremote_ac_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteAC* ac = model->context;
+    XRemoteAppContext* app_ctx = xremote_ac_get_app_context(ac);
+    XRemoteViewDrawFunction xremote_ac_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_ac_view_draw_body = orientation == ViewOrientationVertical ?
+                                    xremote_ac_view_draw_vertical :
+                                    xremote_ac_view_draw_horizontal;
+
+    xremote_canvas_draw_header(canvas, orientation, "AC");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_ac_view_draw_body(canvas, model);
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
+}
+
+static void xremote_ac_view_process(XRemoteView* view, InputEvent* event) {
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            XRemoteAC* ac = xremote_view_get_context(view);
+            model->context = ac;
+
+            /* Every change sends the whole state, the same as the original remote */
+            if(event->type == InputTypePress) {
+                if(event->key == InputKeyUp) {
+                    model->up_pressed = xremote_ac_change_temp(ac, 1);
+                } else if(event->key == InputKeyDown) {
+                    model->down_pressed = xremote_ac_change_temp(ac, -1);
+                } else if(event->key == InputKeyLeft) {
+                    model->left_pressed = xremote_ac_next_mode(ac);
+                } else if(event->key == InputKeyRight) {
+                    model->right_pressed = xremote_ac_next_fan(ac);
+                } else if(event->key == InputKeyOk) {
+                    model->ok_pressed = xremote_ac_toggle_power(ac);
+                }
+            } else if(event->type == InputTypeRelease) {
+                if(event->key == InputKeyUp)
+                    model->up_pressed = false;
+                else if(event->key == InputKeyDown)
+                    model->down_pressed = false;
+                else if(event->key == InputKeyLeft)
+                    model->left_pressed = false;
+                else if(event->key == InputKeyRight)
+                    model->right_pressed = false;
+                else if(event->key == InputKeyOk)
+                    model->ok_pressed = false;
+            }
+        },
+        true);
+}
+
+static bool xremote_ac_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    if(event->key == InputKeyBack) return false;
+
+    xremote_ac_view_process(view, event);
+    return true;
+}
+
+XRemoteView* xremote_ac_view_alloc(void* app_ctx, void* ac) {
+    XRemoteView* view =
+        xremote_view_alloc(app_ctx, xremote_ac_view_input_callback, xremote_ac_view_draw_callback);
+    xremote_view_set_context(view, ac, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = ac;
+            model->up_pressed = false;
+            model->down_pressed = false;
+            model->left_pressed = false;
+            model->right_pressed = false;
+            model->ok_pressed = false;
+        },
+        true);
+
+    return view;
+}
@@ -0,0 +1,126 @@
+/*!
+ *  @file flipper-xremote/views/xremote_broadcast_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Broadcast page view components and functionality.
+ */
+
+#include "xremote_broadcast_view.h"
+#include "../xremote_broadcast.h"
+
+static void
+    xremote_broadcast_view_draw_info(Canvas* canvas, XRemoteBroadcast* broadcast, uint8_t y) {
+    size_t resolved = xremote_broadcast_get_resolved_count(broadcast);
+    size_t devices = xremote_broadcast_get_device_count(broadcast);
+    char text[32];
+
+    const char* name = xremote_broadcast_get_name(broadcast);
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, name);
+
+    snprintf(text, sizeof(text), "Devices: %u/%u", resolved, devices);
+    canvas_draw_str_aligned(canvas, 0, y + 10, AlignLeft, AlignTop, text);
+}
+
+static void xremote_broadcast_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteBroadcast* broadcast = model->context;
+    const char* command = xremote_broadcast_get_command_name(broadcast);
+
+    xremote_broadcast_view_draw_info(canvas, broadcast, 24);
+    xremote_canvas_draw_button(canvas, model->left_pressed, 0, 50, XRemoteIconArrowLeft);
+    xremote_canvas_draw_button(canvas, model->right_pressed, 46, 50, XRemoteIconArrowRight);
+    canvas_draw_str_aligned(canvas, 32, 59, AlignCenter, AlignCenter, command);
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 76, "Send", XRemoteIconEnter);
+}
+
+static void xremote_broadcast_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteBroadcast* broadcast = model->context;
+    const char* command = xremote_broadcast_get_command_name(broadcast);
+
+    xremote_broadcast_view_draw_info(canvas, broadcast, 0);
+    xremote_canvas_draw_button(canvas, model->left_pressed, 0, 24, XRemoteIconArrowLeft);
+    xremote_canvas_draw_button(canvas, model->right_pressed, 46, 24, XRemoteIconArrowRight);
+    canvas_draw_str_aligned(canvas, 32, 33, AlignCenter, AlignCenter, command);
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 64, 26, "Send", XRemoteIconEnter);
+}
+
+static void xremote_broadcast_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteBroadcast* broadcast = model->context;
+    XRemoteAppContext* app_ctx = xremote_broadcast_get_app_context(broadcast);
+    XRemoteViewDrawFunction xremote_broadcast_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_broadcast_view_draw_body = orientation == ViewOrientationVertical ?
+                                           xremote_broadcast_view_draw_vertical :
+                                           xremote_broadcast_view_draw_horizontal;
+
+    xremote_canvas_draw_header(canvas, orientation, "Broadcast");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_broadcast_view_draw_body(canvas, model);
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
+}
+
+static void xremote_broadcast_view_process(XRemoteView* view, InputEvent* event) {
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            XRemoteBroadcast* broadcast = xremote_view_get_context(view);
+            model->context = broadcast;
+
+            if(event->type == InputTypePress) {
+                if(event->key == InputKeyOk) {
+                    if(xremote_broadcast_send(broadcast)) model->ok_pressed = true;
+                } else if(event->key == InputKeyLeft) {
+                    xremote_broadcast_next_command(broadcast, false);
+                    model->left_pressed = true;
+                } else if(event->key == InputKeyRight) {
+                    xremote_broadcast_next_command(broadcast, true);
+                    model->right_pressed = true;
+                }
+            } else if(event->type == InputTypeRepeat) {
+                if(event->key == InputKeyLeft)
+                    xremote_broadcast_next_command(broadcast, false);
+                else if(event->key == InputKeyRight)
+                    xremote_broadcast_next_command(broadcast, true);
+            } else if(event->type == InputTypeRelease) {
+                if(event->key == InputKeyOk)
+                    model->ok_pressed = false;
+                else if(event->key == InputKeyLeft)
+                    model->left_pressed = false;
+                else if(event->key == InputKeyRight)
+                    model->right_pressed = false;
+            }
+        },
+        true);
+}
+
+static bool xremote_broadcast_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    if(event->key == InputKeyBack) return false;
+
+    xremote_broadcast_view_process(view, event);
+    return true;
+}
+
+XRemoteView* xremote_broadcast_view_alloc(void* app_ctx, void* broadcast) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_broadcast_view_input_callback, xremote_broadcast_view_draw_callback);
+    xremote_view_set_context(view, broadcast, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = broadcast;
+            model->ok_pressed = false;
+            model->left_pressed = false;
+            model->right_pressed = false;
+        },
+        true);
+
+    return view;
+}
@@ -0,0 +1,13 @@
+/*!
+ *  @file flipper-xremote/views/xremote_broadcast_view.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Broadcast page view components and functionality.
+ */
+
+#pragma once
+
+#include "xremote_common_view.h"
+
+XRemoteView* xremote_broadcast_view_alloc(void* app_ctx, void* broadcast);
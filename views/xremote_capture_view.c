@@ -0,0 +1,168 @@
+/*!
+ *  @file flipper-xremote/views/xremote_capture_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Continuous capture list view components and functionality.
+ */
+
+#include "xremote_capture_view.h"
+#include "../xremote_analyzer.h"
+
+#define XREMOTE_CAPTURE_ROWS_HORIZONTAL 4
+#define XREMOTE_CAPTURE_ROWS_VERTICAL   9
+
+static void
+    xremote_capture_view_format_entry(char* text, size_t length, XRemoteCaptureEntry* entry) {
+    uint32_t seconds = entry->tick / 1000;
+    uint32_t tenths = (entry->tick % 1000) / 100;
+
+    if(entry->is_raw) {
+        snprintf(text, length, "%lu.%lu RAW %u", seconds, tenths, entry->timings_size);
+        return;
+    }
+
+    const InfraredMessage* message = &entry->message;
+    snprintf(
+        text,
+        length,
+        "%lu.%lu %s %lX:%lX",
+        seconds,
+        tenths,
+        infrared_get_protocol_name(message->protocol),
+        message->address,
+        message->command);
+}
+
+static void xremote_capture_view_draw_list(
+    Canvas* canvas,
+    XRemoteSignalAnalyzer* analyzer,
+    uint8_t y,
+    size_t rows) {
+    XRemoteCaptureRing* ring = xremote_signal_analyzer_get_capture_ring(analyzer);
+    XRemoteCaptureEntry entry;
+    char text[32];
+
+    /* Receiver keeps pushing from the worker thread while the list is drawn */
+    xremote_capture_ring_lock(ring);
+    size_t count = xremote_capture_ring_get_count(ring);
+    size_t selected = xremote_signal_analyzer_get_selected(analyzer);
+    size_t top = selected >= rows ? selected - rows + 1 : 0;
+    size_t marked = 0;
+
+    /* Marked reference for the comparison is shown unless the row is selected */
+    if(!xremote_signal_analyzer_get_marked(analyzer, &marked)) marked = count;
+
+    for(size_t i = top; i < count && i < top + rows; i++, y += 9) {
+        if(!xremote_capture_ring_get(ring, i, &entry)) break;
+        xremote_capture_view_format_entry(text, sizeof(text), &entry);
+        if(i == selected)
+            canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, ">");
+        else if(i == marked)
+            canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, "*");
+        canvas_draw_str_aligned(canvas, 6, y, AlignLeft, AlignTop, text);
+    }
+
+    xremote_capture_ring_unlock(ring);
+}
+
+static void
+    xremote_capture_view_draw_total(Canvas* canvas, XRemoteSignalAnalyzer* analyzer, uint8_t y) {
+    XRemoteCaptureRing* ring = xremote_signal_analyzer_get_capture_ring(analyzer);
+    char text[32];
+
+    snprintf(text, sizeof(text), "Seen: %lu", xremote_capture_ring_get_total(ring));
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+}
+
+static void xremote_capture_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteSignalAnalyzer* analyzer = model->context;
+
+    xremote_capture_view_draw_total(canvas, analyzer, 22);
+    xremote_capture_view_draw_list(canvas, analyzer, 31, XREMOTE_CAPTURE_ROWS_VERTICAL);
+
+    xremote_canvas_draw_icon(canvas, 6, 117, XRemoteIconEnter);
+    canvas_draw_str_aligned(canvas, 12, 113, AlignLeft, AlignTop, "Inspect");
+}
+
+static void xremote_capture_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteSignalAnalyzer* analyzer = model->context;
+
+    xremote_capture_view_draw_total(canvas, analyzer, 0);
+    xremote_capture_view_draw_list(canvas, analyzer, 20, XREMOTE_CAPTURE_ROWS_HORIZONTAL);
+
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Inspect");
+}
+
+static void xremote_capture_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteSignalAnalyzer* analyzer = model->context;
+    XRemoteAppContext* app_ctx = xremote_signal_analyzer_get_app_context(analyzer);
+    XRemoteViewDrawFunction xremote_capture_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_capture_view_draw_body = orientation == ViewOrientationVertical ?
+                                         xremote_capture_view_draw_vertical :
+                                         xremote_capture_view_draw_horizontal;
+
+    xremote_canvas_draw_header(canvas, orientation, "Capture");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_capture_view_draw_body(canvas, model);
+
+    const char* exit_str = xremote_app_context_get_exit_str(app_ctx);
+    xremote_canvas_draw_exit_footer(canvas, orientation, exit_str);
+}
+
+static bool xremote_capture_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteSignalAnalyzer* analyzer = xremote_view_get_context(view);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+
+    XRemoteAppExit exit = app_ctx->app_settings->exit_behavior;
+    bool is_step = event->type == InputTypeShort || event->type == InputTypeRepeat;
+
+    if(event->key == InputKeyBack) {
+        if((event->type == InputTypeShort && exit == XRemoteAppExitPress) ||
+           (event->type == InputTypeLong && exit == XRemoteAppExitHold))
+            xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalExit);
+    } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+        xremote_signal_analyzer_send_event(analyzer, XRemoteEventCaptureInspect);
+    } else if(event->key == InputKeyLeft && event->type == InputTypeShort) {
+        xremote_signal_analyzer_send_event(analyzer, XRemoteEventCaptureCompare);
+    } else if(event->key == InputKeyRight && event->type == InputTypeShort) {
+        xremote_signal_analyzer_mark_selected(analyzer);
+
+        with_view_model(
+            xremote_view_get_view(view),
+            XRemoteViewModel * model,
+            { model->context = analyzer; },
+            true);
+    } else if(is_step && (event->key == InputKeyUp || event->key == InputKeyDown)) {
+        xremote_signal_analyzer_move_selection(analyzer, event->key == InputKeyUp ? -1 : 1);
+
+        with_view_model(
+            xremote_view_get_view(view),
+            XRemoteViewModel * model,
+            { model->context = analyzer; },
+            true);
+    }
+
+    return true;
+}
+
+XRemoteView* xremote_capture_view_alloc(void* app_ctx, void* analyzer) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_capture_view_input_callback, xremote_capture_view_draw_callback);
+    xremote_view_set_context(view, analyzer, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+
+    return view;
+}
@@ -9,61 +9,34 @@
 #include "xremote_common_view.h"
 #include "../xremote_app.h"
 
-typedef struct {
-    int index;
-    const char* name;
-} XRemoteButton;
-
-static const XRemoteButton g_buttons[XREMOTE_BUTTON_COUNT + 1] = {
-    {0, XREMOTE_COMMAND_POWER},
-    {1, XREMOTE_COMMAND_SETUP},
-    {2, XREMOTE_COMMAND_INPUT},
-    {3, XREMOTE_COMMAND_EJECT},
-    {4, XREMOTE_COMMAND_MENU},
-    {5, XREMOTE_COMMAND_LIST},
-    {6, XREMOTE_COMMAND_INFO},
-    {7, XREMOTE_COMMAND_BACK},
-    {8, XREMOTE_COMMAND_OK},
-    {9, XREMOTE_COMMAND_UP},
-    {10, XREMOTE_COMMAND_DOWN},
-    {11, XREMOTE_COMMAND_LEFT},
-    {12, XREMOTE_COMMAND_RIGHT},
-    {13, XREMOTE_COMMAND_JUMP_FORWARD},
-    {14, XREMOTE_COMMAND_JUMP_BACKWARD},
-    {15, XREMOTE_COMMAND_FAST_FORWARD},
-    {16, XREMOTE_COMMAND_FAST_BACKWARD},
-    {17, XREMOTE_COMMAND_PLAY_PAUSE},
-    {18, XREMOTE_COMMAND_PAUSE},
-    {19, XREMOTE_COMMAND_PLAY},
-    {20, XREMOTE_COMMAND_STOP},
-    {21, XREMOTE_COMMAND_MUTE},
-    {22, XREMOTE_COMMAND_MODE},
-    {23, XREMOTE_COMMAND_VOL_UP},
-    {24, XREMOTE_COMMAND_VOL_DOWN},
-    {25, XREMOTE_COMMAND_NEXT_CHAN},
-    {26, XREMOTE_COMMAND_PREV_CHAN},
-    {-1, NULL}};
-
-const char* xremote_button_get_name(int index) {
-    if(index > XREMOTE_BUTTON_COUNT) return NULL;
-    return g_buttons[index].name;
-}
-
-int xremote_button_get_index(const char* name) {
-    size_t i;
-    for(i = 0; i < XREMOTE_BUTTON_COUNT; i++) {
-        if(!strcmp(name, g_buttons[i].name)) return g_buttons[i].index;
-    }
-    return -1;
-}
-
 struct XRemoteView {
     XRemoteClearCallback on_clear;
     XRemoteAppContext* app_ctx;
+    InfraredRemoteButton* pressed;
     View* view;
     void* context;
+#if XREMOTE_DIAG_LATENCY
+    ViewInputCallback input_cb;
+#endif
 };
 
+#if XREMOTE_DIAG_LATENCY
+static bool xremote_view_input_callback(InputEvent* event, void* context) {
+    XRemoteView* rview = context;
+    XRemoteDiag* diag = rview->app_ctx->diag;
+
+    if(rview->input_cb == NULL) return false;
+
+    /* Views send on press, short or long events, held repeats do not start a new trace */
+    if(event->type != InputTypeRelease && event->type != InputTypeRepeat) {
+        XREMOTE_LATENCY_BEGIN(diag);
+        XREMOTE_LATENCY_MARK(diag, XRemoteLatencyInput);
+    }
+
+    return rview->input_cb(event, context);
+}
+#endif
+
 XRemoteView* xremote_view_alloc_empty() {
     XRemoteView* remote_view = malloc(sizeof(XRemoteView));
     return remote_view;
@@ -77,12 +50,18 @@ XRemoteView*
 
     remote_view->context = NULL;
     remote_view->on_clear = NULL;
+    remote_view->pressed = NULL;
 
     view_set_orientation(
         remote_view->view, ((XRemoteAppContext*)app_ctx)->app_settings->orientation);
     view_allocate_model(remote_view->view, ViewModelTypeLocking, sizeof(XRemoteViewModel));
 
+#if XREMOTE_DIAG_LATENCY
+    remote_view->input_cb = input_cb;
+    view_set_input_callback(remote_view->view, xremote_view_input_callback);
+#else
     view_set_input_callback(remote_view->view, input_cb);
+#endif
     view_set_draw_callback(remote_view->view, draw_cb);
     view_set_context(remote_view->view, remote_view);
 
@@ -210,34 +189,59 @@ static InfraredRemoteButton*
     return button;
 }
 
+InfraredRemoteButton*
+    xremote_button_lookup(InfraredRemote* remote, const char* name, bool alt_names) {
+    xremote_app_assert(name, NULL);
+    InfraredRemoteButton* button = infrared_remote_get_button_by_name(remote, name);
+    if(button == NULL && alt_names)
+        button = infrared_remote_get_button_by_alt_name(remote, name, true);
+    return button;
+}
+
 InfraredRemoteButton* xremote_view_get_button_by_name(XRemoteView* rview, const char* name) {
     xremote_app_assert(rview->context, NULL);
     xremote_app_assert(rview->app_ctx, NULL);
 
     XRemoteAppSettings* settings = rview->app_ctx->app_settings;
     XRemoteAppButtons* buttons = (XRemoteAppButtons*)rview->context;
-    InfraredRemoteButton* button = infrared_remote_get_button_by_name(buttons->remote, name);
 
-    if(button == NULL && settings->alt_names)
-        button = infrared_remote_get_button_by_alt_name(buttons->remote, name, true);
+    uint32_t start = xremote_diag_start();
+    InfraredRemoteButton* button =
+        xremote_button_lookup(buttons->remote, name, settings->alt_names);
+    xremote_diag_stop(rview->app_ctx->diag, XRemoteDiagLookup, start);
+    XREMOTE_LATENCY_MARK(rview->app_ctx->diag, XRemoteLatencyLookup);
 
     return button;
 }
 
 bool xremote_view_press_button(XRemoteView* rview, InfraredRemoteButton* button) {
+    rview->pressed = NULL;
     xremote_app_assert(button, false);
 
     XRemoteAppSettings* settings = rview->app_ctx->app_settings;
     InfraredSignal* signal = infrared_remote_button_get_signal(button);
     xremote_app_assert(signal, false);
 
-    dolphin_deed(DolphinDeedIrSend);
-    infrared_signal_transmit_times(signal, settings->repeat_count);
-    xremote_app_context_notify_led(rview->app_ctx);
+    /* Transmitter thread sends the signal and blinks when it is done */
+    XRemoteTransmitter* transmitter = rview->app_ctx->transmitter;
+    if(!xremote_transmitter_send(transmitter, signal, settings->repeat_count)) return false;
 
+    dolphin_deed(DolphinDeedIrSend);
+    XREMOTE_LATENCY_MARK(rview->app_ctx->diag, XRemoteLatencyDeed);
+    rview->pressed = button;
     return true;
 }
 
+bool xremote_view_hold_button(XRemoteView* rview) {
+    xremote_app_assert(rview->pressed, false);
+    InfraredSignal* signal = infrared_remote_button_get_signal(rview->pressed);
+    return xremote_transmitter_hold(rview->app_ctx->transmitter, signal);
+}
+
+void xremote_view_release_button(XRemoteView* rview) {
+    xremote_transmitter_release(rview->app_ctx->transmitter);
+}
+
 bool xremote_view_send_ir_msg_by_name(XRemoteView* rview, const char* name) {
     InfraredRemoteButton* button = xremote_view_get_button_by_name(rview, name);
     return (button != NULL) ? xremote_view_press_button(rview, button) : false;
@@ -256,6 +260,7 @@ void xremote_view_model_context_set(XRemoteView* rview, void* model_ctx) {
             model->back_pressed = false;
             model->ok_pressed = false;
             model->hold = false;
+            model->ignore_key = InputKeyMAX;
         },
         true);
 }
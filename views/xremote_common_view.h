@@ -21,37 +21,9 @@
 #include <dolphin/dolphin.h>
 
 #include "../infrared/infrared_remote.h"
+#include "../xremote_buttons.h"
 
-#define XREMOTE_BUTTON_COUNT 27
-#define XREMOTE_NAME_MAX     32
-
-#define XREMOTE_COMMAND_POWER         "Power"
-#define XREMOTE_COMMAND_EJECT         "Eject"
-#define XREMOTE_COMMAND_SETUP         "Setup"
-#define XREMOTE_COMMAND_INPUT         "Input"
-#define XREMOTE_COMMAND_MENU          "Menu"
-#define XREMOTE_COMMAND_LIST          "List"
-#define XREMOTE_COMMAND_INFO          "Info"
-#define XREMOTE_COMMAND_BACK          "Back"
-#define XREMOTE_COMMAND_OK            "Ok"
-#define XREMOTE_COMMAND_UP            "Up"
-#define XREMOTE_COMMAND_DOWN          "Down"
-#define XREMOTE_COMMAND_LEFT          "Left"
-#define XREMOTE_COMMAND_RIGHT         "Right"
-#define XREMOTE_COMMAND_JUMP_FORWARD  "Next"
-#define XREMOTE_COMMAND_JUMP_BACKWARD "Prev"
-#define XREMOTE_COMMAND_FAST_FORWARD  "Fast_fo"
-#define XREMOTE_COMMAND_FAST_BACKWARD "Fast_ba"
-#define XREMOTE_COMMAND_PLAY_PAUSE    "Play_pa"
-#define XREMOTE_COMMAND_PAUSE         "Pause"
-#define XREMOTE_COMMAND_PLAY          "Play"
-#define XREMOTE_COMMAND_STOP          "Stop"
-#define XREMOTE_COMMAND_MUTE          "Mute"
-#define XREMOTE_COMMAND_MODE          "Mode"
-#define XREMOTE_COMMAND_VOL_UP        "Vol_up"
-#define XREMOTE_COMMAND_VOL_DOWN      "Vol_dn"
-#define XREMOTE_COMMAND_NEXT_CHAN     "Ch_next"
-#define XREMOTE_COMMAND_PREV_CHAN     "Ch_prev"
+#define XREMOTE_NAME_MAX 32
 
 typedef enum {
     XRemoteEventReserved = 200,
@@ -62,7 +34,17 @@ typedef enum {
     XRemoteEventSignalSend,
     XRemoteEventSignalSkip,
     XRemoteEventSignalAskExit,
-    XRemoteEventSignalExit
+    XRemoteEventSignalExit,
+    XRemoteEventMacroStep,
+    XRemoteEventSweepStep,
+    XRemoteEventUniversalStep,
+    XRemoteEventCaptureStart,
+    XRemoteEventCaptureUpdate,
+    XRemoteEventCaptureInspect,
+    XRemoteEventSignalWave,
+    XRemoteEventCaptureCompare,
+    XRemoteEventTranslateUpdate,
+    XRemoteEventTranslateSend
 } XRemoteEvent;
 
 typedef enum {
@@ -95,6 +77,10 @@ typedef struct {
     bool left_pressed;
     bool right_pressed;
     bool hold;
+    uint8_t page;
+
+    /* Remaining events of this key are dropped until it is released */
+    InputKey ignore_key;
 } XRemoteViewModel;
 
 typedef enum {
@@ -106,10 +92,23 @@ typedef enum {
     /* Main page */
     XRemoteViewSubmenu,
     XRemoteViewLearn,
+    XRemoteViewFreeLearn,
+    XRemoteViewFreeLearnList,
     XRemoteViewSaved,
     XRemoteViewAnalyzer,
+    XRemoteViewCapture,
+    XRemoteViewWave,
+    XRemoteViewDiff,
+    XRemoteViewMacro,
+    XRemoteViewBroadcast,
+    XRemoteViewSweep,
+    XRemoteViewSweepRun,
+    XRemoteViewUniversal,
+    XRemoteViewAC,
+    XRemoteViewTranslate,
     XRemoteViewSettings,
     XRemoteViewAbout,
+    XRemoteViewDiagnostics,
 
     /* Remote app */
     XRemoteViewIRSubmenu,
@@ -119,6 +118,7 @@ typedef enum {
     XRemoteViewIRNavigation,
     XRemoteViewIRCustomPage,
     XRemoteViewIRCustomEditPage,
+    XRemoteViewIRFitRaw,
     XRemoteViewIRAllButtons
 } XRemoteViewID;
 
@@ -129,8 +129,8 @@ typedef void (*XRemoteViewDrawFunction)(Canvas*, XRemoteViewModel*);
 typedef XRemoteView* (*XRemoteViewAllocator)(void* app_ctx);
 typedef XRemoteView* (*XRemoteViewAllocator2)(void* app_ctx, void* model_ctx);
 
-const char* xremote_button_get_name(int index);
-int xremote_button_get_index(const char* name);
+InfraredRemoteButton*
+    xremote_button_lookup(InfraredRemote* remote, const char* name, bool alt_names);
 
 void xremote_canvas_draw_header(Canvas* canvas, ViewOrientation orient, const char* section);
 void xremote_canvas_draw_exit_footer(Canvas* canvas, ViewOrientation orient, const char* text);
@@ -178,6 +178,8 @@ void xremote_view_free(XRemoteView* rview);
 
 InfraredRemoteButton* xremote_view_get_button_by_name(XRemoteView* rview, const char* name);
 bool xremote_view_press_button(XRemoteView* rview, InfraredRemoteButton* button);
+bool xremote_view_hold_button(XRemoteView* rview);
+void xremote_view_release_button(XRemoteView* rview);
 bool xremote_view_send_ir_msg_by_name(XRemoteView* rview, const char* name);
 
 void xremote_view_model_context_set(XRemoteView* rview, void* model_ctx);
@@ -91,7 +91,11 @@ static void xremote_control_view_process(XRemoteView* view, InputEvent* event) {
                 exit == XRemoteAppExitPress) {
                 button = xremote_view_get_button_by_name(view, XREMOTE_COMMAND_MUTE);
                 if(xremote_view_press_button(view, button)) model->back_pressed = true;
+            } else if(event->type == InputTypeLong && event->key != InputKeyBack) {
+                /* Keep repeating the pressed button until the key is released */
+                xremote_view_hold_button(view);
             } else if(event->type == InputTypeRelease) {
+                xremote_view_release_button(view);
                 if(event->key == InputKeyOk)
                     model->ok_pressed = false;
                 else if(event->key == InputKeyUp)
@@ -9,56 +9,51 @@
 #include "xremote_custom_view.h"
 #include "../xremote_app.h"
 
-static void xremote_custom_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+static const char*
+    xremote_custom_view_get_label(XRemoteViewModel* model, XRemoteCustomKey key, bool pressed) {
     XRemoteAppButtons* buttons = model->context;
+    if(model->hold && pressed) key += XRemoteCustomOkHold;
+    return xremote_app_buttons_get_custom_name(buttons, key);
+}
 
-    FuriString* text = model->hold && model->ok_pressed ? buttons->custom_ok_hold :
-                                                          buttons->custom_ok;
-    xremote_canvas_draw_button_wide(
-        canvas, model->ok_pressed, 0, 27, furi_string_get_cstr(text), XRemoteIconEnter);
+static void xremote_custom_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    const char* text = xremote_custom_view_get_label(model, XRemoteCustomOk, model->ok_pressed);
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 27, text, XRemoteIconEnter);
 
-    text = model->hold && model->up_pressed ? buttons->custom_up_hold : buttons->custom_up;
-    xremote_canvas_draw_button_wide(
-        canvas, model->up_pressed, 0, 45, furi_string_get_cstr(text), XRemoteIconArrowUp);
+    text = xremote_custom_view_get_label(model, XRemoteCustomUp, model->up_pressed);
+    xremote_canvas_draw_button_wide(canvas, model->up_pressed, 0, 45, text, XRemoteIconArrowUp);
 
-    text = model->hold && model->down_pressed ? buttons->custom_down_hold : buttons->custom_down;
+    text = xremote_custom_view_get_label(model, XRemoteCustomDown, model->down_pressed);
     xremote_canvas_draw_button_wide(
-        canvas, model->down_pressed, 0, 63, furi_string_get_cstr(text), XRemoteIconArrowDown);
+        canvas, model->down_pressed, 0, 63, text, XRemoteIconArrowDown);
 
-    text = model->hold && model->left_pressed ? buttons->custom_left_hold : buttons->custom_left;
+    text = xremote_custom_view_get_label(model, XRemoteCustomLeft, model->left_pressed);
     xremote_canvas_draw_button_wide(
-        canvas, model->left_pressed, 0, 81, furi_string_get_cstr(text), XRemoteIconArrowLeft);
+        canvas, model->left_pressed, 0, 81, text, XRemoteIconArrowLeft);
 
-    text = model->hold && model->right_pressed ? buttons->custom_right_hold :
-                                                 buttons->custom_right;
+    text = xremote_custom_view_get_label(model, XRemoteCustomRight, model->right_pressed);
     xremote_canvas_draw_button_wide(
-        canvas, model->right_pressed, 0, 99, furi_string_get_cstr(text), XRemoteIconArrowRight);
+        canvas, model->right_pressed, 0, 99, text, XRemoteIconArrowRight);
 }
 
 static void xremote_custom_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
-    XRemoteAppButtons* buttons = model->context;
-
-    FuriString* text = model->hold && model->ok_pressed ? buttons->custom_ok_hold :
-                                                          buttons->custom_ok;
-    xremote_canvas_draw_button_wide(
-        canvas, model->ok_pressed, 0, 7, furi_string_get_cstr(text), XRemoteIconEnter);
+    const char* text = xremote_custom_view_get_label(model, XRemoteCustomOk, model->ok_pressed);
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 7, text, XRemoteIconEnter);
 
-    text = model->hold && model->up_pressed ? buttons->custom_up_hold : buttons->custom_up;
-    xremote_canvas_draw_button_wide(
-        canvas, model->up_pressed, 0, 25, furi_string_get_cstr(text), XRemoteIconArrowUp);
+    text = xremote_custom_view_get_label(model, XRemoteCustomUp, model->up_pressed);
+    xremote_canvas_draw_button_wide(canvas, model->up_pressed, 0, 25, text, XRemoteIconArrowUp);
 
-    text = model->hold && model->down_pressed ? buttons->custom_down_hold : buttons->custom_down;
+    text = xremote_custom_view_get_label(model, XRemoteCustomDown, model->down_pressed);
     xremote_canvas_draw_button_wide(
-        canvas, model->down_pressed, 0, 43, furi_string_get_cstr(text), XRemoteIconArrowDown);
+        canvas, model->down_pressed, 0, 43, text, XRemoteIconArrowDown);
 
-    text = model->hold && model->left_pressed ? buttons->custom_left_hold : buttons->custom_left;
+    text = xremote_custom_view_get_label(model, XRemoteCustomLeft, model->left_pressed);
     xremote_canvas_draw_button_wide(
-        canvas, model->left_pressed, 64, 20, furi_string_get_cstr(text), XRemoteIconArrowLeft);
+        canvas, model->left_pressed, 64, 20, text, XRemoteIconArrowLeft);
 
-    text = model->hold && model->right_pressed ? buttons->custom_right_hold :
-                                                 buttons->custom_right;
+    text = xremote_custom_view_get_label(model, XRemoteCustomRight, model->right_pressed);
     xremote_canvas_draw_button_wide(
-        canvas, model->right_pressed, 64, 38, furi_string_get_cstr(text), XRemoteIconArrowRight);
+        canvas, model->right_pressed, 64, 38, text, XRemoteIconArrowRight);
 }
 
 static void xremote_custom_view_draw_page_name(Canvas* canvas, ViewOrientation orientation) {
@@ -88,6 +83,21 @@ static void xremote_custom_view_draw_callback(Canvas* canvas, void* context) {
     xremote_canvas_draw_exit_footer(canvas, orientation, exit_str);
 }
 
+static void xremote_custom_view_set_pressed(XRemoteViewModel* model, InputKey key, bool pressed) {
+    if(key == InputKeyOk)
+        model->ok_pressed = pressed;
+    else if(key == InputKeyUp)
+        model->up_pressed = pressed;
+    else if(key == InputKeyDown)
+        model->down_pressed = pressed;
+    else if(key == InputKeyLeft)
+        model->left_pressed = pressed;
+    else if(key == InputKeyRight)
+        model->right_pressed = pressed;
+    else if(key == InputKeyBack)
+        model->back_pressed = pressed;
+}
+
 static void xremote_custom_view_process(XRemoteView* view, InputEvent* event) {
     with_view_model(
         xremote_view_get_view(view),
@@ -98,76 +108,31 @@ static void xremote_custom_view_process(XRemoteView* view, InputEvent* event) {
             XRemoteAppExit exit_behavior = app_ctx->app_settings->exit_behavior;
             model->context = buttons;
 
-            if(event->type == InputTypeShort) {
+            if(event->type == InputTypeShort || event->type == InputTypeLong) {
                 InfraredRemoteButton* button = NULL;
-
-                if(event->key == InputKeyOk) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_ok);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->ok_pressed = true;
-                } else if(event->key == InputKeyUp) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_up);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->up_pressed = true;
-                } else if(event->key == InputKeyDown) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_down);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->down_pressed = true;
-                } else if(event->key == InputKeyLeft) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_left);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->left_pressed = true;
-                } else if(event->key == InputKeyRight) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_right);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->right_pressed = true;
-                } else if(event->key == InputKeyBack && exit_behavior == XRemoteAppExitHold) {
-                    button = xremote_view_get_button_by_name(view, XREMOTE_COMMAND_BACK);
-                    if(xremote_view_press_button(view, button)) model->back_pressed = true;
+                bool hold = event->type == InputTypeLong;
+                if(hold) model->hold = true;
+
+                if(event->key == InputKeyBack) {
+                    if((!hold && exit_behavior == XRemoteAppExitHold) ||
+                       (hold && exit_behavior == XRemoteAppExitPress))
+                        button = xremote_view_get_button_by_name(view, XREMOTE_COMMAND_BACK);
+                } else {
+                    /* Custom bindings are resolved when the layout is loaded */
+                    XRemoteCustomKey key = xremote_app_get_custom_key(event->key, hold);
+                    button = xremote_app_buttons_get_custom(buttons, key);
                 }
-            } else if(event->type == InputTypeLong) {
-                InfraredRemoteButton* button = NULL;
-                model->hold = true;
-
-                if(event->key == InputKeyOk) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_ok_hold);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->ok_pressed = true;
-                } else if(event->key == InputKeyUp) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_up_hold);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->up_pressed = true;
-                } else if(event->key == InputKeyDown) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_down_hold);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->down_pressed = true;
-                } else if(event->key == InputKeyLeft) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_left_hold);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->left_pressed = true;
-                } else if(event->key == InputKeyRight) {
-                    const char* button_name = furi_string_get_cstr(buttons->custom_right_hold);
-                    button = xremote_view_get_button_by_name(view, button_name);
-                    if(xremote_view_press_button(view, button)) model->right_pressed = true;
-                } else if(event->key == InputKeyBack && exit_behavior == XRemoteAppExitPress) {
-                    button = xremote_view_get_button_by_name(view, XREMOTE_COMMAND_BACK);
-                    if(xremote_view_press_button(view, button)) model->back_pressed = true;
+
+                if(xremote_view_press_button(view, button)) {
+                    xremote_custom_view_set_pressed(model, event->key, true);
+
+                    /* Hold binding keeps repeating until the key is released */
+                    if(hold && event->key != InputKeyBack) xremote_view_hold_button(view);
                 }
             } else if(event->type == InputTypeRelease) {
+                xremote_view_release_button(view);
                 model->hold = false;
-
-                if(event->key == InputKeyOk)
-                    model->ok_pressed = false;
-                else if(event->key == InputKeyUp)
-                    model->up_pressed = false;
-                else if(event->key == InputKeyDown)
-                    model->down_pressed = false;
-                else if(event->key == InputKeyLeft)
-                    model->left_pressed = false;
-                else if(event->key == InputKeyRight)
-                    model->right_pressed = false;
-                else if(event->key == InputKeyBack)
-                    model->back_pressed = false;
+                xremote_custom_view_set_pressed(model, event->key, false);
             }
         },
         true);
@@ -0,0 +1,197 @@
+/*!
+ *  @file flipper-xremote/views/xremote_diag_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief View functionality for heap, stack and timing diagnostics.
+ */
+
+#include "xremote_diag_view.h"
+#include "../xremote_app.h"
+
+#define XREMOTE_DIAG_ROWS_MAX  (4 + XRemoteDiagMax + XREMOTE_DIAG_THREADS_MAX)
+#define XREMOTE_DIAG_VALUE_MAX 16
+
+typedef struct {
+    const char* label;
+    char value[XREMOTE_DIAG_VALUE_MAX];
+} XRemoteDiagRow;
+
+static size_t xremote_diag_view_fill_rows(XRemoteDiag* diag, XRemoteDiagRow* rows) {
+    size_t count = 0;
+
+    rows[count].label = "Heap:";
+    xremote_diag_format_size(rows[count++].value, XREMOTE_DIAG_VALUE_MAX, memmgr_get_free_heap());
+
+    rows[count].label = "Min:";
+    size_t heap_min = memmgr_get_minimum_free_heap();
+    xremote_diag_format_size(rows[count++].value, XREMOTE_DIAG_VALUE_MAX, heap_min);
+
+    rows[count].label = "Remote:";
+    xremote_diag_format_size(rows[count++].value, XREMOTE_DIAG_VALUE_MAX, diag->remote_size);
+
+    for(size_t i = 0; i < XRemoteDiagMax; i++) {
+        rows[count].label = xremote_diag_get_stage_str(i);
+        uint32_t time_us = diag->timings[i].max_us;
+        xremote_diag_format_time(rows[count++].value, XREMOTE_DIAG_VALUE_MAX, time_us);
+    }
+
+    /* Transmit queue high-water mark and dropped signals */
+    rows[count].label = "Queue:";
+    snprintf(
+        rows[count++].value,
+        XREMOTE_DIAG_VALUE_MAX,
+        "%lu/%lu",
+        diag->tx_depth_max,
+        diag->tx_dropped);
+
+    for(size_t i = 0; i < diag->thread_count; i++) {
+        /* Thread names are stored as file keys, skip the "stack_" prefix */
+        const char* name = diag->threads[i].name;
+        rows[count].label = strncmp(name, "stack_", 6) ? name : name + 6;
+        size_t space = furi_thread_get_stack_space(diag->threads[i].id);
+        xremote_diag_format_size(rows[count++].value, XREMOTE_DIAG_VALUE_MAX, space);
+    }
+
+    return count;
+}
+
+static void xremote_diag_view_draw_row(Canvas* canvas, uint8_t x, uint8_t y, XRemoteDiagRow* row) {
+    canvas_draw_str_aligned(canvas, x, y, AlignLeft, AlignTop, row->label);
+    canvas_draw_str_aligned(canvas, x + 60, y, AlignRight, AlignTop, row->value);
+}
+
+static void xremote_diag_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteAppContext* app_ctx = model->context;
+    XRemoteDiagRow rows[XREMOTE_DIAG_ROWS_MAX];
+    size_t count = xremote_diag_view_fill_rows(app_ctx->diag, rows);
+
+    for(size_t i = 0; i < count; i++) xremote_diag_view_draw_row(canvas, 0, 22 + i * 8, &rows[i]);
+
+    xremote_canvas_draw_icon(canvas, 6, 113, XRemoteIconEnter);
+    canvas_draw_str_aligned(canvas, 12, 109, AlignLeft, AlignTop, "Save");
+}
+
+static void xremote_diag_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteAppContext* app_ctx = model->context;
+    XRemoteDiagRow rows[XREMOTE_DIAG_ROWS_MAX];
+    size_t count = xremote_diag_view_fill_rows(app_ctx->diag, rows);
+
+    /* Heap and remote size on the left, timings under the header on the right */
+    size_t i;
+    for(i = 0; i < 3; i++) xremote_diag_view_draw_row(canvas, 0, i * 9, &rows[i]);
+    for(; i < 3 + XRemoteDiagMax; i++)
+        xremote_diag_view_draw_row(canvas, 66, 21 + (i - 3) * 9, &rows[i]);
+
+    /* Queue and two stack watermarks fit, the saved file contains all of them */
+    for(uint8_t y = 27; i < count && y <= 45; i++, y += 9)
+        xremote_diag_view_draw_row(canvas, 0, y, &rows[i]);
+
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Save");
+}
+
+#if XREMOTE_DIAG_LATENCY
+static void xremote_diag_view_draw_latency(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteAppContext* app_ctx = model->context;
+    char value[XREMOTE_DIAG_VALUE_MAX];
+
+    /* Horizontal table fits left of the header, vertical one goes below it */
+    bool vertical = app_ctx->app_settings->orientation == ViewOrientationVertical;
+    const uint8_t columns[3] = {vertical ? 34 : 46, vertical ? 49 : 66, vertical ? 64 : 86};
+    const char* titles[3] = {"min", "avg", "p95"};
+    uint8_t y = vertical ? 22 : 0;
+
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, "ms");
+    for(size_t i = 0; i < 3; i++)
+        canvas_draw_str_aligned(canvas, columns[i], y, AlignRight, AlignTop, titles[i]);
+
+    for(size_t i = 0; i < XRemoteLatencyMax; i++) {
+        XRemoteLatencyStats stats;
+        xremote_diag_latency_stats(app_ctx->diag, i, &stats);
+        uint32_t values[3] = {stats.min_us, stats.avg_us, stats.p95_us};
+
+        const char* label = xremote_diag_get_latency_str(i);
+        canvas_draw_str_aligned(canvas, 0, y += 8, AlignLeft, AlignTop, label);
+        if(!stats.count) continue;
+
+        for(size_t j = 0; j < 3; j++) {
+            xremote_diag_format_latency(value, sizeof(value), values[j]);
+            canvas_draw_str_aligned(canvas, columns[j], y, AlignRight, AlignTop, value);
+        }
+    }
+
+    if(vertical) {
+        xremote_canvas_draw_icon(canvas, 6, 113, XRemoteIconEnter);
+        canvas_draw_str_aligned(canvas, 12, 109, AlignLeft, AlignTop, "Save");
+    } else {
+        xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+        elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Save");
+    }
+}
+#endif
+
+static void xremote_diag_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteAppContext* app_ctx = model->context;
+    XRemoteViewDrawFunction xremote_diag_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_diag_view_draw_body = orientation == ViewOrientationVertical ?
+                                      xremote_diag_view_draw_vertical :
+                                      xremote_diag_view_draw_horizontal;
+
+#if XREMOTE_DIAG_LATENCY
+    /* Second page shows press to transmit latency of the last traces */
+    if(model->page) xremote_diag_view_draw_body = xremote_diag_view_draw_latency;
+#endif
+
+    xremote_canvas_draw_header(canvas, orientation, model->page ? "Lat" : "Diag");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_diag_view_draw_body(canvas, model);
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
+}
+
+static bool xremote_diag_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+
+#if XREMOTE_DIAG_LATENCY
+    if(event->key == InputKeyLeft || event->key == InputKeyRight) {
+        if(event->type != InputTypeShort) return true;
+
+        with_view_model(
+            xremote_view_get_view(view),
+            XRemoteViewModel * model,
+            { model->page = !model->page; },
+            true);
+
+        return true;
+    }
+#endif
+
+    if(event->key != InputKeyOk) return false;
+    if(event->type != InputTypeShort) return true;
+
+    /* Store snapshot on SD card and blink to confirm */
+    if(xremote_diag_store(app_ctx->diag)) xremote_app_context_notify_led(app_ctx);
+    return true;
+}
+
+XRemoteView* xremote_diag_view_alloc(void* app_ctx) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_diag_view_input_callback, xremote_diag_view_draw_callback);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = app_ctx;
+            model->page = 0;
+        },
+        true);
+
+    return view;
+}
@@ -0,0 +1,13 @@
+/*!
+ *  @file flipper-xremote/views/xremote_diag_view.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief View functionality for heap, stack and timing diagnostics.
+ */
+
+#pragma once
+
+#include "xremote_common_view.h"
+
+XRemoteView* xremote_diag_view_alloc(void* app_ctx);
@@ -0,0 +1,205 @@
+/*!
+ *  @file flipper-xremote/views/xremote_diff_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Signal comparison page view components and functionality.
+ */
+
+#include "xremote_diff_view.h"
+#include "../xremote_analyzer.h"
+
+#define XREMOTE_DIFF_ROWS_HORIZONTAL 4
+#define XREMOTE_DIFF_ROWS_VERTICAL   9
+
+static size_t xremote_diff_view_get_rows(XRemoteAppContext* app_ctx) {
+    return app_ctx->app_settings->orientation == ViewOrientationVertical ?
+               XREMOTE_DIFF_ROWS_VERTICAL :
+               XREMOTE_DIFF_ROWS_HORIZONTAL;
+}
+
+static void xremote_diff_view_draw_bits(
+    Canvas* canvas,
+    const XRemoteDiff* diff,
+    size_t first,
+    uint32_t value,
+    uint8_t y) {
+    uint8_t cell = canvas_width(canvas) / 32;
+
+    /* Most significant bit on the left, differing bits are filled */
+    for(size_t i = 0; i < 32; i++) {
+        uint8_t x = (31 - i) * cell;
+        if(xremote_diff_test(diff, first + i))
+            canvas_draw_box(canvas, x, y, cell > 1 ? cell - 1 : 1, 6);
+        else if(value & (1UL << i))
+            canvas_draw_line(canvas, x, y + 2, x, y + 5);
+        else
+            canvas_draw_dot(canvas, x, y + 5);
+    }
+}
+
+static void
+    xremote_diff_view_draw_messages(Canvas* canvas, XRemoteSignalAnalyzer* analyzer, uint8_t y) {
+    XRemoteDiff* diff = xremote_signal_analyzer_get_diff(analyzer);
+    InfraredSignal* marked = xremote_signal_analyzer_get_marked_signal(analyzer);
+    InfraredSignal* selected = xremote_signal_analyzer_get_ir_signal(analyzer);
+
+    InfraredMessage* a = infrared_signal_get_message(marked);
+    InfraredMessage* b = infrared_signal_get_message(selected);
+    char text[32];
+
+    snprintf(text, sizeof(text), "A: %lX:%lX", a->address, a->command);
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+
+    snprintf(text, sizeof(text), "B: %lX:%lX", b->address, b->command);
+    canvas_draw_str_aligned(canvas, 0, y + 9, AlignLeft, AlignTop, text);
+
+    /* Protocol is shown once when both captures agree on it */
+    const char* protocol = infrared_get_protocol_name(a->protocol);
+    if(diff->protocol_differs)
+        snprintf(text, sizeof(text), "%s/%s", protocol, infrared_get_protocol_name(b->protocol));
+    else
+        snprintf(text, sizeof(text), "%s %u bits", protocol, diff->differing);
+    canvas_draw_str_aligned(canvas, 0, y + 18, AlignLeft, AlignTop, text);
+
+    xremote_diff_view_draw_bits(canvas, diff, 0, a->address ^ b->address, y + 28);
+    xremote_diff_view_draw_bits(canvas, diff, 32, a->command ^ b->command, y + 36);
+}
+
+static void xremote_diff_view_draw_raw(
+    Canvas* canvas,
+    XRemoteSignalAnalyzer* analyzer,
+    uint8_t y,
+    size_t rows,
+    bool wide) {
+    uint8_t row_y = y + (wide ? 20 : 9);
+    XRemoteDiff* diff = xremote_signal_analyzer_get_diff(analyzer);
+    InfraredRawSignal* a = infrared_signal_get_raw_signal(
+        xremote_signal_analyzer_get_marked_signal(analyzer));
+    InfraredRawSignal* b =
+        infrared_signal_get_raw_signal(xremote_signal_analyzer_get_ir_signal(analyzer));
+    char text[32];
+
+    snprintf(text, sizeof(text), "%u/%u, %u diff", diff->size_a, diff->size_b, diff->differing);
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+
+    /* Deltas are computed only for the visible rows, the bitmap says which ones differ */
+    for(size_t i = diff->offset; i < diff->positions && i < diff->offset + rows; i++) {
+        int32_t ta = i < a->timings_size ? (int32_t)a->timings[i] : 0;
+        int32_t tb = i < b->timings_size ? (int32_t)b->timings[i] : 0;
+        char level = i % 2 ? 's' : 'm';
+
+        if(wide)
+            snprintf(text, sizeof(text), "%u%c %ld %ld %+ld", i, level, ta, tb, tb - ta);
+        else
+            snprintf(text, sizeof(text), "%u%c %+ld", i, level, tb - ta);
+
+        if(xremote_diff_test(diff, i))
+            canvas_draw_str_aligned(canvas, 0, row_y, AlignLeft, AlignTop, ">");
+
+        canvas_draw_str_aligned(canvas, 6, row_y, AlignLeft, AlignTop, text);
+        row_y += 9;
+    }
+}
+
+static void xremote_diff_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteSignalAnalyzer* analyzer = model->context;
+    XRemoteAppContext* app_ctx = xremote_signal_analyzer_get_app_context(analyzer);
+    XRemoteDiff* diff = xremote_signal_analyzer_get_diff(analyzer);
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    bool horizontal = orientation == ViewOrientationHorizontal;
+    size_t rows = xremote_diff_view_get_rows(app_ctx);
+
+    xremote_canvas_draw_header(canvas, orientation, "Diff");
+    if(diff == NULL) return;
+
+    if(diff->is_raw)
+        xremote_diff_view_draw_raw(canvas, analyzer, horizontal ? 0 : 22, rows, horizontal);
+    else
+        xremote_diff_view_draw_messages(canvas, analyzer, horizontal ? 0 : 22);
+
+    if(horizontal) {
+        xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconArrowRight);
+        elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Next");
+    } else {
+        xremote_canvas_draw_icon(canvas, 6, 117, XRemoteIconArrowRight);
+        canvas_draw_str_aligned(canvas, 12, 113, AlignLeft, AlignTop, "Next");
+    }
+
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
+}
+
+static void xremote_diff_view_scroll(XRemoteDiff* diff, InputKey key, size_t rows) {
+    size_t last = diff->positions > rows ? diff->positions - rows : 0;
+
+    if(key == InputKeyUp && diff->offset > 0) {
+        diff->offset--;
+    } else if(key == InputKeyDown && diff->offset < last) {
+        diff->offset++;
+    } else if(key == InputKeyLeft || key == InputKeyRight) {
+        /* Jump to the nearest differing position before or after the first visible row */
+        int next = xremote_diff_find(diff, diff->offset, key == InputKeyRight);
+        if(next >= 0) diff->offset = MIN((size_t)next, last);
+    }
+}
+
+static bool xremote_diff_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteSignalAnalyzer* analyzer = xremote_view_get_context(view);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+    XRemoteDiff* diff = xremote_signal_analyzer_get_diff(analyzer);
+
+    if(event->key == InputKeyBack) {
+        /* Retry resumes the continuous capture where it was left */
+        if(event->type == InputTypeShort)
+            xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalRetry);
+        return true;
+    }
+
+    bool is_step = event->type == InputTypeShort || event->type == InputTypeRepeat;
+    if(!is_step || diff == NULL || !diff->is_raw) return true;
+
+    xremote_diff_view_scroll(diff, event->key, xremote_diff_view_get_rows(app_ctx));
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+
+    return true;
+}
+
+void xremote_diff_view_reset(XRemoteView* view) {
+    XRemoteSignalAnalyzer* analyzer = xremote_view_get_context(view);
+    XRemoteDiff* diff = xremote_signal_analyzer_get_diff(analyzer);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+
+    /* Start at the first difference so the interesting part is visible right away */
+    if(diff != NULL && diff->is_raw && !xremote_diff_test(diff, 0))
+        xremote_diff_view_scroll(diff, InputKeyRight, xremote_diff_view_get_rows(app_ctx));
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+}
+
+XRemoteView* xremote_diff_view_alloc(void* app_ctx, void* analyzer) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_diff_view_input_callback, xremote_diff_view_draw_callback);
+    xremote_view_set_context(view, analyzer, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+
+    return view;
+}
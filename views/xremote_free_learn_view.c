@@ -0,0 +1,133 @@
+/*!
+ *  @file flipper-xremote/views/xremote_free_learn_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Free-form learn page view components and functionality.
+ */
+
+#include "xremote_free_learn_view.h"
+#include "../xremote_free_learn.h"
+
+static void xremote_free_learn_view_format_last(
+    char* text,
+    size_t length,
+    const XRemoteFreeLearnStatus* status) {
+    if(status->full) {
+        snprintf(text, length, "Remote is full");
+        return;
+    }
+
+    if(status->name == NULL) {
+        snprintf(text, length, "Press any\nbutton on\nthe remote.");
+        return;
+    }
+
+    const char* state = status->repeated ? "Again" : "New";
+    if(status->is_raw) {
+        snprintf(text, length, "%s: %s\nRAW %u", state, status->name, status->timings_size);
+        return;
+    }
+
+    snprintf(
+        text,
+        length,
+        "%s: %s\n%s %lX:%lX",
+        state,
+        status->name,
+        infrared_get_protocol_name(status->message.protocol),
+        status->message.address,
+        status->message.command);
+}
+
+static void xremote_free_learn_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteFreeLearn* learn = model->context;
+
+    XRemoteAppContext* app_ctx = xremote_free_learn_get_app_context(learn);
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_canvas_draw_header(canvas, orientation, "Learn");
+
+    XRemoteFreeLearnStatus status;
+    xremote_free_learn_get_status(learn, &status);
+
+    char last_text[64];
+    char info_text[96];
+    xremote_free_learn_view_format_last(last_text, sizeof(last_text), &status);
+    snprintf(info_text, sizeof(info_text), "Buttons: %u\n%s", status.count, last_text);
+
+    if(orientation == ViewOrientationHorizontal) {
+        elements_multiline_text_aligned(canvas, 0, 12, AlignLeft, AlignTop, info_text);
+        xremote_canvas_draw_button_wide(
+            canvas, model->ok_pressed, 68, 22, "Finish", XRemoteIconEnter);
+        xremote_canvas_draw_button_wide(
+            canvas, model->left_pressed, 68, 40, "Undo", XRemoteIconArrowLeft);
+    } else {
+        elements_multiline_text_aligned(canvas, 0, 30, AlignLeft, AlignTop, info_text);
+        xremote_canvas_draw_button_wide(
+            canvas, model->ok_pressed, 0, 82, "Finish", XRemoteIconEnter);
+        xremote_canvas_draw_button_wide(
+            canvas, model->left_pressed, 0, 100, "Undo", XRemoteIconArrowLeft);
+    }
+
+    const char* exit_str = xremote_app_context_get_exit_str(app_ctx);
+    xremote_canvas_draw_exit_footer(canvas, orientation, exit_str);
+}
+
+static bool xremote_free_learn_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteFreeLearn* learn = xremote_view_get_context(view);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+    XRemoteAppExit exit = app_ctx->app_settings->exit_behavior;
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = learn;
+
+            if(event->type == InputTypePress) {
+                if(event->key == InputKeyOk) {
+                    model->ok_pressed = true;
+                    xremote_free_learn_send_event(learn, XRemoteEventSignalFinish);
+                } else if(event->key == InputKeyLeft) {
+                    model->left_pressed = true;
+                    xremote_free_learn_undo(learn);
+                }
+            } else if(
+                (event->type == InputTypeShort || event->type == InputTypeLong) &&
+                event->key == InputKeyBack) {
+                if((event->type == InputTypeShort && exit == XRemoteAppExitPress) ||
+                   (event->type == InputTypeLong && exit == XRemoteAppExitHold))
+                    xremote_free_learn_send_event(learn, XRemoteEventSignalAskExit);
+            } else if(event->type == InputTypeRelease) {
+                if(event->key == InputKeyOk)
+                    model->ok_pressed = false;
+                else if(event->key == InputKeyLeft)
+                    model->left_pressed = false;
+            }
+        },
+        true);
+
+    return true;
+}
+
+XRemoteView* xremote_free_learn_view_alloc(void* app_ctx, void* learn) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_free_learn_view_input_callback, xremote_free_learn_view_draw_callback);
+    xremote_view_set_context(view, learn, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = learn;
+            model->left_pressed = false;
+            model->ok_pressed = false;
+        },
+        true);
+
+    return view;
+}
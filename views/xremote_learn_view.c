@@ -21,12 +21,25 @@ static void xremote_learn_view_draw_callback(Canvas* canvas, void* context) {
     ViewOrientation orientation = app_ctx->app_settings->orientation;
     xremote_canvas_draw_header(canvas, orientation, "Learn");
 
+    size_t total = 0;
+    size_t count = xremote_learn_get_capture_count(learn_ctx, &total);
     char info_text[128];
-    snprintf(
-        info_text,
-        sizeof(info_text),
-        "Press\n\"%s\"\nbutton on\nthe remote.",
-        button_name != NULL ? button_name : "");
+
+    if(total > 1) {
+        snprintf(
+            info_text,
+            sizeof(info_text),
+            "Press\n\"%s\"\nbutton on\nthe remote (%u/%u).",
+            button_name != NULL ? button_name : "",
+            count + 1,
+            total);
+    } else {
+        snprintf(
+            info_text,
+            sizeof(info_text),
+            "Press\n\"%s\"\nbutton on\nthe remote.",
+            button_name != NULL ? button_name : "");
+    }
 
     if(orientation == ViewOrientationHorizontal) {
         elements_multiline_text_aligned(canvas, 0, 12, AlignLeft, AlignTop, info_text);
@@ -57,6 +70,16 @@ static void xremote_learn_success_view_draw_callback(Canvas* canvas, void* conte
     xremote_canvas_draw_header(canvas, app_ctx->app_settings->orientation, NULL);
     const char* button_name = xremote_learn_get_curr_button_name(learn_ctx);
     char signal_info[128];
+    char title[32];
+
+    /* Consensus of multiple captures reports how well they agreed */
+    size_t total = 0;
+    xremote_learn_get_capture_count(learn_ctx, &total);
+
+    if(total > 1)
+        snprintf(title, sizeof(title), "Quality: %u%%", xremote_learn_get_quality(learn_ctx));
+    else
+        snprintf(title, sizeof(title), "Received signal");
 
     if(infrared_signal_is_raw(ir_signal)) {
         InfraredRawSignal* raw = infrared_signal_get_raw_signal(ir_signal);
@@ -89,7 +112,7 @@ static void xremote_learn_success_view_draw_callback(Canvas* canvas, void* conte
     }
 
     if(app_ctx->app_settings->orientation == ViewOrientationHorizontal) {
-        canvas_draw_str_aligned(canvas, 0, 0, AlignLeft, AlignTop, "Received signal");
+        canvas_draw_str_aligned(canvas, 0, 0, AlignLeft, AlignTop, title);
         elements_multiline_text_aligned(canvas, 0, 16, AlignLeft, AlignTop, signal_info);
         xremote_canvas_draw_button_wide(
             canvas, model->ok_pressed, 68, 12, "Finish", XRemoteIconEnter);
@@ -98,7 +121,7 @@ static void xremote_learn_success_view_draw_callback(Canvas* canvas, void* conte
         xremote_canvas_draw_button_wide(
             canvas, model->back_pressed, 68, 48, "Retry", XRemoteIconBack);
     } else {
-        canvas_draw_str_aligned(canvas, 0, 12, AlignLeft, AlignTop, "Received signal");
+        canvas_draw_str_aligned(canvas, 0, 12, AlignLeft, AlignTop, title);
         elements_multiline_text_aligned(canvas, 0, 27, AlignLeft, AlignTop, signal_info);
         xremote_canvas_draw_button_wide(
             canvas, model->ok_pressed, 0, 76, "Finish", XRemoteIconEnter);
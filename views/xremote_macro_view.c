@@ -0,0 +1,119 @@
+/*!
+ *  @file flipper-xremote/views/xremote_macro_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Macro player page view components and functionality.
+ */
+
+#include "xremote_macro_view.h"
+#include "../xremote_macro.h"
+
+static void xremote_macro_view_draw_info(Canvas* canvas, XRemoteMacro* macro, uint8_t y) {
+    size_t count = xremote_macro_get_step_count(macro);
+    size_t step = xremote_macro_get_step(macro);
+    char text[32];
+
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, xremote_macro_get_name(macro));
+    snprintf(text, sizeof(text), "Step: %u/%u", step, count);
+    canvas_draw_str_aligned(canvas, 0, y + 10, AlignLeft, AlignTop, text);
+
+    snprintf(text, sizeof(text), "Button: %s", xremote_macro_get_button(macro));
+    canvas_draw_str_aligned(canvas, 0, y + 20, AlignLeft, AlignTop, text);
+    const char* state = xremote_macro_get_state_str(macro);
+    canvas_draw_str_aligned(canvas, 0, y + 30, AlignLeft, AlignTop, state);
+}
+
+static void xremote_macro_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteMacro* macro = model->context;
+    size_t count = xremote_macro_get_step_count(macro);
+    float progress = (float)xremote_macro_get_step(macro) / count;
+
+    xremote_macro_view_draw_info(canvas, macro, 24);
+    elements_progress_bar(canvas, 0, 66, 64, progress);
+
+    bool playing = xremote_macro_get_state(macro) == XRemoteMacroStatePlaying;
+    const char* text = playing ? "Restart" : "Play";
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 82, text, XRemoteIconEnter);
+}
+
+static void xremote_macro_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteMacro* macro = model->context;
+    size_t count = xremote_macro_get_step_count(macro);
+    float progress = (float)xremote_macro_get_step(macro) / count;
+
+    xremote_macro_view_draw_info(canvas, macro, 0);
+    elements_progress_bar(canvas, 0, 42, 128, progress);
+
+    bool playing = xremote_macro_get_state(macro) == XRemoteMacroStatePlaying;
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(
+        canvas, 12, 64, AlignLeft, AlignBottom, playing ? "Restart" : "Play");
+}
+
+static void xremote_macro_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteMacro* macro = model->context;
+    XRemoteAppContext* app_ctx = xremote_macro_get_app_context(macro);
+    XRemoteViewDrawFunction xremote_macro_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_macro_view_draw_body = orientation == ViewOrientationVertical ?
+                                       xremote_macro_view_draw_vertical :
+                                       xremote_macro_view_draw_horizontal;
+
+    bool playing = xremote_macro_get_state(macro) == XRemoteMacroStatePlaying;
+    const char* exit_str = playing ? "Press to stop" : "Press to exit";
+
+    xremote_canvas_draw_header(canvas, orientation, "Macro");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_macro_view_draw_body(canvas, model);
+    xremote_canvas_draw_exit_footer(canvas, orientation, exit_str);
+}
+
+static bool xremote_macro_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteMacro* macro = xremote_view_get_context(view);
+    bool playing = xremote_macro_get_state(macro) == XRemoteMacroStatePlaying;
+
+    /* Back cancels playback first and exits only when nothing is playing */
+    if(event->key == InputKeyBack) {
+        if(!playing) return false;
+        if(event->type == InputTypeShort) xremote_macro_cancel(macro);
+    } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+        xremote_macro_play(macro);
+    }
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = macro;
+            if(event->key == InputKeyOk && event->type == InputTypePress)
+                model->ok_pressed = true;
+            else if(event->key == InputKeyOk && event->type == InputTypeRelease)
+                model->ok_pressed = false;
+        },
+        true);
+
+    return true;
+}
+
+XRemoteView* xremote_macro_view_alloc(void* app_ctx, void* macro) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_macro_view_input_callback, xremote_macro_view_draw_callback);
+    xremote_view_set_context(view, macro, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = macro;
+            model->ok_pressed = false;
+        },
+        true);
+
+    return view;
+}
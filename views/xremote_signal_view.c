@@ -23,6 +23,15 @@ static void xremote_signal_view_draw_callback(Canvas* canvas, void* context) {
     xremote_canvas_draw_header(canvas, orientation, "Analyzer");
     elements_multiline_text_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
 
+    /* Continuous capture keeps receiving and lists every signal */
+    if(orientation == ViewOrientationHorizontal) {
+        xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+        elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Live");
+    } else {
+        xremote_canvas_draw_icon(canvas, 6, 117, XRemoteIconEnter);
+        canvas_draw_str_aligned(canvas, 12, 113, AlignLeft, AlignTop, "Live");
+    }
+
     const char* exit_str = xremote_app_context_get_exit_str(app_ctx);
     xremote_canvas_draw_exit_footer(canvas, orientation, exit_str);
 }
@@ -70,12 +79,20 @@ static void xremote_signal_success_view_draw_callback(Canvas* canvas, void* cont
             canvas, model->ok_pressed, 68, 26, "Send", XRemoteIconEnter);
         xremote_canvas_draw_button_wide(
             canvas, model->back_pressed, 68, 44, "Retry", XRemoteIconBack);
+        xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconArrowRight);
+        elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Save");
+        xremote_canvas_draw_icon(canvas, 36, 60, XRemoteIconArrowUp);
+        elements_multiline_text_aligned(canvas, 42, 64, AlignLeft, AlignBottom, "Wave");
     } else {
         elements_multiline_text_aligned(canvas, 0, 39, AlignLeft, AlignTop, signal_info);
         xremote_canvas_draw_button_wide(
             canvas, model->ok_pressed, 0, 88, "Send", XRemoteIconEnter);
         xremote_canvas_draw_button_wide(
             canvas, model->back_pressed, 0, 106, "Retry", XRemoteIconBack);
+        xremote_canvas_draw_icon(canvas, 6, 124, XRemoteIconArrowRight);
+        elements_multiline_text_aligned(canvas, 12, 128, AlignLeft, AlignBottom, "Save");
+        xremote_canvas_draw_icon(canvas, 6, 81, XRemoteIconArrowUp);
+        canvas_draw_str_aligned(canvas, 12, 77, AlignLeft, AlignTop, "Wave");
     }
 }
 
@@ -95,6 +112,10 @@ static void xremote_signal_success_view_process(XRemoteView* view, InputEvent* e
                     model->back_pressed = true;
                     xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalRetry);
                 }
+            } else if(event->type == InputTypeShort && event->key == InputKeyRight) {
+                xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalSave);
+            } else if(event->type == InputTypeShort && event->key == InputKeyUp) {
+                xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalWave);
             } else if(event->type == InputTypeRelease) {
                 if(event->key == InputKeyOk)
                     model->ok_pressed = false;
@@ -123,6 +144,8 @@ static void xremote_signal_view_process(XRemoteView* view, InputEvent* event) {
                     model->back_pressed = true;
                     xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalExit);
                 }
+            } else if(event->type == InputTypeShort && event->key == InputKeyOk) {
+                xremote_signal_analyzer_send_event(analyzer, XRemoteEventCaptureStart);
             } else if(event->type == InputTypeRelease) {
                 if(event->key == InputKeyOk)
                     model->ok_pressed = false;
@@ -0,0 +1,190 @@
+/*!
+ *  @file flipper-xremote/views/xremote_sweep_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Sweeper page view components and functionality.
+ */
+
+#include "xremote_sweep_view.h"
+#include "../xremote_sweep.h"
+
+static const char* xremote_sweep_view_get_action(XRemoteSweep* sweep) {
+    XRemoteSweepState state = xremote_sweep_get_state(sweep);
+    if(state == XRemoteSweepStateRunning) return "Pause";
+    if(state == XRemoteSweepStateDone) return "Restart";
+    return "Resume";
+}
+
+static float xremote_sweep_view_get_progress(XRemoteSweep* sweep) {
+    uint32_t total = xremote_sweep_get_total(sweep);
+    return total ? (float)xremote_sweep_get_position(sweep) / total : 0.0f;
+}
+
+static void xremote_sweep_view_draw_info(Canvas* canvas, XRemoteSweep* sweep, uint8_t y) {
+    const InfraredMessage* message = xremote_sweep_get_message(sweep);
+    const char* protocol = infrared_get_protocol_name(message->protocol);
+    char text[32];
+
+    snprintf(text, sizeof(text), "%s %s", protocol, xremote_sweep_get_rate_str(sweep));
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+
+    snprintf(text, sizeof(text), "A: 0x%lX", message->address);
+    canvas_draw_str_aligned(canvas, 0, y + 10, AlignLeft, AlignTop, text);
+
+    snprintf(text, sizeof(text), "C: 0x%lX", message->command);
+    canvas_draw_str_aligned(canvas, 0, y + 20, AlignLeft, AlignTop, text);
+
+    uint32_t position = xremote_sweep_get_position(sweep);
+    uint32_t total = xremote_sweep_get_total(sweep);
+    snprintf(text, sizeof(text), "%lu/%lu", position, total);
+    canvas_draw_str_aligned(canvas, 0, y + 30, AlignLeft, AlignTop, text);
+
+    const char* state = xremote_sweep_get_state_str(sweep);
+    snprintf(text, sizeof(text), "%s, hits: %lu", state, xremote_sweep_get_hits(sweep));
+    canvas_draw_str_aligned(canvas, 0, y + 40, AlignLeft, AlignTop, text);
+}
+
+static void xremote_sweep_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteSweep* sweep = model->context;
+    const char* action = xremote_sweep_view_get_action(sweep);
+
+    xremote_sweep_view_draw_info(canvas, sweep, 22);
+    elements_progress_bar(canvas, 0, 72, 64, xremote_sweep_view_get_progress(sweep));
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 83, action, XRemoteIconEnter);
+
+    if(xremote_sweep_get_state(sweep) == XRemoteSweepStatePaused) {
+        xremote_canvas_draw_button(canvas, model->left_pressed, 0, 100, XRemoteIconArrowLeft);
+        xremote_canvas_draw_button(canvas, model->up_pressed, 23, 100, XRemoteIconArrowUp);
+        xremote_canvas_draw_button(canvas, model->right_pressed, 46, 100, XRemoteIconArrowRight);
+    }
+}
+
+static void xremote_sweep_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteSweep* sweep = model->context;
+    const char* action = xremote_sweep_view_get_action(sweep);
+
+    xremote_sweep_view_draw_info(canvas, sweep, 0);
+
+    if(xremote_sweep_get_state(sweep) == XRemoteSweepStatePaused) {
+        xremote_canvas_draw_button(canvas, model->left_pressed, 70, 24, XRemoteIconArrowLeft);
+        xremote_canvas_draw_button(canvas, model->up_pressed, 90, 24, XRemoteIconArrowUp);
+        xremote_canvas_draw_button(canvas, model->right_pressed, 110, 24, XRemoteIconArrowRight);
+        elements_multiline_text_aligned(canvas, 128, 54, AlignRight, AlignBottom, "Down: Save");
+    }
+
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, action);
+}
+
+static void xremote_sweep_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteSweep* sweep = model->context;
+    XRemoteAppContext* app_ctx = xremote_sweep_get_app_context(sweep);
+    XRemoteViewDrawFunction xremote_sweep_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_sweep_view_draw_body = orientation == ViewOrientationVertical ?
+                                       xremote_sweep_view_draw_vertical :
+                                       xremote_sweep_view_draw_horizontal;
+
+    xremote_canvas_draw_header(canvas, orientation, "Sweeper");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_sweep_view_draw_body(canvas, model);
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to stop");
+}
+
+static void xremote_sweep_view_process(XRemoteSweep* sweep, InputEvent* event) {
+    XRemoteSweepState state = xremote_sweep_get_state(sweep);
+    bool is_step = event->type == InputTypeShort || event->type == InputTypeRepeat;
+
+    if(state == XRemoteSweepStateRunning) {
+        /* Stop right away, the code on the screen is the one which just went out */
+        bool any_key = xremote_sweep_is_pause_on_key(sweep) && event->type == InputTypePress;
+        if(any_key || (event->key == InputKeyOk && event->type == InputTypeShort))
+            xremote_sweep_pause(sweep);
+    } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+        xremote_sweep_resume(sweep);
+    } else if(state == XRemoteSweepStatePaused && is_step) {
+        if(event->key == InputKeyLeft)
+            xremote_sweep_step(sweep, false);
+        else if(event->key == InputKeyRight)
+            xremote_sweep_step(sweep, true);
+        else if(event->key == InputKeyUp)
+            xremote_sweep_resend(sweep);
+        else if(event->key == InputKeyDown && event->type == InputTypeShort)
+            xremote_sweep_save_hit(sweep);
+    }
+}
+
+static bool xremote_sweep_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteSweep* sweep = xremote_view_get_context(view);
+
+    /* Back keeps the checkpoint and returns to the sweep setup */
+    if(event->key == InputKeyBack) {
+        xremote_sweep_pause(sweep);
+        return false;
+    }
+
+    /* Key press which paused the sweep is not used as a command until it is released */
+    bool ignored = false;
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            ignored = model->ignore_key == event->key;
+            if(ignored && event->type == InputTypeRelease) model->ignore_key = InputKeyMAX;
+        },
+        false);
+
+    bool running = xremote_sweep_get_state(sweep) == XRemoteSweepStateRunning;
+    if(!ignored) xremote_sweep_view_process(sweep, event);
+    bool paused = running && xremote_sweep_get_state(sweep) != XRemoteSweepStateRunning;
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = sweep;
+            bool pressed = event->type == InputTypePress && !paused;
+            if(paused && event->type == InputTypePress) model->ignore_key = event->key;
+
+            if(event->type == InputTypePress || event->type == InputTypeRelease) {
+                if(event->key == InputKeyOk)
+                    model->ok_pressed = pressed;
+                else if(event->key == InputKeyUp)
+                    model->up_pressed = pressed;
+                else if(event->key == InputKeyLeft)
+                    model->left_pressed = pressed;
+                else if(event->key == InputKeyRight)
+                    model->right_pressed = pressed;
+            }
+        },
+        true);
+
+    return true;
+}
+
+XRemoteView* xremote_sweep_view_alloc(void* app_ctx, void* sweep) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_sweep_view_input_callback, xremote_sweep_view_draw_callback);
+    xremote_view_set_context(view, sweep, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = sweep;
+            model->ok_pressed = false;
+            model->up_pressed = false;
+            model->left_pressed = false;
+            model->right_pressed = false;
+            model->ignore_key = InputKeyMAX;
+        },
+        true);
+
+    return view;
+}
@@ -0,0 +1,162 @@
+/*!
+ *  @file flipper-xremote/views/xremote_translate_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Translator page view components and functionality.
+ */
+
+#include "xremote_translate_view.h"
+#include "../xremote_translate.h"
+
+static void
+    xremote_translate_view_draw_last(Canvas* canvas, XRemoteTranslate* translate, uint8_t y) {
+    XRemoteTranslateLast last;
+    char text[32];
+
+    if(!xremote_translate_get_last(translate, &last)) {
+        canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, "Waiting...");
+        return;
+    }
+
+    if(last.is_raw) {
+        snprintf(text, sizeof(text), "In: RAW %u", last.timings_size);
+    } else {
+        const InfraredMessage* message = &last.message;
+        snprintf(
+            text,
+            sizeof(text),
+            "In: %s %lX:%lX",
+            infrared_get_protocol_name(message->protocol),
+            message->address,
+            message->command);
+    }
+
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+    snprintf(text, sizeof(text), "Out: %.16s", last.target ? last.target : "none");
+    canvas_draw_str_aligned(canvas, 0, y + 10, AlignLeft, AlignTop, text);
+}
+
+static void xremote_translate_view_draw_latency(
+    Canvas* canvas,
+    XRemoteAppContext* app_ctx,
+    uint8_t y) {
+#if XREMOTE_DIAG_LATENCY
+    /* Capture delivery to the start of transmit, the part this device adds */
+    XRemoteLatencyStats stats;
+    xremote_diag_latency_stats(app_ctx->diag, XRemoteLatencyTxStart, &stats);
+    if(!stats.count) return;
+
+    char avg[8], p95[8], text[32];
+    xremote_diag_format_latency(avg, sizeof(avg), stats.avg_us);
+    xremote_diag_format_latency(p95, sizeof(p95), stats.p95_us);
+
+    snprintf(text, sizeof(text), "Tx: %s/%s ms", avg, p95);
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+#else
+    UNUSED(canvas);
+    UNUSED(app_ctx);
+    UNUSED(y);
+#endif
+}
+
+static void
+    xremote_translate_view_draw_info(Canvas* canvas, XRemoteTranslate* translate, uint8_t y) {
+    XRemoteAppContext* app_ctx = xremote_translate_get_app_context(translate);
+    size_t mappings = xremote_translate_get_mappings(translate);
+    char text[32];
+
+    if(!mappings) {
+        canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, "No mappings,");
+        canvas_draw_str_aligned(canvas, 0, y + 10, AlignLeft, AlignTop, "edit the file");
+        canvas_draw_str_aligned(canvas, 0, y + 20, AlignLeft, AlignTop, "translate.txt");
+        return;
+    }
+
+    const char* state = xremote_translate_is_running(translate) ? "On" : "Off";
+    snprintf(text, sizeof(text), "Maps: %u %s", mappings, state);
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, text);
+
+    /* Short lines first, they stay clear of the horizontal header */
+    xremote_translate_view_draw_latency(canvas, app_ctx, y + 10);
+    xremote_translate_view_draw_last(canvas, translate, y + 20);
+
+    uint32_t sent = xremote_translate_get_sent(translate);
+    uint32_t missed = xremote_translate_get_missed(translate);
+    snprintf(text, sizeof(text), "Sent: %lu Miss: %lu", sent, missed);
+    canvas_draw_str_aligned(canvas, 0, y + 40, AlignLeft, AlignTop, text);
+}
+
+static void xremote_translate_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteTranslate* translate = model->context;
+    xremote_translate_view_draw_info(canvas, translate, 22);
+
+    if(!xremote_translate_get_mappings(translate)) return;
+    const char* action = xremote_translate_is_running(translate) ? "Pause" : "Resume";
+
+    xremote_canvas_draw_icon(canvas, 6, 117, XRemoteIconEnter);
+    canvas_draw_str_aligned(canvas, 12, 113, AlignLeft, AlignTop, action);
+}
+
+static void xremote_translate_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteTranslate* translate = model->context;
+    xremote_translate_view_draw_info(canvas, translate, 0);
+
+    if(!xremote_translate_get_mappings(translate)) return;
+    const char* action = xremote_translate_is_running(translate) ? "Pause" : "Resume";
+
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, action);
+}
+
+static void xremote_translate_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteTranslate* translate = model->context;
+    XRemoteAppContext* app_ctx = xremote_translate_get_app_context(translate);
+    XRemoteViewDrawFunction xremote_translate_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_translate_view_draw_body = orientation == ViewOrientationVertical ?
+                                           xremote_translate_view_draw_vertical :
+                                           xremote_translate_view_draw_horizontal;
+
+    xremote_canvas_draw_header(canvas, orientation, "Translator");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_translate_view_draw_body(canvas, model);
+
+    const char* exit_str = xremote_app_context_get_exit_str(app_ctx);
+    xremote_canvas_draw_exit_footer(canvas, orientation, exit_str);
+}
+
+static bool xremote_translate_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteTranslate* translate = xremote_view_get_context(view);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+    XRemoteAppExit exit = app_ctx->app_settings->exit_behavior;
+
+    if(event->key == InputKeyBack) {
+        if((event->type == InputTypeShort && exit == XRemoteAppExitPress) ||
+           (event->type == InputTypeLong && exit == XRemoteAppExitHold))
+            xremote_translate_send_event(translate, XRemoteEventSignalExit);
+    } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+        xremote_translate_toggle(translate);
+    }
+
+    return true;
+}
+
+XRemoteView* xremote_translate_view_alloc(void* app_ctx, void* translate) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_translate_view_input_callback, xremote_translate_view_draw_callback);
+    xremote_view_set_context(view, translate, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = translate; },
+        true);
+
+    return view;
+}
@@ -0,0 +1,180 @@
+/*!
+ *  @file flipper-xremote/views/xremote_universal_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Universal library brute-force page view components and functionality.
+ */
+
+#include "xremote_universal_view.h"
+#include "../xremote_universal.h"
+
+static const char* xremote_universal_view_get_action(XRemoteUniversal* universal) {
+    XRemoteUniversalState state = xremote_universal_get_state(universal);
+    if(state == XRemoteUniversalStateRunning) return "Pause";
+    if(state == XRemoteUniversalStatePaused) return "Resume";
+    if(state == XRemoteUniversalStateDone) return "Restart";
+    return "Start";
+}
+
+static void
+    xremote_universal_view_draw_info(Canvas* canvas, XRemoteUniversal* universal, uint8_t y) {
+    const char* name = xremote_universal_get_name(universal);
+    char text[32];
+
+    canvas_draw_str_aligned(canvas, 0, y, AlignLeft, AlignTop, name);
+    const char* command = xremote_universal_get_command_name(universal);
+    snprintf(text, sizeof(text), "Button: %s", command);
+    canvas_draw_str_aligned(canvas, 0, y + 10, AlignLeft, AlignTop, text);
+
+    uint32_t position = xremote_universal_get_position(universal);
+    uint32_t count = xremote_universal_get_count(universal);
+    snprintf(text, sizeof(text), "Code: %lu/%lu", position, count);
+    canvas_draw_str_aligned(canvas, 0, y + 20, AlignLeft, AlignTop, text);
+
+    const char* state = xremote_universal_get_state_str(universal);
+    uint32_t skipped = xremote_universal_get_skipped(universal);
+    snprintf(text, sizeof(text), "%s, skip: %lu", state, skipped);
+    canvas_draw_str_aligned(canvas, 0, y + 30, AlignLeft, AlignTop, text);
+}
+
+static void xremote_universal_view_draw_arrows(
+    Canvas* canvas,
+    XRemoteViewModel* model,
+    uint8_t x,
+    uint8_t y,
+    uint8_t step) {
+    XRemoteUniversal* universal = model->context;
+    XRemoteUniversalState state = xremote_universal_get_state(universal);
+    if(state == XRemoteUniversalStateRunning) return;
+
+    /* Arrows select the button before start and walk through the codes after */
+    xremote_canvas_draw_button(canvas, model->left_pressed, x, y, XRemoteIconArrowLeft);
+    if(state != XRemoteUniversalStateIdle)
+        xremote_canvas_draw_button(canvas, model->up_pressed, x + step, y, XRemoteIconArrowUp);
+    xremote_canvas_draw_button(
+        canvas, model->right_pressed, x + step * 2, y, XRemoteIconArrowRight);
+}
+
+static void xremote_universal_view_draw_vertical(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteUniversal* universal = model->context;
+    const char* action = xremote_universal_view_get_action(universal);
+
+    xremote_universal_view_draw_info(canvas, universal, 22);
+    elements_progress_bar(canvas, 0, 62, 64, xremote_universal_get_progress(universal));
+    xremote_canvas_draw_button_wide(canvas, model->ok_pressed, 0, 76, action, XRemoteIconEnter);
+    xremote_universal_view_draw_arrows(canvas, model, 0, 96, 23);
+}
+
+static void xremote_universal_view_draw_horizontal(Canvas* canvas, XRemoteViewModel* model) {
+    XRemoteUniversal* universal = model->context;
+    const char* action = xremote_universal_view_get_action(universal);
+
+    xremote_universal_view_draw_info(canvas, universal, 0);
+    elements_progress_bar(canvas, 0, 42, 64, xremote_universal_get_progress(universal));
+    xremote_universal_view_draw_arrows(canvas, model, 70, 24, 20);
+
+    xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconEnter);
+    elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, action);
+}
+
+static void xremote_universal_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteUniversal* universal = model->context;
+    XRemoteAppContext* app_ctx = xremote_universal_get_app_context(universal);
+    XRemoteViewDrawFunction xremote_universal_view_draw_body;
+
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+    xremote_universal_view_draw_body = orientation == ViewOrientationVertical ?
+                                           xremote_universal_view_draw_vertical :
+                                           xremote_universal_view_draw_horizontal;
+
+    xremote_canvas_draw_header(canvas, orientation, "Universal");
+    canvas_set_font(canvas, FontSecondary);
+    xremote_universal_view_draw_body(canvas, model);
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
+}
+
+static void xremote_universal_view_process(XRemoteUniversal* universal, InputEvent* event) {
+    XRemoteUniversalState state = xremote_universal_get_state(universal);
+    bool is_step = event->type == InputTypeShort || event->type == InputTypeRepeat;
+
+    if(state == XRemoteUniversalStateRunning) {
+        /* Any key stops right away, the device has just reacted to one of the last codes */
+        if(event->type == InputTypePress) xremote_universal_pause(universal);
+    } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+        xremote_universal_start(universal);
+    } else if(state == XRemoteUniversalStateIdle && is_step) {
+        if(event->key == InputKeyLeft)
+            xremote_universal_next_command(universal, false);
+        else if(event->key == InputKeyRight)
+            xremote_universal_next_command(universal, true);
+    } else if(is_step) {
+        if(event->key == InputKeyLeft)
+            xremote_universal_step(universal, false);
+        else if(event->key == InputKeyRight)
+            xremote_universal_step(universal, true);
+        else if(event->key == InputKeyUp)
+            xremote_universal_resend(universal);
+        else if(event->key == InputKeyDown && event->type == InputTypeShort)
+            xremote_universal_reset(universal);
+    }
+}
+
+static bool xremote_universal_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteUniversal* universal = xremote_view_get_context(view);
+
+    if(event->key == InputKeyBack) {
+        xremote_universal_pause(universal);
+        return false;
+    }
+
+    /* Key press which paused the sending is not used as a command */
+    bool running = xremote_universal_get_state(universal) == XRemoteUniversalStateRunning;
+    xremote_universal_view_process(universal, event);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = universal;
+            bool pressed = event->type == InputTypePress && !running;
+
+            if(event->type == InputTypePress || event->type == InputTypeRelease) {
+                if(event->key == InputKeyOk)
+                    model->ok_pressed = pressed;
+                else if(event->key == InputKeyUp)
+                    model->up_pressed = pressed;
+                else if(event->key == InputKeyLeft)
+                    model->left_pressed = pressed;
+                else if(event->key == InputKeyRight)
+                    model->right_pressed = pressed;
+            }
+        },
+        true);
+
+    return true;
+}
+
+XRemoteView* xremote_universal_view_alloc(void* app_ctx, void* universal) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_universal_view_input_callback, xremote_universal_view_draw_callback);
+    xremote_view_set_context(view, universal, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        {
+            model->context = universal;
+            model->ok_pressed = false;
+            model->up_pressed = false;
+            model->left_pressed = false;
+            model->right_pressed = false;
+        },
+        true);
+
+    return view;
+}
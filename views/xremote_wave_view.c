@@ -0,0 +1,136 @@
+/*!
+ *  @file flipper-xremote/views/xremote_wave_view.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Waveform page view components and functionality.
+ */
+
+#include "xremote_wave_view.h"
+#include "../xremote_analyzer.h"
+
+/* Height of the pulse train, high level is drawn at the top */
+#define XREMOTE_WAVE_VIEW_HEIGHT 16
+
+static size_t xremote_wave_view_get_width(XRemoteAppContext* app_ctx) {
+    return app_ctx->app_settings->orientation == ViewOrientationVertical ? 64 : 128;
+}
+
+void xremote_wave_view_reset(XRemoteView* view) {
+    XRemoteSignalAnalyzer* analyzer = xremote_view_get_context(view);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+    XRemoteWave* wave = xremote_signal_analyzer_get_wave(analyzer);
+    xremote_wave_fit(wave, xremote_wave_view_get_width(app_ctx));
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+}
+
+static void xremote_wave_view_draw_train(Canvas* canvas, XRemoteWave* wave, uint8_t y) {
+    size_t width = canvas_width(canvas);
+    uint8_t low = y + XREMOTE_WAVE_VIEW_HEIGHT;
+    uint8_t prev = 0;
+
+    /* One summary column per pixel, the cost does not depend on the signal length */
+    for(size_t x = 0; x < width; x++) {
+        uint8_t column = xremote_wave_get_column(wave, x);
+        if(!column) break;
+
+        bool edge = column == (XREMOTE_WAVE_LOW | XREMOTE_WAVE_HIGH) ||
+                    (prev && prev != column);
+
+        if(edge) canvas_draw_line(canvas, x, y, x, low);
+        if(column & XREMOTE_WAVE_HIGH) canvas_draw_dot(canvas, x, y);
+        if(column & XREMOTE_WAVE_LOW) canvas_draw_dot(canvas, x, low);
+        prev = column;
+    }
+}
+
+static void xremote_wave_view_format_scale(XRemoteWave* wave, char* text, size_t length) {
+    uint32_t column_us = xremote_wave_get_column_us(wave);
+    uint32_t start_ms = wave->offset * column_us / 1000;
+
+    snprintf(text, length, "%luus/px @%lums", column_us, start_ms);
+}
+
+static void xremote_wave_view_draw_callback(Canvas* canvas, void* context) {
+    furi_assert(context);
+    XRemoteViewModel* model = context;
+    XRemoteSignalAnalyzer* analyzer = model->context;
+
+    XRemoteAppContext* app_ctx = xremote_signal_analyzer_get_app_context(analyzer);
+    XRemoteWave* wave = xremote_signal_analyzer_get_wave(analyzer);
+    ViewOrientation orientation = app_ctx->app_settings->orientation;
+
+    xremote_canvas_draw_header(canvas, orientation, "Wave");
+    char info[64];
+    char scale[32];
+
+    xremote_wave_view_format_scale(wave, scale, sizeof(scale));
+    snprintf(info, sizeof(info), "T-Size: %u\n%lums", wave->timings_size, wave->total_us / 1000);
+
+    if(orientation == ViewOrientationHorizontal) {
+        elements_multiline_text_aligned(canvas, 0, 0, AlignLeft, AlignTop, info);
+        xremote_wave_view_draw_train(canvas, wave, 26);
+        canvas_draw_str_aligned(canvas, 0, 46, AlignLeft, AlignTop, scale);
+        xremote_canvas_draw_icon(canvas, 6, 60, XRemoteIconArrowUp);
+        elements_multiline_text_aligned(canvas, 12, 64, AlignLeft, AlignBottom, "Zoom");
+    } else {
+        elements_multiline_text_aligned(canvas, 0, 22, AlignLeft, AlignTop, info);
+        xremote_wave_view_draw_train(canvas, wave, 52);
+        canvas_draw_str_aligned(canvas, 0, 74, AlignLeft, AlignTop, scale);
+        xremote_canvas_draw_icon(canvas, 6, 117, XRemoteIconArrowUp);
+        canvas_draw_str_aligned(canvas, 12, 113, AlignLeft, AlignTop, "Zoom");
+    }
+
+    xremote_canvas_draw_exit_footer(canvas, orientation, "Press to exit");
+}
+
+static bool xremote_wave_view_input_callback(InputEvent* event, void* context) {
+    furi_assert(context);
+    XRemoteView* view = (XRemoteView*)context;
+    XRemoteSignalAnalyzer* analyzer = xremote_view_get_context(view);
+    XRemoteAppContext* app_ctx = xremote_view_get_app_context(view);
+
+    XRemoteWave* wave = xremote_signal_analyzer_get_wave(analyzer);
+    size_t width = xremote_wave_view_get_width(app_ctx);
+    bool is_step = event->type == InputTypeShort || event->type == InputTypeRepeat;
+
+    /* Back is left to the view dispatcher which returns to the signal page */
+    if(event->key == InputKeyBack) return false;
+    if(!is_step) return true;
+
+    if(event->key == InputKeyLeft)
+        xremote_wave_scroll(wave, -(int)(width / 4), width);
+    else if(event->key == InputKeyRight)
+        xremote_wave_scroll(wave, width / 4, width);
+    else if(event->key == InputKeyUp)
+        xremote_wave_zoom(wave, -1, width);
+    else if(event->key == InputKeyDown)
+        xremote_wave_zoom(wave, 1, width);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+
+    return true;
+}
+
+XRemoteView* xremote_wave_view_alloc(void* app_ctx, void* analyzer) {
+    XRemoteView* view = xremote_view_alloc(
+        app_ctx, xremote_wave_view_input_callback, xremote_wave_view_draw_callback);
+    xremote_view_set_context(view, analyzer, NULL);
+
+    with_view_model(
+        xremote_view_get_view(view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+
+    return view;
+}
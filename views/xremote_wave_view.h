@@ -0,0 +1,14 @@
+/*!
+ *  @file flipper-xremote/views/xremote_wave_view.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Waveform page view components and functionality.
+ */
+
+#pragma once
+
+#include "xremote_common_view.h"
+
+XRemoteView* xremote_wave_view_alloc(void* app_ctx, void* analyzer);
+void xremote_wave_view_reset(XRemoteView* view);
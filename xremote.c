@@ -8,11 +8,19 @@
 
 #include "xremote.h"
 #include "xremote_learn.h"
+#include "xremote_free_learn.h"
 #include "xremote_control.h"
 #include "xremote_settings.h"
 #include "xremote_analyzer.h"
+#include "xremote_macro.h"
+#include "xremote_broadcast.h"
+#include "xremote_sweep.h"
+#include "xremote_universal.h"
+#include "xremote_ac.h"
+#include "xremote_translate.h"
 
 #include "views/xremote_about_view.h"
+#include "views/xremote_diag_view.h"
 
 #include <toolbox/saved_struct.h>
 
@@ -33,6 +41,11 @@ static uint32_t xremote_view_exit_callback(void* context) {
     return XRemoteViewSubmenu;
 }
 
+static uint32_t xremote_diag_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewAbout;
+}
+
 static uint32_t xremote_exit_callback(void* context) {
     UNUSED(context);
     return VIEW_NONE;
@@ -47,6 +60,13 @@ static XRemoteApp* xremote_about_alloc(XRemoteAppContext* app_ctx) {
     XRemoteApp* app = xremote_app_alloc(app_ctx);
     xremote_app_view_alloc(app, XRemoteViewAbout, xremote_about_view_alloc);
     xremote_app_view_set_previous_callback(app, xremote_view_exit_callback);
+
+    /* Diagnostics page is reachable from the about page */
+    XRemoteApp* diag = xremote_app_alloc(app_ctx);
+    xremote_app_view_alloc(diag, XRemoteViewDiagnostics, xremote_diag_view_alloc);
+    xremote_app_view_set_previous_callback(diag, xremote_diag_exit_callback);
+    xremote_app_set_user_context(app, diag, xremote_child_clear_callback);
+
     return app;
 }
 
@@ -61,10 +81,24 @@ void xremote_submenu_callback(void* context, uint32_t index) {
     /* Allocate child app and view based on submenu selection */
     if(index == XRemoteViewLearn)
         child = xremote_learn_alloc(app->app_ctx);
+    else if(index == XRemoteViewFreeLearn)
+        child = xremote_free_learn_alloc(app->app_ctx);
     else if(index == XRemoteViewIRSubmenu)
         child = xremote_control_alloc(app->app_ctx);
     else if(index == XRemoteViewAnalyzer)
         child = xremote_analyzer_alloc(app->app_ctx);
+    else if(index == XRemoteViewMacro)
+        child = xremote_macro_alloc(app->app_ctx);
+    else if(index == XRemoteViewBroadcast)
+        child = xremote_broadcast_alloc(app->app_ctx);
+    else if(index == XRemoteViewSweep)
+        child = xremote_sweep_alloc(app->app_ctx);
+    else if(index == XRemoteViewUniversal)
+        child = xremote_universal_alloc(app->app_ctx);
+    else if(index == XRemoteViewAC)
+        child = xremote_ac_alloc(app->app_ctx);
+    else if(index == XRemoteViewTranslate)
+        child = xremote_translate_alloc(app->app_ctx);
     else if(index == XRemoteViewSettings)
         child = xremote_settings_alloc(app->app_ctx);
     else if(index == XRemoteViewAbout)
@@ -127,8 +161,15 @@ int32_t xremote_main(void* p) {
     /* Allocate and build the menu */
     xremote_app_submenu_alloc(app, XRemoteViewSubmenu, xremote_exit_callback);
     xremote_app_submenu_add(app, "Learn", XRemoteViewLearn, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Free Learn", XRemoteViewFreeLearn, xremote_submenu_callback);
     xremote_app_submenu_add(app, "Saved", XRemoteViewIRSubmenu, xremote_submenu_callback);
     xremote_app_submenu_add(app, "Analyzer", XRemoteViewAnalyzer, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Macros", XRemoteViewMacro, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Broadcast", XRemoteViewBroadcast, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Sweeper", XRemoteViewSweep, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Universal", XRemoteViewUniversal, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Air Conditioner", XRemoteViewAC, xremote_submenu_callback);
+    xremote_app_submenu_add(app, "Translator", XRemoteViewTranslate, xremote_submenu_callback);
     xremote_app_submenu_add(app, "Settings", XRemoteViewSettings, xremote_submenu_callback);
     xremote_app_submenu_add(app, "About", XRemoteViewAbout, xremote_submenu_callback);
 
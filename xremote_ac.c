@@ -0,0 +1,360 @@
+/*!
+ *  @file flipper-xremote/xremote_ac.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Air conditioner remote synthesizing frames from a parametric template.
+ */
+
+#include "xremote_ac.h"
+#include "views/xremote_ac_view.h"
+
+#include <toolbox/path.h>
+
+#define TAG "XRemoteAC"
+
+typedef enum {
+    XRemoteACChecksumNone,
+    XRemoteACChecksumSum,
+    XRemoteACChecksumXor
+} XRemoteACChecksum;
+
+/* Bit position in the frame and width, zero width disables the field */
+typedef struct {
+    uint32_t pos;
+    uint32_t bits;
+} XRemoteACField;
+
+static const char* g_ac_modes[XRemoteACModeMax] = {"Auto", "Cool", "Dry", "Fan", "Heat"};
+static const char* g_ac_fans[XRemoteACFanMax] = {"Auto", "Low", "Mid", "High"};
+
+struct XRemoteAC {
+    /* Frame and timings are synthesized in place on every send */
+    uint32_t timings[XREMOTE_AC_TIMINGS_MAX];
+    uint8_t frame[XREMOTE_AC_FRAME_MAX];
+    uint8_t base[XREMOTE_AC_FRAME_MAX];
+    uint32_t frame_size;
+    size_t timings_size;
+
+    uint32_t frequency;
+    float duty_cycle;
+    uint32_t header[2];
+    uint32_t bit[3];
+    uint32_t trailer[2];
+    bool lsb_first;
+
+    XRemoteACField power;
+    XRemoteACField mode;
+    XRemoteACField temp;
+    XRemoteACField fan;
+
+    uint32_t mode_values[XRemoteACModeMax];
+    uint32_t fan_values[XRemoteACFanMax];
+    uint32_t temp_range[3];
+
+    XRemoteACChecksum checksum;
+    uint32_t checksum_range[3];
+
+    XRemoteAppContext* app_ctx;
+    InfraredSignal* signal;
+    FuriString* name;
+
+    XRemoteACMode state_mode;
+    XRemoteACFan state_fan;
+    uint32_t state_temp;
+    bool state_power;
+};
+
+XRemoteAppContext* xremote_ac_get_app_context(XRemoteAC* ac) {
+    xremote_app_assert(ac, NULL);
+    return ac->app_ctx;
+}
+
+const char* xremote_ac_get_name(XRemoteAC* ac) {
+    xremote_app_assert(ac, "");
+    return furi_string_get_cstr(ac->name);
+}
+
+const char* xremote_ac_get_mode_str(XRemoteAC* ac) {
+    xremote_app_assert(ac, "");
+    return g_ac_modes[ac->state_mode];
+}
+
+const char* xremote_ac_get_fan_str(XRemoteAC* ac) {
+    xremote_app_assert(ac, "");
+    return g_ac_fans[ac->state_fan];
+}
+
+uint32_t xremote_ac_get_temp(XRemoteAC* ac) {
+    xremote_app_assert(ac, 0);
+    return ac->state_temp;
+}
+
+bool xremote_ac_is_power_on(XRemoteAC* ac) {
+    xremote_app_assert(ac, false);
+    return ac->state_power;
+}
+
+static void xremote_ac_set_field(XRemoteAC* ac, XRemoteACField* field, uint32_t value) {
+    for(uint32_t i = 0; i < field->bits; i++) {
+        uint32_t bit = field->pos + i;
+        uint8_t mask = 1 << (bit % 8);
+
+        if(value & (1UL << i))
+            ac->frame[bit / 8] |= mask;
+        else
+            ac->frame[bit / 8] &= ~mask;
+    }
+}
+
+static void xremote_ac_set_checksum(XRemoteAC* ac) {
+    if(ac->checksum == XRemoteACChecksumNone) return;
+    uint8_t checksum = 0;
+
+    for(uint32_t i = ac->checksum_range[0]; i <= ac->checksum_range[1]; i++) {
+        if(ac->checksum == XRemoteACChecksumSum)
+            checksum += ac->frame[i];
+        else
+            checksum ^= ac->frame[i];
+    }
+
+    ac->frame[ac->checksum_range[2]] = checksum;
+}
+
+static void xremote_ac_synthesize(XRemoteAC* ac) {
+    memcpy(ac->frame, ac->base, ac->frame_size);
+
+    uint32_t temp = ac->state_temp - ac->temp_range[0] + ac->temp_range[2];
+    xremote_ac_set_field(ac, &ac->power, ac->state_power);
+    xremote_ac_set_field(ac, &ac->mode, ac->mode_values[ac->state_mode]);
+    xremote_ac_set_field(ac, &ac->fan, ac->fan_values[ac->state_fan]);
+    xremote_ac_set_field(ac, &ac->temp, temp);
+    xremote_ac_set_checksum(ac);
+
+    size_t size = 0;
+    ac->timings[size++] = ac->header[0];
+    ac->timings[size++] = ac->header[1];
+
+    for(uint32_t i = 0; i < ac->frame_size; i++) {
+        for(uint8_t j = 0; j < 8; j++) {
+            uint8_t bit = ac->lsb_first ? j : 7 - j;
+            bool one = (ac->frame[i] >> bit) & 1;
+            ac->timings[size++] = ac->bit[0];
+            ac->timings[size++] = one ? ac->bit[2] : ac->bit[1];
+        }
+    }
+
+    /* Trailing gap keeps the length even, so repeats are spaced by the raw sender */
+    ac->timings[size++] = ac->trailer[0];
+    ac->timings[size++] = ac->trailer[1];
+    ac->timings_size = size;
+}
+
+static bool xremote_ac_send(XRemoteAC* ac) {
+    XRemoteAppContext* app_ctx = ac->app_ctx;
+
+    /* Timings are reused, previous frame must be off the air before they change */
+    xremote_transmitter_flush(app_ctx->transmitter);
+
+    uint32_t start = xremote_diag_start();
+    xremote_ac_synthesize(ac);
+    xremote_diag_stop(app_ctx->diag, XRemoteDiagEncode, start);
+
+    infrared_signal_set_raw_signal_ref(
+        ac->signal, ac->timings, ac->timings_size, ac->frequency, ac->duty_cycle);
+
+    uint32_t repeat = app_ctx->app_settings->repeat_count;
+    return xremote_transmitter_send(app_ctx->transmitter, ac->signal, repeat);
+}
+
+bool xremote_ac_toggle_power(XRemoteAC* ac) {
+    xremote_app_assert(ac, false);
+    ac->state_power = !ac->state_power;
+    return xremote_ac_send(ac);
+}
+
+bool xremote_ac_next_mode(XRemoteAC* ac) {
+    xremote_app_assert(ac, false);
+    xremote_app_assert(ac->mode.bits, false);
+    ac->state_mode = (ac->state_mode + 1) % XRemoteACModeMax;
+    return xremote_ac_send(ac);
+}
+
+bool xremote_ac_next_fan(XRemoteAC* ac) {
+    xremote_app_assert(ac, false);
+    xremote_app_assert(ac->fan.bits, false);
+    ac->state_fan = (ac->state_fan + 1) % XRemoteACFanMax;
+    return xremote_ac_send(ac);
+}
+
+bool xremote_ac_change_temp(XRemoteAC* ac, int delta) {
+    xremote_app_assert(ac, false);
+    xremote_app_assert(ac->temp.bits, false);
+
+    int temp = (int)ac->state_temp + delta;
+    if(temp < (int)ac->temp_range[0] || temp > (int)ac->temp_range[1]) return false;
+
+    ac->state_temp = temp;
+    return xremote_ac_send(ac);
+}
+
+static bool xremote_ac_read_field(FlipperFormat* ff, const char* key, XRemoteACField* field) {
+    uint32_t values[2];
+    if(!flipper_format_read_uint32(ff, key, values, COUNT_OF(values))) return false;
+
+    field->pos = values[0];
+    field->bits = values[1];
+    return true;
+}
+
+static bool xremote_ac_is_field_valid(XRemoteAC* ac, XRemoteACField* field) {
+    /* Values come from the file, pos + bits could wrap around and pass the check */
+    size_t frame_bits = ac->frame_size * 8;
+    if(field->bits > 32 || field->pos > frame_bits) return false;
+    return field->bits <= frame_bits - field->pos;
+}
+
+static bool xremote_ac_validate(XRemoteAC* ac) {
+    if(!xremote_ac_is_field_valid(ac, &ac->power)) return false;
+    if(!xremote_ac_is_field_valid(ac, &ac->mode)) return false;
+    if(!xremote_ac_is_field_valid(ac, &ac->temp)) return false;
+    if(!xremote_ac_is_field_valid(ac, &ac->fan)) return false;
+    if(ac->temp_range[0] > ac->temp_range[1]) return false;
+
+    if(ac->checksum != XRemoteACChecksumNone) {
+        uint32_t* range = ac->checksum_range;
+        if(range[0] > range[1] || range[1] >= ac->frame_size) return false;
+        if(range[2] >= ac->frame_size) return false;
+    }
+
+    return true;
+}
+
+static bool xremote_ac_load(XRemoteAC* ac, FuriString* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* value = furi_string_alloc();
+
+    FURI_LOG_I(TAG, "load template file: \'%s\'", furi_string_get_cstr(path));
+    uint32_t lsb_first = 0;
+    uint32_t version = 0;
+    bool success = false;
+
+    do {
+        /* Open file and read the header */
+        if(!flipper_format_buffered_file_open_existing(ff, furi_string_get_cstr(path))) break;
+        if(!flipper_format_read_header(ff, value, &version)) break;
+        if(!furi_string_equal(value, XREMOTE_AC_FILETYPE)) break;
+        if(version != XREMOTE_AC_VERSION) break;
+
+        /* Carrier and pulse distance timings of one frame */
+        if(!flipper_format_read_uint32(ff, "frequency", &ac->frequency, 1)) break;
+        if(!flipper_format_read_float(ff, "duty_cycle", &ac->duty_cycle, 1)) break;
+        if(!flipper_format_read_uint32(ff, "header", ac->header, COUNT_OF(ac->header))) break;
+        if(!flipper_format_read_uint32(ff, "bit", ac->bit, COUNT_OF(ac->bit))) break;
+        if(!flipper_format_read_uint32(ff, "trailer", ac->trailer, COUNT_OF(ac->trailer))) break;
+        if(!flipper_format_read_uint32(ff, "lsb_first", &lsb_first, 1)) break;
+        ac->lsb_first = lsb_first;
+
+        /* Frame bytes with every state field cleared */
+        if(!flipper_format_get_value_count(ff, "base", &ac->frame_size)) break;
+        if(!ac->frame_size || ac->frame_size > XREMOTE_AC_FRAME_MAX) break;
+        if(!flipper_format_read_hex(ff, "base", ac->base, ac->frame_size)) break;
+
+        /* Bit layout of the state fields and their encoded values */
+        if(!xremote_ac_read_field(ff, "power", &ac->power)) break;
+        if(!xremote_ac_read_field(ff, "mode", &ac->mode)) break;
+        if(!flipper_format_read_uint32(ff, "mode_values", ac->mode_values, XRemoteACModeMax))
+            break;
+        if(!xremote_ac_read_field(ff, "temp", &ac->temp)) break;
+        if(!flipper_format_read_uint32(ff, "temp_range", ac->temp_range, 3)) break;
+        if(!xremote_ac_read_field(ff, "fan", &ac->fan)) break;
+        if(!flipper_format_read_uint32(ff, "fan_values", ac->fan_values, XRemoteACFanMax))
+            break;
+
+        /* Checksum of the byte range stored into the target byte */
+        if(!flipper_format_read_string(ff, "checksum", value)) break;
+        if(furi_string_equal(value, "sum"))
+            ac->checksum = XRemoteACChecksumSum;
+        else if(furi_string_equal(value, "xor"))
+            ac->checksum = XRemoteACChecksumXor;
+        else
+            ac->checksum = XRemoteACChecksumNone;
+
+        if(ac->checksum != XRemoteACChecksumNone &&
+           !flipper_format_read_uint32(ff, "checksum_range", ac->checksum_range, 3))
+            break;
+
+        success = xremote_ac_validate(ac);
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(ff);
+    furi_string_free(value);
+
+    return success;
+}
+
+static void xremote_ac_free(XRemoteAC* ac) {
+    xremote_app_assert_void(ac);
+
+    /* Queued frame references the synthesized timings */
+    xremote_transmitter_flush(ac->app_ctx->transmitter);
+    infrared_signal_free(ac->signal);
+
+    furi_string_free(ac->name);
+    free(ac);
+}
+
+static void xremote_ac_clear_callback(void* context) {
+    XRemoteAC* ac = context;
+    xremote_ac_free(ac);
+}
+
+static XRemoteAC* xremote_ac_alloc_from_path(XRemoteAppContext* app_ctx, FuriString* path) {
+    XRemoteAC* ac = malloc(sizeof(XRemoteAC));
+    ac->signal = infrared_signal_alloc();
+    ac->name = furi_string_alloc();
+    ac->app_ctx = app_ctx;
+
+    ac->checksum = XRemoteACChecksumNone;
+    ac->state_mode = XRemoteACModeCool;
+    ac->state_fan = XRemoteACFanAuto;
+    ac->state_power = false;
+    ac->frame_size = 0;
+
+    path_extract_filename(path, ac->name, true);
+
+    if(!xremote_ac_load(ac, path)) {
+        xremote_ac_free(ac);
+        return NULL;
+    }
+
+    /* Start from the middle of the range, the same as most remotes after reset */
+    ac->state_temp = (ac->temp_range[0] + ac->temp_range[1]) / 2;
+    return ac;
+}
+
+static uint32_t xremote_ac_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+XRemoteApp* xremote_ac_alloc(XRemoteAppContext* app_ctx) {
+    FuriString* path = NULL;
+    XRemoteAC* ac = NULL;
+
+    /* Show file selection dialog and load the template */
+    if(xremote_app_browser_select_file(&path, XREMOTE_AC_EXTENSION))
+        ac = xremote_ac_alloc_from_path(app_ctx, path);
+
+    if(path != NULL) furi_string_free(path);
+    xremote_app_assert(ac, NULL);
+
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+    xremote_app_view_alloc2(app, XRemoteViewAC, xremote_ac_view_alloc, ac);
+    xremote_app_view_set_previous_callback(app, xremote_ac_view_exit_callback);
+    xremote_app_set_user_context(app, ac, xremote_ac_clear_callback);
+
+    return app;
+}
@@ -0,0 +1,52 @@
+/*!
+ *  @file flipper-xremote/xremote_ac.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Air conditioner remote synthesizing frames from a parametric template.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+
+#define XREMOTE_AC_EXTENSION ".xra"
+#define XREMOTE_AC_FILETYPE  "XRemote AC Template"
+#define XREMOTE_AC_VERSION   1
+
+/* Header, mark and space for every bit, trailer mark and gap */
+#define XREMOTE_AC_FRAME_MAX   32
+#define XREMOTE_AC_TIMINGS_MAX (XREMOTE_AC_FRAME_MAX * 16 + 4)
+
+typedef enum {
+    XRemoteACModeAuto,
+    XRemoteACModeCool,
+    XRemoteACModeDry,
+    XRemoteACModeFan,
+    XRemoteACModeHeat,
+    XRemoteACModeMax
+} XRemoteACMode;
+
+typedef enum {
+    XRemoteACFanAuto,
+    XRemoteACFanLow,
+    XRemoteACFanMid,
+    XRemoteACFanHigh,
+    XRemoteACFanMax
+} XRemoteACFan;
+
+typedef struct XRemoteAC XRemoteAC;
+
+XRemoteAppContext* xremote_ac_get_app_context(XRemoteAC* ac);
+const char* xremote_ac_get_name(XRemoteAC* ac);
+const char* xremote_ac_get_mode_str(XRemoteAC* ac);
+const char* xremote_ac_get_fan_str(XRemoteAC* ac);
+uint32_t xremote_ac_get_temp(XRemoteAC* ac);
+bool xremote_ac_is_power_on(XRemoteAC* ac);
+
+bool xremote_ac_toggle_power(XRemoteAC* ac);
+bool xremote_ac_next_mode(XRemoteAC* ac);
+bool xremote_ac_next_fan(XRemoteAC* ac);
+bool xremote_ac_change_temp(XRemoteAC* ac, int delta);
+
+XRemoteApp* xremote_ac_alloc(XRemoteAppContext* app_ctx);
@@ -8,20 +8,136 @@
 
 #include "xremote_analyzer.h"
 #include "views/xremote_signal_view.h"
+#include "views/xremote_capture_view.h"
+#include "views/xremote_wave_view.h"
+#include "views/xremote_diff_view.h"
+
+#include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
+
+#define TAG "XRemoteAnalyzer"
 
 struct XRemoteSignalAnalyzer {
     XRemoteSignalReceiver* ir_receiver;
     XRemoteClearCallback on_clear;
     XRemoteAppContext* app_ctx;
-    InfraredSignal* ir_signal;
     XRemoteView* signal_view;
     void* context;
     bool pause;
+
+    /* Continuous capture keeps the receiver running and fills the ring */
+    XRemoteCaptureRing* ring;
+    XRemoteView* capture_view;
+    InfraredSignal* signal;
+    FuriTimer* timer;
+    uint32_t start_tick;
+    uint32_t drawn_total;
+    uint32_t selected_seq;
+    uint32_t saved;
+    bool follow;
+    bool continuous;
+
+    /* Level summary is built once per capture when the waveform is opened */
+    XRemoteView* wave_view;
+    XRemoteWave* wave;
+    bool wave_valid;
+
+    /* Everything received in the session is logged when enabled in settings */
+    XRemoteLog* log;
+
+    /* Selected capture is compared with the marked one from the same ring */
+    InfraredSignal* marked_signal;
+    XRemoteView* diff_view;
+    XRemoteDiff* diff;
+    uint32_t marked_seq;
+    bool has_mark;
 };
 
 InfraredSignal* xremote_signal_analyzer_get_ir_signal(XRemoteSignalAnalyzer* analyzer) {
     xremote_app_assert(analyzer, NULL);
-    return analyzer->ir_signal;
+    if(analyzer->continuous) return analyzer->signal;
+    return xremote_signal_receiver_get_signal(analyzer->ir_receiver);
+}
+
+XRemoteWave* xremote_signal_analyzer_get_wave(XRemoteSignalAnalyzer* analyzer) {
+    xremote_app_assert(analyzer, NULL);
+    return analyzer->wave;
+}
+
+XRemoteCaptureRing* xremote_signal_analyzer_get_capture_ring(XRemoteSignalAnalyzer* analyzer) {
+    xremote_app_assert(analyzer, NULL);
+    return analyzer->ring;
+}
+
+size_t xremote_signal_analyzer_get_selected(XRemoteSignalAnalyzer* analyzer) {
+    size_t count = xremote_capture_ring_get_count(analyzer->ring);
+    XRemoteCaptureEntry oldest;
+
+    if(!count) return 0;
+    if(analyzer->follow || !xremote_capture_ring_get(analyzer->ring, 0, &oldest)) return count - 1;
+
+    /* Selection is kept by sequence number, older entries may be gone already */
+    if(analyzer->selected_seq < oldest.seq) return 0;
+    return MIN(analyzer->selected_seq - oldest.seq, count - 1);
+}
+
+void xremote_signal_analyzer_move_selection(XRemoteSignalAnalyzer* analyzer, int step) {
+    xremote_app_assert_void((analyzer && analyzer->ring));
+    xremote_capture_ring_lock(analyzer->ring);
+
+    size_t count = xremote_capture_ring_get_count(analyzer->ring);
+    int index = (int)xremote_signal_analyzer_get_selected(analyzer) + step;
+    XRemoteCaptureEntry entry;
+
+    if(index < 0) index = 0;
+    if(count && index >= (int)count) index = count - 1;
+
+    /* Moving to the newest entry follows the new captures again */
+    if(xremote_capture_ring_get(analyzer->ring, index, &entry)) {
+        analyzer->follow = (size_t)index == count - 1;
+        analyzer->selected_seq = entry.seq;
+    }
+
+    xremote_capture_ring_unlock(analyzer->ring);
+}
+
+void xremote_signal_analyzer_mark_selected(XRemoteSignalAnalyzer* analyzer) {
+    xremote_app_assert_void((analyzer && analyzer->ring));
+    xremote_capture_ring_lock(analyzer->ring);
+
+    size_t index = xremote_signal_analyzer_get_selected(analyzer);
+    XRemoteCaptureEntry entry;
+
+    /* Marking the same capture again clears the mark */
+    if(xremote_capture_ring_get(analyzer->ring, index, &entry)) {
+        analyzer->has_mark = !(analyzer->has_mark && analyzer->marked_seq == entry.seq);
+        analyzer->marked_seq = entry.seq;
+    }
+
+    xremote_capture_ring_unlock(analyzer->ring);
+}
+
+bool xremote_signal_analyzer_get_marked(XRemoteSignalAnalyzer* analyzer, size_t* index) {
+    xremote_app_assert(analyzer, false);
+    xremote_app_assert(analyzer->has_mark, false);
+    XRemoteCaptureEntry oldest;
+
+    /* Marked capture may be already dropped from the ring */
+    if(!xremote_capture_ring_get(analyzer->ring, 0, &oldest)) return false;
+    if(analyzer->marked_seq < oldest.seq) return false;
+
+    *index = analyzer->marked_seq - oldest.seq;
+    return *index < xremote_capture_ring_get_count(analyzer->ring);
+}
+
+InfraredSignal* xremote_signal_analyzer_get_marked_signal(XRemoteSignalAnalyzer* analyzer) {
+    xremote_app_assert(analyzer, NULL);
+    return analyzer->marked_signal;
+}
+
+XRemoteDiff* xremote_signal_analyzer_get_diff(XRemoteSignalAnalyzer* analyzer) {
+    xremote_app_assert(analyzer, NULL);
+    return analyzer->diff;
 }
 
 XRemoteSignalReceiver* xremote_signal_analyzer_get_ir_receiver(XRemoteSignalAnalyzer* analyzer) {
@@ -64,31 +180,222 @@ static uint32_t xremote_signal_analyzer_view_exit_callback(void* context) {
     return XRemoteViewAnalyzer;
 }
 
+static uint32_t xremote_signal_analyzer_wave_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSignal;
+}
+
+static void xremote_signal_analyzer_wave_open(XRemoteSignalAnalyzer* analyzer) {
+    /* Summary memory is taken only when the waveform is actually used */
+    if(analyzer->wave == NULL) analyzer->wave = xremote_wave_alloc();
+
+    if(!analyzer->wave_valid) {
+        InfraredSignal* signal = xremote_signal_analyzer_get_ir_signal(analyzer);
+        analyzer->wave_valid = xremote_wave_build_signal(analyzer->wave, signal);
+        if(!analyzer->wave_valid) return;
+    }
+
+    xremote_wave_view_reset(analyzer->wave_view);
+    xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewWave);
+}
+
 static void xremote_signal_analyzer_signal_callback(void* context, InfraredSignal* signal) {
     XRemoteSignalAnalyzer* analyzer = context;
     xremote_app_assert_void(!analyzer->pause);
+    if(analyzer->log != NULL) xremote_log_push(analyzer->log, signal);
+
+    if(analyzer->continuous) {
+        /* Worker thread copies into the ring, the list is redrawn by the timer */
+        uint64_t ticks = furi_get_tick() - analyzer->start_tick;
+        uint32_t time_ms = ticks * 1000 / furi_kernel_get_tick_frequency();
+        xremote_capture_ring_push(analyzer->ring, signal, time_ms);
+        return;
+    }
+
     analyzer->pause = true;
 
-    infrared_signal_set_signal(analyzer->ir_signal, signal);
+    /* Capture stays in the receiver buffer until the next retry */
     xremote_signal_analyzer_send_event(analyzer, XRemoteEventSignalReceived);
 }
 
+static void xremote_signal_analyzer_timer_callback(void* context) {
+    XRemoteSignalAnalyzer* analyzer = context;
+
+    /* Redraw at most once per frame and only when something was captured */
+    uint32_t total = xremote_capture_ring_get_total(analyzer->ring);
+    if(total != analyzer->drawn_total)
+        xremote_signal_analyzer_send_event(analyzer, XRemoteEventCaptureUpdate);
+}
+
+static void xremote_signal_analyzer_capture_update(XRemoteSignalAnalyzer* analyzer) {
+    analyzer->drawn_total = xremote_capture_ring_get_total(analyzer->ring);
+
+    with_view_model(
+        xremote_view_get_view(analyzer->capture_view),
+        XRemoteViewModel * model,
+        { model->context = analyzer; },
+        true);
+}
+
+static void xremote_signal_analyzer_capture_resume(XRemoteSignalAnalyzer* analyzer) {
+    uint32_t period = furi_ms_to_ticks(XREMOTE_ANALYZER_FRAME_MS);
+    furi_timer_start(analyzer->timer, period ? period : 1);
+    xremote_signal_analyzer_rx_start(analyzer);
+
+    xremote_signal_analyzer_capture_update(analyzer);
+    xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewCapture);
+}
+
+static void xremote_signal_analyzer_capture_start(XRemoteSignalAnalyzer* analyzer) {
+    xremote_signal_analyzer_rx_stop(analyzer);
+
+    /* Ring memory is taken only when continuous capture is actually used */
+    if(analyzer->ring == NULL) analyzer->ring = xremote_capture_ring_alloc();
+    if(analyzer->signal == NULL) analyzer->signal = infrared_signal_alloc();
+
+    xremote_capture_ring_clear(analyzer->ring);
+    xremote_signal_receiver_set_continuous(analyzer->ir_receiver, true);
+
+    analyzer->start_tick = furi_get_tick();
+    analyzer->drawn_total = 0;
+    analyzer->selected_seq = 0;
+    analyzer->follow = true;
+    analyzer->continuous = true;
+    analyzer->has_mark = false;
+
+    xremote_signal_analyzer_capture_resume(analyzer);
+}
+
+static void xremote_signal_analyzer_capture_stop(XRemoteSignalAnalyzer* analyzer) {
+    if(!analyzer->continuous) return;
+    furi_timer_stop(analyzer->timer);
+    xremote_signal_receiver_set_continuous(analyzer->ir_receiver, false);
+    analyzer->continuous = false;
+}
+
+static void xremote_signal_analyzer_capture_inspect(XRemoteSignalAnalyzer* analyzer) {
+    /* Stopped receiver keeps the pool intact while the entry is inspected */
+    furi_timer_stop(analyzer->timer);
+    xremote_signal_analyzer_rx_stop(analyzer);
+
+    xremote_capture_ring_lock(analyzer->ring);
+    size_t index = xremote_signal_analyzer_get_selected(analyzer);
+    bool loaded = xremote_capture_ring_load(analyzer->ring, index, analyzer->signal);
+    xremote_capture_ring_unlock(analyzer->ring);
+    analyzer->wave_valid = false;
+
+    if(loaded)
+        xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewSignal);
+    else
+        xremote_signal_analyzer_capture_resume(analyzer);
+}
+
+static void xremote_signal_analyzer_capture_compare(XRemoteSignalAnalyzer* analyzer) {
+    if(!analyzer->has_mark) return;
+
+    /* Stopped receiver keeps the pool intact while both entries are referenced */
+    furi_timer_stop(analyzer->timer);
+    xremote_signal_analyzer_rx_stop(analyzer);
+
+    if(analyzer->marked_signal == NULL) analyzer->marked_signal = infrared_signal_alloc();
+    if(analyzer->diff == NULL) analyzer->diff = malloc(sizeof(XRemoteDiff));
+
+    xremote_capture_ring_lock(analyzer->ring);
+    size_t index = xremote_signal_analyzer_get_selected(analyzer);
+    size_t marked = 0;
+
+    bool loaded = xremote_signal_analyzer_get_marked(analyzer, &marked) &&
+                  xremote_capture_ring_load(analyzer->ring, marked, analyzer->marked_signal) &&
+                  xremote_capture_ring_load(analyzer->ring, index, analyzer->signal);
+
+    xremote_capture_ring_unlock(analyzer->ring);
+    analyzer->wave_valid = false;
+
+    if(loaded && xremote_diff_signals(analyzer->diff, analyzer->marked_signal, analyzer->signal)) {
+        xremote_diff_view_reset(analyzer->diff_view);
+        xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewDiff);
+        return;
+    }
+
+    xremote_signal_analyzer_capture_resume(analyzer);
+}
+
+static bool xremote_signal_analyzer_save(XRemoteSignalAnalyzer* analyzer) {
+    InfraredSignal* signal = xremote_signal_analyzer_get_ir_signal(analyzer);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    bool success = false;
+    char name[32];
+
+    if(infrared_signal_is_raw(signal)) {
+        snprintf(name, sizeof(name), "Raw_%02lu", ++analyzer->saved);
+    } else {
+        InfraredMessage* message = infrared_signal_get_message(signal);
+        const char* protocol_name = infrared_get_protocol_name(message->protocol);
+        snprintf(
+            name, sizeof(name), "%s_%lX_%lX", protocol_name, message->address, message->command);
+    }
+
+    do {
+        /* Captures are appended, the header is written only for a new file */
+        if(storage_file_exists(storage, XREMOTE_ANALYZER_CAPTURES)) {
+            if(!flipper_format_file_open_append(ff, XREMOTE_ANALYZER_CAPTURES)) break;
+        } else {
+            if(!flipper_format_file_open_always(ff, XREMOTE_ANALYZER_CAPTURES)) break;
+            if(!flipper_format_write_header_cstr(ff, "IR signals file", 1)) break;
+        }
+
+        success = infrared_signal_save(signal, ff, name);
+    } while(false);
+
+    FURI_LOG_I(TAG, "save capture \'%s\': %s", name, success ? "ok" : "failed");
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(ff);
+
+    return success;
+}
+
 static bool xremote_signal_analyzer_custom_event_callback(void* context, uint32_t event) {
     xremote_app_assert(context, false);
     XRemoteSignalAnalyzer* analyzer = context;
 
     if(event == XRemoteEventSignalExit) {
+        xremote_signal_analyzer_capture_stop(analyzer);
         xremote_signal_analyzer_rx_stop(analyzer);
         xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewSubmenu);
     } else if(event == XRemoteEventSignalReceived) {
+        /* Single capture may race with switching to the continuous mode */
+        if(analyzer->continuous) return true;
+        analyzer->wave_valid = false;
         xremote_signal_analyzer_rx_stop(analyzer);
         xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewSignal);
     } else if(event == XRemoteEventSignalRetry) {
-        xremote_signal_analyzer_rx_start(analyzer);
-        xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewAnalyzer);
+        /* Next capture overwrites the signal which may still be queued */
+        xremote_transmitter_flush(analyzer->app_ctx->transmitter);
+
+        if(analyzer->continuous) {
+            xremote_signal_analyzer_capture_resume(analyzer);
+        } else {
+            xremote_signal_analyzer_rx_start(analyzer);
+            xremote_signal_analyzer_switch_to_view(analyzer, XRemoteViewAnalyzer);
+        }
     } else if(event == XRemoteEventSignalSend) {
         XRemoteAppContext* app_ctx = analyzer->app_ctx;
-        xremote_app_send_signal(app_ctx, analyzer->ir_signal);
+        InfraredSignal* ir_signal = xremote_signal_analyzer_get_ir_signal(analyzer);
+        xremote_app_send_signal(app_ctx, ir_signal);
+    } else if(event == XRemoteEventSignalSave) {
+        if(xremote_signal_analyzer_save(analyzer))
+            xremote_app_context_notify_led(analyzer->app_ctx);
+    } else if(event == XRemoteEventCaptureStart) {
+        xremote_signal_analyzer_capture_start(analyzer);
+    } else if(event == XRemoteEventCaptureUpdate) {
+        if(analyzer->continuous) xremote_signal_analyzer_capture_update(analyzer);
+    } else if(event == XRemoteEventCaptureInspect) {
+        if(analyzer->continuous) xremote_signal_analyzer_capture_inspect(analyzer);
+    } else if(event == XRemoteEventSignalWave) {
+        xremote_signal_analyzer_wave_open(analyzer);
+    } else if(event == XRemoteEventCaptureCompare) {
+        if(analyzer->continuous) xremote_signal_analyzer_capture_compare(analyzer);
     }
 
     return true;
@@ -96,15 +403,50 @@ static bool xremote_signal_analyzer_custom_event_callback(void* context, uint32_
 
 static XRemoteSignalAnalyzer* xremote_signal_analyzer_alloc(XRemoteAppContext* app_ctx) {
     XRemoteSignalAnalyzer* analyzer = malloc(sizeof(XRemoteSignalAnalyzer));
-    analyzer->ir_signal = infrared_signal_alloc();
     analyzer->app_ctx = app_ctx;
     analyzer->pause = false;
 
+    analyzer->ring = NULL;
+    analyzer->signal = NULL;
+    analyzer->start_tick = 0;
+    analyzer->drawn_total = 0;
+    analyzer->selected_seq = 0;
+    analyzer->saved = 0;
+    analyzer->follow = true;
+    analyzer->continuous = false;
+    analyzer->wave = NULL;
+    analyzer->wave_valid = false;
+    analyzer->log = NULL;
+    analyzer->marked_signal = NULL;
+    analyzer->diff = NULL;
+    analyzer->marked_seq = 0;
+    analyzer->has_mark = false;
+
+    if(app_ctx->app_settings->capture_log) analyzer->log = xremote_log_open(XREMOTE_LOG_PATH);
+
+    analyzer->timer = furi_timer_alloc(
+        xremote_signal_analyzer_timer_callback, FuriTimerTypePeriodic, analyzer);
+
     analyzer->signal_view = xremote_signal_success_view_alloc(app_ctx, analyzer);
     View* view = xremote_view_get_view(analyzer->signal_view);
     view_set_previous_callback(view, xremote_signal_analyzer_view_exit_callback);
     view_dispatcher_add_view(app_ctx->view_dispatcher, XRemoteViewSignal, view);
 
+    analyzer->capture_view = xremote_capture_view_alloc(app_ctx, analyzer);
+    view = xremote_view_get_view(analyzer->capture_view);
+    view_set_previous_callback(view, xremote_signal_analyzer_view_exit_callback);
+    view_dispatcher_add_view(app_ctx->view_dispatcher, XRemoteViewCapture, view);
+
+    analyzer->wave_view = xremote_wave_view_alloc(app_ctx, analyzer);
+    view = xremote_view_get_view(analyzer->wave_view);
+    view_set_previous_callback(view, xremote_signal_analyzer_wave_exit_callback);
+    view_dispatcher_add_view(app_ctx->view_dispatcher, XRemoteViewWave, view);
+
+    analyzer->diff_view = xremote_diff_view_alloc(app_ctx, analyzer);
+    view = xremote_view_get_view(analyzer->diff_view);
+    view_set_previous_callback(view, xremote_signal_analyzer_view_exit_callback);
+    view_dispatcher_add_view(app_ctx->view_dispatcher, XRemoteViewDiff, view);
+
     view_dispatcher_set_custom_event_callback(
         app_ctx->view_dispatcher, xremote_signal_analyzer_custom_event_callback);
     view_dispatcher_set_event_callback_context(app_ctx->view_dispatcher, analyzer);
@@ -119,6 +461,8 @@ static XRemoteSignalAnalyzer* xremote_signal_analyzer_alloc(XRemoteAppContext* a
 
 static void xremote_signal_analyzer_free(XRemoteSignalAnalyzer* analyzer) {
     xremote_app_assert_void(analyzer);
+    furi_timer_stop(analyzer->timer);
+    furi_timer_free(analyzer->timer);
     xremote_signal_receiver_stop(analyzer->ir_receiver);
 
     ViewDispatcher* view_disp = analyzer->app_ctx->view_dispatcher;
@@ -128,8 +472,24 @@ static void xremote_signal_analyzer_free(XRemoteSignalAnalyzer* analyzer) {
     view_dispatcher_remove_view(view_disp, XRemoteViewSignal);
     xremote_view_free(analyzer->signal_view);
 
+    view_dispatcher_remove_view(view_disp, XRemoteViewCapture);
+    xremote_view_free(analyzer->capture_view);
+
+    view_dispatcher_remove_view(view_disp, XRemoteViewWave);
+    xremote_view_free(analyzer->wave_view);
+
+    view_dispatcher_remove_view(view_disp, XRemoteViewDiff);
+    xremote_view_free(analyzer->diff_view);
+
+    xremote_transmitter_flush(analyzer->app_ctx->transmitter);
     xremote_signal_receiver_free(analyzer->ir_receiver);
-    infrared_signal_free(analyzer->ir_signal);
+    if(analyzer->log != NULL) xremote_log_close(analyzer->log);
+
+    if(analyzer->signal != NULL) infrared_signal_free(analyzer->signal);
+    if(analyzer->ring != NULL) xremote_capture_ring_free(analyzer->ring);
+    if(analyzer->wave != NULL) xremote_wave_free(analyzer->wave);
+    if(analyzer->marked_signal != NULL) infrared_signal_free(analyzer->marked_signal);
+    if(analyzer->diff != NULL) free(analyzer->diff);
     free(analyzer);
 }
 
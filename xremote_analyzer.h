@@ -10,6 +10,15 @@
 
 #include "xremote_app.h"
 #include "xremote_signal.h"
+#include "xremote_capture.h"
+#include "xremote_wave.h"
+#include "xremote_log.h"
+#include "xremote_diff.h"
+
+#define XREMOTE_ANALYZER_CAPTURES XREMOTE_APP_FOLDER "/XRemote_Captures.ir"
+
+/* Continuous capture list is redrawn at most this often */
+#define XREMOTE_ANALYZER_FRAME_MS 100
 
 typedef struct XRemoteSignalAnalyzer XRemoteSignalAnalyzer;
 
@@ -17,5 +26,17 @@ void xremote_signal_analyzer_send_event(XRemoteSignalAnalyzer* analyzer, XRemote
 XRemoteSignalReceiver* xremote_signal_analyzer_get_ir_receiver(XRemoteSignalAnalyzer* analyzer);
 XRemoteAppContext* xremote_signal_analyzer_get_app_context(XRemoteSignalAnalyzer* analyzer);
 InfraredSignal* xremote_signal_analyzer_get_ir_signal(XRemoteSignalAnalyzer* analyzer);
+XRemoteWave* xremote_signal_analyzer_get_wave(XRemoteSignalAnalyzer* analyzer);
+
+XRemoteCaptureRing* xremote_signal_analyzer_get_capture_ring(XRemoteSignalAnalyzer* analyzer);
+/* Selected index is only valid while the capture ring is locked */
+size_t xremote_signal_analyzer_get_selected(XRemoteSignalAnalyzer* analyzer);
+void xremote_signal_analyzer_move_selection(XRemoteSignalAnalyzer* analyzer, int step);
+
+/* Marked capture is the reference the selected one is compared with */
+void xremote_signal_analyzer_mark_selected(XRemoteSignalAnalyzer* analyzer);
+bool xremote_signal_analyzer_get_marked(XRemoteSignalAnalyzer* analyzer, size_t* index);
+InfraredSignal* xremote_signal_analyzer_get_marked_signal(XRemoteSignalAnalyzer* analyzer);
+XRemoteDiff* xremote_signal_analyzer_get_diff(XRemoteSignalAnalyzer* analyzer);
 
 XRemoteApp* xremote_analyzer_alloc(XRemoteAppContext* app_ctx);
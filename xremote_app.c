@@ -68,6 +68,51 @@ void xremote_app_notification_blink(NotificationApp* notifications) {
 // XRemote buttons and custom button pairs
 //////////////////////////////////////////////////////////////////////////////
 
+static const char* g_custom_keys[XRemoteCustomMax] = {
+    "custom_ok",
+    "custom_up",
+    "custom_down",
+    "custom_left",
+    "custom_right",
+    "custom_ok_hold",
+    "custom_up_hold",
+    "custom_down_hold",
+    "custom_left_hold",
+    "custom_right_hold",
+};
+
+static const char* g_custom_defaults[XRemoteCustomMax] = {
+    XREMOTE_COMMAND_OK,
+    XREMOTE_COMMAND_UP,
+    XREMOTE_COMMAND_DOWN,
+    XREMOTE_COMMAND_LEFT,
+    XREMOTE_COMMAND_RIGHT,
+    XREMOTE_COMMAND_POWER,
+    XREMOTE_COMMAND_INPUT,
+    XREMOTE_COMMAND_SETUP,
+    XREMOTE_COMMAND_MENU,
+    XREMOTE_COMMAND_LIST,
+};
+
+XRemoteCustomKey xremote_app_get_custom_key(InputKey key, bool hold) {
+    XRemoteCustomKey custom_key = XRemoteCustomMax;
+
+    if(key == InputKeyOk)
+        custom_key = XRemoteCustomOk;
+    else if(key == InputKeyUp)
+        custom_key = XRemoteCustomUp;
+    else if(key == InputKeyDown)
+        custom_key = XRemoteCustomDown;
+    else if(key == InputKeyLeft)
+        custom_key = XRemoteCustomLeft;
+    else if(key == InputKeyRight)
+        custom_key = XRemoteCustomRight;
+
+    /* Hold bindings follow the press bindings in the same order */
+    if(hold && custom_key != XRemoteCustomMax) custom_key += XRemoteCustomOkHold;
+    return custom_key;
+}
+
 bool xremote_app_extension_load(XRemoteAppButtons* buttons, FuriString* path) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
@@ -77,38 +122,18 @@ bool xremote_app_extension_load(XRemoteAppButtons* buttons, FuriString* path) {
     do {
         /* Open file and read the header */
         if(!flipper_format_buffered_file_open_existing(ff, furi_string_get_cstr(path))) break;
+        size_t i;
 
-        if(!flipper_format_read_string(ff, "custom_ok", tmp)) break;
-        furi_string_set(buttons->custom_ok, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_up", tmp)) break;
-        furi_string_set(buttons->custom_up, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_down", tmp)) break;
-        furi_string_set(buttons->custom_down, tmp);
+        for(i = 0; i < XRemoteCustomMax; i++) {
+            if(!flipper_format_read_string(ff, g_custom_keys[i], tmp)) break;
 
-        if(!flipper_format_read_string(ff, "custom_left", tmp)) break;
-        furi_string_set(buttons->custom_left, tmp);
+            /* Names are matched regardless of case, unknown ones keep the default binding */
+            const char* interned = NULL;
+            int command = xremote_button_intern(furi_string_get_cstr(tmp), &interned);
+            if(command >= 0) buttons->custom_commands[i] = command;
+        }
 
-        if(!flipper_format_read_string(ff, "custom_right", tmp)) break;
-        furi_string_set(buttons->custom_right, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_ok_hold", tmp)) break;
-        furi_string_set(buttons->custom_ok_hold, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_up_hold", tmp)) break;
-        furi_string_set(buttons->custom_up_hold, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_down_hold", tmp)) break;
-        furi_string_set(buttons->custom_down_hold, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_left_hold", tmp)) break;
-        furi_string_set(buttons->custom_left_hold, tmp);
-
-        if(!flipper_format_read_string(ff, "custom_right_hold", tmp)) break;
-        furi_string_set(buttons->custom_right_hold, tmp);
-
-        success = true;
+        success = i == XRemoteCustomMax;
     } while(false);
 
     furi_record_close(RECORD_STORAGE);
@@ -126,20 +151,14 @@ bool xremote_app_extension_store(XRemoteAppButtons* buttons, FuriString* path) {
     do {
         if(!flipper_format_file_open_append(ff, furi_string_get_cstr(path))) break;
         if(!flipper_format_write_comment_cstr(ff, "XRemote extension")) break;
+        size_t i;
 
-        if(!flipper_format_write_string(ff, "custom_ok", buttons->custom_ok)) break;
-        if(!flipper_format_write_string(ff, "custom_up", buttons->custom_up)) break;
-        if(!flipper_format_write_string(ff, "custom_down", buttons->custom_down)) break;
-        if(!flipper_format_write_string(ff, "custom_left", buttons->custom_left)) break;
-        if(!flipper_format_write_string(ff, "custom_right", buttons->custom_right)) break;
-        if(!flipper_format_write_string(ff, "custom_ok_hold", buttons->custom_ok_hold)) break;
-        if(!flipper_format_write_string(ff, "custom_up_hold", buttons->custom_up_hold)) break;
-        if(!flipper_format_write_string(ff, "custom_down_hold", buttons->custom_down_hold)) break;
-        if(!flipper_format_write_string(ff, "custom_left_hold", buttons->custom_left_hold)) break;
-        if(!flipper_format_write_string(ff, "custom_right_hold", buttons->custom_right_hold))
-            break;
+        for(i = 0; i < XRemoteCustomMax; i++) {
+            const char* name = xremote_button_get_name(buttons->custom_commands[i]);
+            if(!flipper_format_write_string_cstr(ff, g_custom_keys[i], name)) break;
+        }
 
-        success = true;
+        success = i == XRemoteCustomMax;
     } while(false);
 
     furi_record_close(RECORD_STORAGE);
@@ -193,17 +212,10 @@ bool xremote_app_alt_names_check_and_init() {
 
 void xremote_app_buttons_free(XRemoteAppButtons* buttons) {
     xremote_app_assert_void(buttons);
+
+    /* Queued signals reference the buttons of this remote */
+    if(buttons->app_ctx != NULL) xremote_transmitter_flush(buttons->app_ctx->transmitter);
     infrared_remote_free(buttons->remote);
-    furi_string_free(buttons->custom_up);
-    furi_string_free(buttons->custom_down);
-    furi_string_free(buttons->custom_left);
-    furi_string_free(buttons->custom_right);
-    furi_string_free(buttons->custom_ok);
-    furi_string_free(buttons->custom_up_hold);
-    furi_string_free(buttons->custom_down_hold);
-    furi_string_free(buttons->custom_left_hold);
-    furi_string_free(buttons->custom_right_hold);
-    furi_string_free(buttons->custom_ok_hold);
     free(buttons);
 }
 
@@ -213,20 +225,43 @@ XRemoteAppButtons* xremote_app_buttons_alloc() {
     buttons->app_ctx = NULL;
 
     /* Setup default buttons for custom layout */
-    buttons->custom_up = furi_string_alloc_set_str(XREMOTE_COMMAND_UP);
-    buttons->custom_down = furi_string_alloc_set_str(XREMOTE_COMMAND_DOWN);
-    buttons->custom_left = furi_string_alloc_set_str(XREMOTE_COMMAND_LEFT);
-    buttons->custom_right = furi_string_alloc_set_str(XREMOTE_COMMAND_RIGHT);
-    buttons->custom_ok = furi_string_alloc_set_str(XREMOTE_COMMAND_OK);
-    buttons->custom_up_hold = furi_string_alloc_set_str(XREMOTE_COMMAND_INPUT);
-    buttons->custom_down_hold = furi_string_alloc_set_str(XREMOTE_COMMAND_SETUP);
-    buttons->custom_left_hold = furi_string_alloc_set_str(XREMOTE_COMMAND_MENU);
-    buttons->custom_right_hold = furi_string_alloc_set_str(XREMOTE_COMMAND_LIST);
-    buttons->custom_ok_hold = furi_string_alloc_set_str(XREMOTE_COMMAND_POWER);
+    for(size_t i = 0; i < XRemoteCustomMax; i++) {
+        buttons->custom_commands[i] = xremote_button_get_index(g_custom_defaults[i]);
+        buttons->custom_buttons[i] = NULL;
+    }
 
     return buttons;
 }
 
+void xremote_app_buttons_set_custom(
+    XRemoteAppButtons* buttons,
+    XRemoteCustomKey key,
+    uint8_t command) {
+    xremote_app_assert_void((buttons && key < XRemoteCustomMax));
+    bool alt_names = buttons->app_ctx && buttons->app_ctx->app_settings->alt_names;
+    const char* name = xremote_button_get_name(command);
+
+    buttons->custom_commands[key] = command;
+    buttons->custom_buttons[key] = xremote_button_lookup(buttons->remote, name, alt_names);
+}
+
+void xremote_app_buttons_resolve(XRemoteAppButtons* buttons) {
+    xremote_app_assert_void(buttons);
+    for(size_t i = 0; i < XRemoteCustomMax; i++)
+        xremote_app_buttons_set_custom(buttons, i, buttons->custom_commands[i]);
+}
+
+const char* xremote_app_buttons_get_custom_name(XRemoteAppButtons* buttons, XRemoteCustomKey key) {
+    xremote_app_assert((buttons && key < XRemoteCustomMax), NULL);
+    return xremote_button_get_name(buttons->custom_commands[key]);
+}
+
+InfraredRemoteButton*
+    xremote_app_buttons_get_custom(XRemoteAppButtons* buttons, XRemoteCustomKey key) {
+    xremote_app_assert((buttons && key < XRemoteCustomMax), NULL);
+    return buttons->custom_buttons[key];
+}
+
 XRemoteAppButtons* xremote_app_buttons_load(XRemoteAppContext* app_ctx) {
     /* Show file selection dialog (returns selected file path with app_ctx->file_path) */
     if(!xremote_app_context_select_file(app_ctx, XREMOTE_APP_EXTENSION)) return NULL;
@@ -234,13 +269,21 @@ XRemoteAppButtons* xremote_app_buttons_load(XRemoteAppContext* app_ctx) {
     buttons->app_ctx = app_ctx;
 
     /* Load buttons from the selected path */
+    uint32_t start = xremote_diag_start();
     if(!infrared_remote_load(buttons->remote, app_ctx->file_path)) {
         xremote_app_buttons_free(buttons);
         return NULL;
     }
 
-    /* Load custom buttons from the selected path */
+    /* Load custom buttons from the selected path and resolve them once */
     xremote_app_extension_load(buttons, app_ctx->file_path);
+    xremote_app_buttons_resolve(buttons);
+    xremote_diag_stop(app_ctx->diag, XRemoteDiagLoad, start);
+
+    /* Remember how much heap the loaded remote takes */
+    InfraredRemote* remote = buttons->remote;
+    size_t count = infrared_remote_get_button_count(remote);
+    xremote_diag_set_remote(app_ctx->diag, count, infrared_remote_get_footprint(remote));
     return buttons;
 }
 
@@ -254,6 +297,8 @@ XRemoteAppSettings* xremote_app_settings_alloc() {
     settings->exit_behavior = XRemoteAppExitPress;
     settings->repeat_count = 2;
     settings->alt_names = 1;
+    settings->learn_captures = 1;
+    settings->capture_log = 0;
     return settings;
 }
 
@@ -288,6 +333,12 @@ bool xremote_app_settings_store(XRemoteAppSettings* settings) {
         value = settings->alt_names;
         if(!flipper_format_write_uint32(ff, "altNames", &value, 1)) break;
 
+        value = settings->learn_captures;
+        if(!flipper_format_write_uint32(ff, "learnCaptures", &value, 1)) break;
+
+        value = settings->capture_log;
+        if(!flipper_format_write_uint32(ff, "captureLog", &value, 1)) break;
+
         success = true;
     } while(false);
 
@@ -326,6 +377,13 @@ bool xremote_app_settings_load(XRemoteAppSettings* settings) {
         if(!flipper_format_read_uint32(ff, "altNames", &value, 1)) break;
         settings->alt_names = value;
 
+        /* Config files written by older versions have no capture count */
+        if(flipper_format_read_uint32(ff, "learnCaptures", &value, 1))
+            settings->learn_captures = value ? value : 1;
+
+        if(flipper_format_read_uint32(ff, "captureLog", &value, 1))
+            settings->capture_log = value;
+
         success = true;
     } while(false);
 
@@ -360,15 +418,24 @@ XRemoteAppContext* xremote_app_context_alloc(void* arg) {
     ctx->view_dispatcher = view_dispatcher_alloc();
     view_dispatcher_attach_to_gui(ctx->view_dispatcher, ctx->gui, ViewDispatcherTypeFullscreen);
 
+    /* Allocate diagnostics and watch the stack of the main app thread */
+    ctx->diag = xremote_diag_alloc();
+    xremote_diag_add_thread(ctx->diag, "stack_app", furi_thread_get_current_id());
+
+    /* Start transmitter thread so input callbacks never wait for the air time */
+    ctx->transmitter = xremote_transmitter_alloc(ctx->notifications, ctx->diag);
+
     return ctx;
 }
 
 void xremote_app_context_free(XRemoteAppContext* ctx) {
     xremote_app_assert_void(ctx);
+    xremote_transmitter_free(ctx->transmitter);
     notification_internal_message(ctx->notifications, &sequence_reset_blue);
 
     xremote_app_settings_free(ctx->app_settings);
     view_dispatcher_free(ctx->view_dispatcher);
+    xremote_diag_free(ctx->diag);
 
     furi_record_close(RECORD_NOTIFICATION);
     furi_record_close(RECORD_GUI);
@@ -424,9 +491,7 @@ void xremote_app_context_notify_led(XRemoteAppContext* app_ctx) {
 bool xremote_app_send_signal(XRemoteAppContext* app_ctx, InfraredSignal* signal) {
     xremote_app_assert(signal, false);
     XRemoteAppSettings* settings = app_ctx->app_settings;
-    infrared_signal_transmit_times(signal, settings->repeat_count);
-    xremote_app_context_notify_led(app_ctx);
-    return true;
+    return xremote_transmitter_send(app_ctx->transmitter, signal, settings->repeat_count);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,8 @@
 #include <infrared_worker.h>
 
 #include "views/xremote_common_view.h"
+#include "xremote_diag.h"
+#include "xremote_transmit.h"
 #include "xc_icons.h"
 
 //////////////////////////////////////////////////////////////////////////////
@@ -65,6 +67,8 @@ typedef struct {
     XRemoteAppExit exit_behavior;
     uint32_t repeat_count;
     uint32_t alt_names;
+    uint32_t learn_captures;
+    uint32_t capture_log;
 } XRemoteAppSettings;
 
 XRemoteAppSettings* xremote_app_settings_alloc();
@@ -81,6 +85,8 @@ typedef struct {
     XRemoteAppSettings* app_settings;
     NotificationApp* notifications;
     ViewDispatcher* view_dispatcher;
+    XRemoteTransmitter* transmitter;
+    XRemoteDiag* diag;
     FuriString* file_path;
     void* app_argument;
     Gui* gui;
@@ -100,24 +106,42 @@ bool xremote_app_browser_select_file(FuriString** file_path, const char* extensi
 // XRemote buttons and custom button pairs
 //////////////////////////////////////////////////////////////////////////////
 
+typedef enum {
+    XRemoteCustomOk,
+    XRemoteCustomUp,
+    XRemoteCustomDown,
+    XRemoteCustomLeft,
+    XRemoteCustomRight,
+    XRemoteCustomOkHold,
+    XRemoteCustomUpHold,
+    XRemoteCustomDownHold,
+    XRemoteCustomLeftHold,
+    XRemoteCustomRightHold,
+    XRemoteCustomMax
+} XRemoteCustomKey;
+
 typedef struct {
     XRemoteAppContext* app_ctx;
     InfraredRemote* remote;
-    FuriString* custom_up;
-    FuriString* custom_down;
-    FuriString* custom_left;
-    FuriString* custom_right;
-    FuriString* custom_ok;
-    FuriString* custom_up_hold;
-    FuriString* custom_down_hold;
-    FuriString* custom_left_hold;
-    FuriString* custom_right_hold;
-    FuriString* custom_ok_hold;
+
+    /* Custom layout bindings as command table indexes and resolved buttons */
+    uint8_t custom_commands[XRemoteCustomMax];
+    InfraredRemoteButton* custom_buttons[XRemoteCustomMax];
 } XRemoteAppButtons;
 
 void xremote_app_buttons_free(XRemoteAppButtons* buttons);
 XRemoteAppButtons* xremote_app_buttons_alloc();
 XRemoteAppButtons* xremote_app_buttons_load(XRemoteAppContext* app_ctx);
+void xremote_app_buttons_resolve(XRemoteAppButtons* buttons);
+
+XRemoteCustomKey xremote_app_get_custom_key(InputKey key, bool hold);
+const char* xremote_app_buttons_get_custom_name(XRemoteAppButtons* buttons, XRemoteCustomKey key);
+InfraredRemoteButton*
+    xremote_app_buttons_get_custom(XRemoteAppButtons* buttons, XRemoteCustomKey key);
+void xremote_app_buttons_set_custom(
+    XRemoteAppButtons* buttons,
+    XRemoteCustomKey key,
+    uint8_t command);
 
 bool xremote_app_extension_store(XRemoteAppButtons* buttons, FuriString* path);
 bool xremote_app_extension_load(XRemoteAppButtons* buttons, FuriString* path);
@@ -0,0 +1,213 @@
+/*!
+ *  @file flipper-xremote/xremote_broadcast.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Broadcast of one command to every remote from the device list.
+ */
+
+#include "xremote_broadcast.h"
+#include "views/xremote_broadcast_view.h"
+
+#include <m-array.h>
+#include <toolbox/path.h>
+
+#define TAG "XRemoteBroadcast"
+
+ARRAY_DEF(XRemoteBroadcastRemotes, InfraredRemote*, M_PTR_OPLIST);
+
+struct XRemoteBroadcast {
+    XRemoteBroadcastRemotes_t remotes;
+    XRemoteAppContext* app_ctx;
+    FuriString* name;
+    int command;
+
+    /* Signals of every command resolved once, device_count slots per command */
+    InfraredSignal** signals;
+    uint8_t resolved[XREMOTE_BUTTON_COUNT];
+};
+
+XRemoteAppContext* xremote_broadcast_get_app_context(XRemoteBroadcast* broadcast) {
+    xremote_app_assert(broadcast, NULL);
+    return broadcast->app_ctx;
+}
+
+const char* xremote_broadcast_get_name(XRemoteBroadcast* broadcast) {
+    xremote_app_assert(broadcast, "");
+    return furi_string_get_cstr(broadcast->name);
+}
+
+const char* xremote_broadcast_get_command_name(XRemoteBroadcast* broadcast) {
+    xremote_app_assert(broadcast, "");
+    return xremote_button_get_name(broadcast->command);
+}
+
+size_t xremote_broadcast_get_device_count(XRemoteBroadcast* broadcast) {
+    xremote_app_assert(broadcast, 0);
+    return XRemoteBroadcastRemotes_size(broadcast->remotes);
+}
+
+size_t xremote_broadcast_get_resolved_count(XRemoteBroadcast* broadcast) {
+    xremote_app_assert(broadcast, 0);
+    return broadcast->resolved[broadcast->command];
+}
+
+void xremote_broadcast_next_command(XRemoteBroadcast* broadcast, bool forward) {
+    xremote_app_assert_void(broadcast);
+    int step = forward ? 1 : XREMOTE_BUTTON_COUNT - 1;
+    broadcast->command = (broadcast->command + step) % XREMOTE_BUTTON_COUNT;
+}
+
+bool xremote_broadcast_send(XRemoteBroadcast* broadcast) {
+    xremote_app_assert(broadcast, false);
+    size_t count = broadcast->resolved[broadcast->command];
+    xremote_app_assert(count, false);
+
+    XRemoteAppContext* app_ctx = broadcast->app_ctx;
+    size_t offset = broadcast->command * xremote_broadcast_get_device_count(broadcast);
+    InfraredSignal** signals = &broadcast->signals[offset];
+
+    /* Whole broadcast is one queue item sent back to back by the TX thread */
+    uint32_t repeat = app_ctx->app_settings->repeat_count;
+    if(!xremote_transmitter_send_batch(app_ctx->transmitter, signals, count, repeat))
+        return false;
+
+    dolphin_deed(DolphinDeedIrSend);
+    return true;
+}
+
+static void xremote_broadcast_resolve(XRemoteBroadcast* broadcast) {
+    size_t device_count = xremote_broadcast_get_device_count(broadcast);
+    bool alt_names = broadcast->app_ctx->app_settings->alt_names;
+
+    broadcast->signals = malloc(XREMOTE_BUTTON_COUNT * device_count * sizeof(InfraredSignal*));
+
+    for(int command = 0; command < XREMOTE_BUTTON_COUNT; command++) {
+        const char* name = xremote_button_get_name(command);
+        InfraredSignal** signals = &broadcast->signals[command * device_count];
+        uint8_t count = 0;
+
+        /* Devices without the command are skipped, the rest stay packed */
+        for(size_t i = 0; i < device_count; i++) {
+            InfraredRemote* remote = *XRemoteBroadcastRemotes_get(broadcast->remotes, i);
+            InfraredRemoteButton* button = xremote_button_lookup(remote, name, alt_names);
+            if(button != NULL) signals[count++] = infrared_remote_button_get_signal(button);
+        }
+
+        broadcast->resolved[command] = count;
+    }
+}
+
+static bool xremote_broadcast_load(XRemoteBroadcast* broadcast, FuriString* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    FuriString* remote_path = furi_string_alloc();
+    FuriString* header = furi_string_alloc();
+
+    FURI_LOG_I(TAG, "load broadcast file: \'%s\'", furi_string_get_cstr(path));
+    bool success = false;
+    uint32_t version = 0;
+
+    do {
+        /* Open file and read the header */
+        if(!flipper_format_buffered_file_open_existing(ff, furi_string_get_cstr(path))) break;
+        if(!flipper_format_read_header(ff, header, &version)) break;
+        if(!furi_string_equal(header, XREMOTE_BROADCAST_FILETYPE)) break;
+        if(version != XREMOTE_BROADCAST_VERSION) break;
+        success = true;
+
+        /* Every device is loaded once, broadcast does not touch the files anymore */
+        while(flipper_format_read_string(ff, "remote", remote_path)) {
+            InfraredRemote* remote = infrared_remote_alloc();
+
+            if(!infrared_remote_load(remote, remote_path)) {
+                FURI_LOG_E(
+                    TAG, "failed to load remote: \'%s\'", furi_string_get_cstr(remote_path));
+                infrared_remote_free(remote);
+                success = false;
+                break;
+            }
+
+            XRemoteBroadcastRemotes_push_back(broadcast->remotes, remote);
+        }
+
+        success = success && xremote_broadcast_get_device_count(broadcast) > 0;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(ff);
+    furi_string_free(remote_path);
+    furi_string_free(header);
+
+    if(success) xremote_broadcast_resolve(broadcast);
+    return success;
+}
+
+static void xremote_broadcast_free(XRemoteBroadcast* broadcast) {
+    xremote_app_assert_void(broadcast);
+
+    /* Queued broadcast references the signals of loaded remotes */
+    xremote_transmitter_flush(broadcast->app_ctx->transmitter);
+    XRemoteBroadcastRemotes_it_t it;
+
+    for(XRemoteBroadcastRemotes_it(it, broadcast->remotes); !XRemoteBroadcastRemotes_end_p(it);
+        XRemoteBroadcastRemotes_next(it)) {
+        infrared_remote_free(*XRemoteBroadcastRemotes_cref(it));
+    }
+
+    XRemoteBroadcastRemotes_clear(broadcast->remotes);
+    furi_string_free(broadcast->name);
+    free(broadcast->signals);
+    free(broadcast);
+}
+
+static void xremote_broadcast_clear_callback(void* context) {
+    XRemoteBroadcast* broadcast = context;
+    xremote_broadcast_free(broadcast);
+}
+
+static XRemoteBroadcast*
+    xremote_broadcast_alloc_from_path(XRemoteAppContext* app_ctx, FuriString* path) {
+    XRemoteBroadcast* broadcast = malloc(sizeof(XRemoteBroadcast));
+    broadcast->command = xremote_button_get_index(XREMOTE_COMMAND_POWER);
+    broadcast->app_ctx = app_ctx;
+    broadcast->signals = NULL;
+
+    XRemoteBroadcastRemotes_init(broadcast->remotes);
+    memset(broadcast->resolved, 0, sizeof(broadcast->resolved));
+
+    broadcast->name = furi_string_alloc();
+    path_extract_filename(path, broadcast->name, true);
+
+    if(!xremote_broadcast_load(broadcast, path)) {
+        xremote_broadcast_free(broadcast);
+        return NULL;
+    }
+
+    return broadcast;
+}
+
+static uint32_t xremote_broadcast_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+XRemoteApp* xremote_broadcast_alloc(XRemoteAppContext* app_ctx) {
+    FuriString* path = NULL;
+    XRemoteBroadcast* broadcast = NULL;
+
+    /* Show file selection dialog and load every device from the list */
+    if(xremote_app_browser_select_file(&path, XREMOTE_BROADCAST_EXTENSION))
+        broadcast = xremote_broadcast_alloc_from_path(app_ctx, path);
+
+    if(path != NULL) furi_string_free(path);
+    xremote_app_assert(broadcast, NULL);
+
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+    xremote_app_view_alloc2(app, XRemoteViewBroadcast, xremote_broadcast_view_alloc, broadcast);
+    xremote_app_view_set_previous_callback(app, xremote_broadcast_view_exit_callback);
+    xremote_app_set_user_context(app, broadcast, xremote_broadcast_clear_callback);
+
+    return app;
+}
@@ -0,0 +1,28 @@
+/*!
+ *  @file flipper-xremote/xremote_broadcast.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Broadcast of one command to every remote from the device list.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+
+#define XREMOTE_BROADCAST_EXTENSION ".xrb"
+#define XREMOTE_BROADCAST_FILETYPE  "XRemote Broadcast"
+#define XREMOTE_BROADCAST_VERSION   1
+
+typedef struct XRemoteBroadcast XRemoteBroadcast;
+
+XRemoteAppContext* xremote_broadcast_get_app_context(XRemoteBroadcast* broadcast);
+const char* xremote_broadcast_get_name(XRemoteBroadcast* broadcast);
+const char* xremote_broadcast_get_command_name(XRemoteBroadcast* broadcast);
+size_t xremote_broadcast_get_device_count(XRemoteBroadcast* broadcast);
+size_t xremote_broadcast_get_resolved_count(XRemoteBroadcast* broadcast);
+
+void xremote_broadcast_next_command(XRemoteBroadcast* broadcast, bool forward);
+bool xremote_broadcast_send(XRemoteBroadcast* broadcast);
+
+XRemoteApp* xremote_broadcast_alloc(XRemoteAppContext* app_ctx);
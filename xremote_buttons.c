@@ -0,0 +1,75 @@
+/*!
+ *  @file flipper-xremote/xremote_buttons.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Standard button names and their command indexes, shared by the remote and the views.
+ */
+
+#include "xremote_buttons.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+
+typedef struct {
+    int index;
+    const char* name;
+} XRemoteButton;
+
+static const XRemoteButton g_buttons[XREMOTE_BUTTON_COUNT + 1] = {
+    {0, XREMOTE_COMMAND_POWER},
+    {1, XREMOTE_COMMAND_SETUP},
+    {2, XREMOTE_COMMAND_INPUT},
+    {3, XREMOTE_COMMAND_EJECT},
+    {4, XREMOTE_COMMAND_MENU},
+    {5, XREMOTE_COMMAND_LIST},
+    {6, XREMOTE_COMMAND_INFO},
+    {7, XREMOTE_COMMAND_BACK},
+    {8, XREMOTE_COMMAND_OK},
+    {9, XREMOTE_COMMAND_UP},
+    {10, XREMOTE_COMMAND_DOWN},
+    {11, XREMOTE_COMMAND_LEFT},
+    {12, XREMOTE_COMMAND_RIGHT},
+    {13, XREMOTE_COMMAND_JUMP_FORWARD},
+    {14, XREMOTE_COMMAND_JUMP_BACKWARD},
+    {15, XREMOTE_COMMAND_FAST_FORWARD},
+    {16, XREMOTE_COMMAND_FAST_BACKWARD},
+    {17, XREMOTE_COMMAND_PLAY_PAUSE},
+    {18, XREMOTE_COMMAND_PAUSE},
+    {19, XREMOTE_COMMAND_PLAY},
+    {20, XREMOTE_COMMAND_STOP},
+    {21, XREMOTE_COMMAND_MUTE},
+    {22, XREMOTE_COMMAND_MODE},
+    {23, XREMOTE_COMMAND_VOL_UP},
+    {24, XREMOTE_COMMAND_VOL_DOWN},
+    {25, XREMOTE_COMMAND_NEXT_CHAN},
+    {26, XREMOTE_COMMAND_PREV_CHAN},
+    {-1, NULL}};
+
+const char* xremote_button_get_name(int index) {
+    if(index < 0 || index > XREMOTE_BUTTON_COUNT) return NULL;
+    return g_buttons[index].name;
+}
+
+int xremote_button_get_index(const char* name) {
+    size_t i;
+    for(i = 0; i < XREMOTE_BUTTON_COUNT; i++) {
+        if(!strcmp(name, g_buttons[i].name)) return g_buttons[i].index;
+    }
+    return -1;
+}
+
+int xremote_button_intern(const char* name, const char** interned) {
+    size_t i;
+    *interned = NULL;
+
+    /* Case-insensitive match gives the command, exact match also gives the static name */
+    for(i = 0; i < XREMOTE_BUTTON_COUNT; i++) {
+        if(strcasecmp(name, g_buttons[i].name)) continue;
+        if(!strcmp(name, g_buttons[i].name)) *interned = g_buttons[i].name;
+        return g_buttons[i].index;
+    }
+
+    return -1;
+}
@@ -0,0 +1,43 @@
+/*!
+ *  @file flipper-xremote/xremote_buttons.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Standard button names and their command indexes, shared by the remote and the views.
+ */
+
+#pragma once
+
+#define XREMOTE_BUTTON_COUNT 27
+
+#define XREMOTE_COMMAND_POWER         "Power"
+#define XREMOTE_COMMAND_EJECT         "Eject"
+#define XREMOTE_COMMAND_SETUP         "Setup"
+#define XREMOTE_COMMAND_INPUT         "Input"
+#define XREMOTE_COMMAND_MENU          "Menu"
+#define XREMOTE_COMMAND_LIST          "List"
+#define XREMOTE_COMMAND_INFO          "Info"
+#define XREMOTE_COMMAND_BACK          "Back"
+#define XREMOTE_COMMAND_OK            "Ok"
+#define XREMOTE_COMMAND_UP            "Up"
+#define XREMOTE_COMMAND_DOWN          "Down"
+#define XREMOTE_COMMAND_LEFT          "Left"
+#define XREMOTE_COMMAND_RIGHT         "Right"
+#define XREMOTE_COMMAND_JUMP_FORWARD  "Next"
+#define XREMOTE_COMMAND_JUMP_BACKWARD "Prev"
+#define XREMOTE_COMMAND_FAST_FORWARD  "Fast_fo"
+#define XREMOTE_COMMAND_FAST_BACKWARD "Fast_ba"
+#define XREMOTE_COMMAND_PLAY_PAUSE    "Play_pa"
+#define XREMOTE_COMMAND_PAUSE         "Pause"
+#define XREMOTE_COMMAND_PLAY          "Play"
+#define XREMOTE_COMMAND_STOP          "Stop"
+#define XREMOTE_COMMAND_MUTE          "Mute"
+#define XREMOTE_COMMAND_MODE          "Mode"
+#define XREMOTE_COMMAND_VOL_UP        "Vol_up"
+#define XREMOTE_COMMAND_VOL_DOWN      "Vol_dn"
+#define XREMOTE_COMMAND_NEXT_CHAN     "Ch_next"
+#define XREMOTE_COMMAND_PREV_CHAN     "Ch_prev"
+
+const char* xremote_button_get_name(int index);
+int xremote_button_get_index(const char* name);
+int xremote_button_intern(const char* name, const char** interned);
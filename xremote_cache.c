@@ -0,0 +1,132 @@
+/*!
+ *  @file flipper-xremote/xremote_cache.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Bounded LRU cache of pre-encoded timings keyed by parsed message content.
+ */
+
+#include "xremote_cache.h"
+#include "xremote_app.h"
+
+struct XRemoteCache {
+    XRemoteCacheEntry entries[XREMOTE_CACHE_ENTRIES];
+    size_t max_bytes;
+    size_t bytes;
+    uint32_t clock;
+};
+
+static void xremote_cache_entry_clear(XRemoteCache* cache, XRemoteCacheEntry* entry) {
+    cache->bytes -= entry->timings_size * sizeof(uint32_t);
+    free(entry->timings);
+
+    entry->timings = NULL;
+    entry->timings_size = 0;
+    entry->used = false;
+}
+
+static bool xremote_cache_entry_match(
+    XRemoteCacheEntry* entry,
+    const InfraredMessage* message,
+    int times) {
+    /* Signals are edited and freed in place, so the content is the key and not the pointer */
+    return entry->used && entry->times == times &&
+           entry->message.protocol == message->protocol &&
+           entry->message.address == message->address &&
+           entry->message.command == message->command &&
+           entry->message.repeat == message->repeat;
+}
+
+static XRemoteCacheEntry* xremote_cache_get_lru(XRemoteCache* cache) {
+    XRemoteCacheEntry* lru = NULL;
+
+    for(size_t i = 0; i < XREMOTE_CACHE_ENTRIES; i++) {
+        XRemoteCacheEntry* entry = &cache->entries[i];
+        if(!entry->used) return entry;
+        if(lru == NULL || entry->last_used < lru->last_used) lru = entry;
+    }
+
+    return lru;
+}
+
+XRemoteCache* xremote_cache_alloc(size_t max_bytes) {
+    XRemoteCache* cache = malloc(sizeof(XRemoteCache));
+    xremote_app_assert(cache, NULL);
+
+    memset(cache, 0, sizeof(XRemoteCache));
+    cache->max_bytes = max_bytes;
+    return cache;
+}
+
+void xremote_cache_free(XRemoteCache* cache) {
+    xremote_app_assert_void(cache);
+    xremote_cache_clear(cache);
+    free(cache);
+}
+
+void xremote_cache_clear(XRemoteCache* cache) {
+    xremote_app_assert_void(cache);
+
+    for(size_t i = 0; i < XREMOTE_CACHE_ENTRIES; i++) {
+        XRemoteCacheEntry* entry = &cache->entries[i];
+        if(entry->used) xremote_cache_entry_clear(cache, entry);
+    }
+}
+
+XRemoteCacheEntry*
+    xremote_cache_find(XRemoteCache* cache, const InfraredMessage* message, int times) {
+    xremote_app_assert(cache, NULL);
+
+    for(size_t i = 0; i < XREMOTE_CACHE_ENTRIES; i++) {
+        XRemoteCacheEntry* entry = &cache->entries[i];
+        if(!xremote_cache_entry_match(entry, message, times)) continue;
+
+        entry->last_used = ++cache->clock;
+        return entry;
+    }
+
+    return NULL;
+}
+
+XRemoteCacheEntry*
+    xremote_cache_add(XRemoteCache* cache, const InfraredMessage* message, int times) {
+    xremote_app_assert((cache && message), NULL);
+
+    /* Count timings first to check the budget before allocating */
+    size_t count = infrared_signal_encode_message(message, times, NULL, MAX_TIMINGS_AMOUNT);
+    size_t size = count * sizeof(uint32_t);
+    if(!count || size > cache->max_bytes) return NULL;
+
+    /* Evict least recently used entries until the new one fits */
+    XRemoteCacheEntry* entry = xremote_cache_get_lru(cache);
+    if(entry->used) xremote_cache_entry_clear(cache, entry);
+
+    while(cache->bytes + size > cache->max_bytes) {
+        XRemoteCacheEntry* lru = NULL;
+
+        for(size_t i = 0; i < XREMOTE_CACHE_ENTRIES; i++) {
+            XRemoteCacheEntry* other = &cache->entries[i];
+            if(!other->used) continue;
+            if(lru == NULL || other->last_used < lru->last_used) lru = other;
+        }
+
+        xremote_cache_entry_clear(cache, lru);
+    }
+
+    entry->timings = malloc(size);
+    entry->timings_size = infrared_signal_encode_message(message, times, entry->timings, count);
+    entry->frequency = infrared_get_protocol_frequency(message->protocol);
+    entry->duty_cycle = infrared_get_protocol_duty_cycle(message->protocol);
+    entry->last_used = ++cache->clock;
+    entry->message = *message;
+    entry->times = times;
+    entry->used = true;
+
+    cache->bytes += entry->timings_size * sizeof(uint32_t);
+    return entry;
+}
+
+size_t xremote_cache_get_size(XRemoteCache* cache) {
+    xremote_app_assert(cache, 0);
+    return cache->bytes;
+}
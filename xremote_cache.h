@@ -0,0 +1,38 @@
+/*!
+ *  @file flipper-xremote/xremote_cache.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Bounded LRU cache of pre-encoded timings keyed by parsed message content.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include "infrared/infrared_signal.h"
+
+#define XREMOTE_CACHE_ENTRIES 8
+#define XREMOTE_CACHE_BYTES   4096
+
+typedef struct {
+    InfraredMessage message;
+    uint32_t* timings;
+    size_t timings_size;
+    uint32_t frequency;
+    uint32_t last_used;
+    float duty_cycle;
+    int times;
+    bool used;
+} XRemoteCacheEntry;
+
+typedef struct XRemoteCache XRemoteCache;
+
+XRemoteCache* xremote_cache_alloc(size_t max_bytes);
+void xremote_cache_free(XRemoteCache* cache);
+void xremote_cache_clear(XRemoteCache* cache);
+
+XRemoteCacheEntry*
+    xremote_cache_find(XRemoteCache* cache, const InfraredMessage* message, int times);
+XRemoteCacheEntry*
+    xremote_cache_add(XRemoteCache* cache, const InfraredMessage* message, int times);
+size_t xremote_cache_get_size(XRemoteCache* cache);
@@ -0,0 +1,170 @@
+/*!
+ *  @file flipper-xremote/xremote_capture.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Fixed size ring buffer of the recently captured signals.
+ */
+
+#include "xremote_capture.h"
+
+struct XRemoteCaptureRing {
+    XRemoteCaptureEntry entries[XREMOTE_CAPTURE_ENTRIES];
+    uint32_t* timings;
+    FuriMutex* mutex;
+
+    /* Oldest entry, number of entries and next free position of the timing pool */
+    size_t first;
+    size_t count;
+    size_t write;
+    uint32_t total;
+};
+
+XRemoteCaptureRing* xremote_capture_ring_alloc() {
+    XRemoteCaptureRing* ring = malloc(sizeof(XRemoteCaptureRing));
+    xremote_app_assert(ring, NULL);
+
+    ring->timings = malloc(XREMOTE_CAPTURE_TIMINGS * sizeof(uint32_t));
+    ring->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    ring->first = 0;
+    ring->count = 0;
+    ring->write = 0;
+    ring->total = 0;
+
+    return ring;
+}
+
+void xremote_capture_ring_free(XRemoteCaptureRing* ring) {
+    xremote_app_assert_void(ring);
+    furi_mutex_free(ring->mutex);
+    free(ring->timings);
+    free(ring);
+}
+
+void xremote_capture_ring_lock(XRemoteCaptureRing* ring) {
+    furi_mutex_acquire(ring->mutex, FuriWaitForever);
+}
+
+void xremote_capture_ring_unlock(XRemoteCaptureRing* ring) {
+    furi_mutex_release(ring->mutex);
+}
+
+void xremote_capture_ring_clear(XRemoteCaptureRing* ring) {
+    xremote_app_assert_void(ring);
+    xremote_capture_ring_lock(ring);
+    ring->first = 0;
+    ring->count = 0;
+    ring->write = 0;
+    ring->total = 0;
+    xremote_capture_ring_unlock(ring);
+}
+
+static void xremote_capture_ring_drop(XRemoteCaptureRing* ring, size_t count) {
+    ring->first = (ring->first + count) % XREMOTE_CAPTURE_ENTRIES;
+    ring->count -= count;
+}
+
+static bool xremote_capture_ring_overlaps(
+    XRemoteCaptureEntry* entry,
+    const uint32_t* pool,
+    size_t start,
+    size_t end) {
+    if(!entry->is_raw) return false;
+    size_t offset = entry->timings - pool;
+    return offset < end && start < offset + entry->timings_size;
+}
+
+static uint32_t* xremote_capture_ring_claim(XRemoteCaptureRing* ring, size_t size) {
+    size_t start = ring->write;
+    size_t end = start + size;
+
+    /* Tail of the pool is abandoned on wrap, entries living there are older anyway */
+    if(end > XREMOTE_CAPTURE_TIMINGS) {
+        end = XREMOTE_CAPTURE_TIMINGS;
+        ring->write = 0;
+    }
+
+    /* Raw timings are allocated in order, so only the oldest entries can be hit */
+    size_t drop = 0;
+    for(size_t i = 0; i < ring->count; i++) {
+        XRemoteCaptureEntry* entry = &ring->entries[(ring->first + i) % XREMOTE_CAPTURE_ENTRIES];
+        bool hit = xremote_capture_ring_overlaps(entry, ring->timings, start, end);
+        if(!hit && ring->write == 0)
+            hit = xremote_capture_ring_overlaps(entry, ring->timings, 0, size);
+        if(hit) drop = i + 1;
+    }
+
+    xremote_capture_ring_drop(ring, drop);
+    uint32_t* timings = &ring->timings[ring->write];
+    ring->write += size;
+
+    return timings;
+}
+
+bool xremote_capture_ring_push(XRemoteCaptureRing* ring, InfraredSignal* signal, uint32_t tick) {
+    xremote_app_assert(ring, false);
+    bool is_raw = infrared_signal_is_raw(signal);
+    InfraredRawSignal* raw = is_raw ? infrared_signal_get_raw_signal(signal) : NULL;
+
+    size_t size = is_raw ? raw->timings_size : 0;
+    if(is_raw && (!size || size > XREMOTE_CAPTURE_TIMINGS)) return false;
+
+    xremote_capture_ring_lock(ring);
+    if(ring->count == XREMOTE_CAPTURE_ENTRIES) xremote_capture_ring_drop(ring, 1);
+
+    uint32_t* timings = is_raw ? xremote_capture_ring_claim(ring, size) : NULL;
+    size_t index = (ring->first + ring->count) % XREMOTE_CAPTURE_ENTRIES;
+    XRemoteCaptureEntry* entry = &ring->entries[index];
+
+    entry->seq = ring->total++;
+    entry->tick = tick;
+    entry->is_raw = is_raw;
+    entry->timings = timings;
+    entry->timings_size = size;
+
+    if(is_raw)
+        memcpy(timings, raw->timings, size * sizeof(uint32_t));
+    else
+        entry->message = *infrared_signal_get_message(signal);
+
+    ring->count++;
+    xremote_capture_ring_unlock(ring);
+
+    return true;
+}
+
+size_t xremote_capture_ring_get_count(XRemoteCaptureRing* ring) {
+    xremote_app_assert(ring, 0);
+    return ring->count;
+}
+
+uint32_t xremote_capture_ring_get_total(XRemoteCaptureRing* ring) {
+    xremote_app_assert(ring, 0);
+    return ring->total;
+}
+
+bool xremote_capture_ring_get(XRemoteCaptureRing* ring, size_t index, XRemoteCaptureEntry* entry) {
+    xremote_app_assert(ring, false);
+    xremote_app_assert((index < ring->count), false);
+    *entry = ring->entries[(ring->first + index) % XREMOTE_CAPTURE_ENTRIES];
+    return true;
+}
+
+bool xremote_capture_ring_load(XRemoteCaptureRing* ring, size_t index, InfraredSignal* signal) {
+    XRemoteCaptureEntry entry;
+    xremote_app_assert(xremote_capture_ring_get(ring, index, &entry), false);
+
+    /* Signal references the pool and stays valid until the next push */
+    if(entry.is_raw) {
+        infrared_signal_set_raw_signal_ref(
+            signal,
+            (uint32_t*)entry.timings,
+            entry.timings_size,
+            INFRARED_COMMON_CARRIER_FREQUENCY,
+            INFRARED_COMMON_DUTY_CYCLE);
+    } else {
+        infrared_signal_set_message(signal, &entry.message);
+    }
+
+    return true;
+}
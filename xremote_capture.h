@@ -0,0 +1,42 @@
+/*!
+ *  @file flipper-xremote/xremote_capture.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Fixed size ring buffer of the recently captured signals.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+/* Entries and raw timings share one allocation made when the ring is created */
+#define XREMOTE_CAPTURE_ENTRIES 32
+#define XREMOTE_CAPTURE_TIMINGS 2048
+
+typedef struct {
+    uint32_t seq;
+    uint32_t tick;
+    bool is_raw;
+    InfraredMessage message;
+    const uint32_t* timings;
+    size_t timings_size;
+} XRemoteCaptureEntry;
+
+typedef struct XRemoteCaptureRing XRemoteCaptureRing;
+
+XRemoteCaptureRing* xremote_capture_ring_alloc();
+void xremote_capture_ring_free(XRemoteCaptureRing* ring);
+void xremote_capture_ring_clear(XRemoteCaptureRing* ring);
+
+void xremote_capture_ring_lock(XRemoteCaptureRing* ring);
+void xremote_capture_ring_unlock(XRemoteCaptureRing* ring);
+
+/* Readers hold the lock while the receiver keeps pushing new captures */
+bool xremote_capture_ring_push(XRemoteCaptureRing* ring, InfraredSignal* signal, uint32_t tick);
+size_t xremote_capture_ring_get_count(XRemoteCaptureRing* ring);
+uint32_t xremote_capture_ring_get_total(XRemoteCaptureRing* ring);
+
+bool xremote_capture_ring_get(XRemoteCaptureRing* ring, size_t index, XRemoteCaptureEntry* entry);
+bool xremote_capture_ring_load(XRemoteCaptureRing* ring, size_t index, InfraredSignal* signal);
@@ -0,0 +1,248 @@
+/*!
+ *  @file flipper-xremote/xremote_consensus.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Consensus signal from multiple captures of the same button.
+ */
+
+#include "xremote_consensus.h"
+
+#define TAG "XRemoteConsensus"
+
+typedef struct {
+    InfraredMessage message;
+    uint16_t* timings;
+    size_t size;
+    uint32_t frequency;
+    float duty_cycle;
+    bool is_raw;
+} XRemoteConsensusCapture;
+
+struct XRemoteConsensus {
+    XRemoteConsensusCapture captures[XREMOTE_CONSENSUS_CAPTURES];
+
+    /* Captured timings fit 16 bits, the result is referenced by the built signal */
+    uint16_t* pool;
+    uint32_t* result;
+    size_t count;
+    uint8_t quality;
+};
+
+XRemoteConsensus* xremote_consensus_alloc() {
+    XRemoteConsensus* consensus = malloc(sizeof(XRemoteConsensus));
+    xremote_app_assert(consensus, NULL);
+
+    size_t pool_size = XREMOTE_CONSENSUS_CAPTURES * XREMOTE_CONSENSUS_TIMINGS;
+    consensus->pool = malloc(pool_size * sizeof(uint16_t));
+    consensus->result = malloc(XREMOTE_CONSENSUS_TIMINGS * sizeof(uint32_t));
+
+    for(size_t i = 0; i < XREMOTE_CONSENSUS_CAPTURES; i++)
+        consensus->captures[i].timings = &consensus->pool[i * XREMOTE_CONSENSUS_TIMINGS];
+
+    xremote_consensus_reset(consensus);
+    return consensus;
+}
+
+void xremote_consensus_free(XRemoteConsensus* consensus) {
+    xremote_app_assert_void(consensus);
+    free(consensus->result);
+    free(consensus->pool);
+    free(consensus);
+}
+
+void xremote_consensus_reset(XRemoteConsensus* consensus) {
+    xremote_app_assert_void(consensus);
+    consensus->count = 0;
+    consensus->quality = 0;
+}
+
+bool xremote_consensus_add(XRemoteConsensus* consensus, InfraredSignal* signal) {
+    xremote_app_assert(consensus, false);
+    xremote_app_assert((consensus->count < XREMOTE_CONSENSUS_CAPTURES), false);
+
+    XRemoteConsensusCapture* capture = &consensus->captures[consensus->count];
+    capture->is_raw = infrared_signal_is_raw(signal);
+
+    if(capture->is_raw) {
+        InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+
+        /* Truncated capture would build a cut off signal, the caller uses it alone instead */
+        if(raw->timings_size > XREMOTE_CONSENSUS_TIMINGS) return false;
+
+        capture->size = raw->timings_size;
+        capture->frequency = raw->frequency;
+        capture->duty_cycle = raw->duty_cycle;
+
+        for(size_t i = 0; i < capture->size; i++)
+            capture->timings[i] = MIN(raw->timings[i], (uint32_t)UINT16_MAX);
+    } else {
+        capture->message = *infrared_signal_get_message(signal);
+    }
+
+    consensus->count++;
+    return true;
+}
+
+size_t xremote_consensus_get_count(XRemoteConsensus* consensus) {
+    xremote_app_assert(consensus, 0);
+    return consensus->count;
+}
+
+uint8_t xremote_consensus_get_quality(XRemoteConsensus* consensus) {
+    xremote_app_assert(consensus, 0);
+    return consensus->quality;
+}
+
+static bool xremote_consensus_message_equal(const InfraredMessage* a, const InfraredMessage* b) {
+    return a->protocol == b->protocol && a->address == b->address && a->command == b->command;
+}
+
+static size_t xremote_consensus_vote_message(XRemoteConsensus* consensus, size_t* best) {
+    size_t best_votes = 0;
+
+    for(size_t i = 0; i < consensus->count; i++) {
+        if(consensus->captures[i].is_raw) continue;
+        size_t votes = 0;
+
+        for(size_t j = 0; j < consensus->count; j++) {
+            if(consensus->captures[j].is_raw) continue;
+            InfraredMessage* message = &consensus->captures[j].message;
+            if(xremote_consensus_message_equal(&consensus->captures[i].message, message))
+                votes++;
+        }
+
+        if(votes > best_votes) {
+            best_votes = votes;
+            *best = i;
+        }
+    }
+
+    return best_votes;
+}
+
+static size_t xremote_consensus_vote_size(XRemoteConsensus* consensus) {
+    size_t best_votes = 0;
+    size_t best_size = 0;
+
+    for(size_t i = 0; i < consensus->count; i++) {
+        if(!consensus->captures[i].is_raw) continue;
+        size_t votes = 0;
+
+        for(size_t j = 0; j < consensus->count; j++) {
+            XRemoteConsensusCapture* capture = &consensus->captures[j];
+            if(capture->is_raw && capture->size == consensus->captures[i].size) votes++;
+        }
+
+        if(votes > best_votes) {
+            best_votes = votes;
+            best_size = consensus->captures[i].size;
+        }
+    }
+
+    return best_size;
+}
+
+static size_t xremote_consensus_align(
+    XRemoteConsensusCapture* capture,
+    XRemoteConsensusCapture* reference,
+    size_t size) {
+    size_t shift_max = MIN(capture->size - size, (size_t)XREMOTE_CONSENSUS_SHIFT_MAX);
+    uint32_t best_error = UINT32_MAX;
+    size_t best_shift = 0;
+
+    /* Longer capture may start with junk, pick the shift closest to the reference.
+     * Odd shifts would line marks up with spaces, so pulses are skipped in pairs. */
+    for(size_t shift = 0; shift <= shift_max; shift += 2) {
+        uint32_t error = 0;
+
+        for(size_t i = 0; i < size; i++) {
+            int32_t diff = (int32_t)capture->timings[shift + i] - reference->timings[i];
+            error += diff < 0 ? -diff : diff;
+        }
+
+        if(error < best_error) {
+            best_error = error;
+            best_shift = shift;
+        }
+    }
+
+    return best_shift;
+}
+
+static bool xremote_consensus_build_raw(XRemoteConsensus* consensus, InfraredSignal* signal) {
+    size_t size = xremote_consensus_vote_size(consensus);
+    xremote_app_assert(size, false);
+
+    XRemoteConsensusCapture* aligned[XREMOTE_CONSENSUS_CAPTURES];
+    size_t shifts[XREMOTE_CONSENSUS_CAPTURES];
+    XRemoteConsensusCapture* reference = NULL;
+    size_t participants = 0;
+
+    for(size_t i = 0; i < consensus->count; i++) {
+        XRemoteConsensusCapture* capture = &consensus->captures[i];
+        if(!capture->is_raw || capture->size < size) continue;
+        if(reference == NULL && capture->size == size) reference = capture;
+    }
+
+    /* Shorter captures lost pulses and cannot be aligned without guessing */
+    for(size_t i = 0; i < consensus->count; i++) {
+        XRemoteConsensusCapture* capture = &consensus->captures[i];
+        if(!capture->is_raw || capture->size < size) continue;
+        shifts[participants] = xremote_consensus_align(capture, reference, size);
+        aligned[participants++] = capture;
+    }
+
+    size_t agree = 0;
+
+    for(size_t i = 0; i < size; i++) {
+        uint32_t values[XREMOTE_CONSENSUS_CAPTURES];
+
+        /* Insertion sort of at most five values gives the median */
+        for(size_t j = 0; j < participants; j++) {
+            uint32_t value = aligned[j]->timings[shifts[j] + i];
+            size_t k = j;
+
+            for(; k > 0 && values[k - 1] > value; k--) values[k] = values[k - 1];
+            values[k] = value;
+        }
+
+        uint32_t median = values[participants / 2];
+        uint32_t tolerance = median * XREMOTE_CONSENSUS_TOLERANCE / 100;
+        consensus->result[i] = median;
+
+        if(values[0] + tolerance >= median && values[participants - 1] <= median + tolerance)
+            agree++;
+    }
+
+    /* Quality is the share of captures used times the share of agreeing positions */
+    consensus->quality = (participants * agree * 100) / (consensus->count * size);
+
+    infrared_signal_set_raw_signal_ref(
+        signal, consensus->result, size, reference->frequency, reference->duty_cycle);
+
+    FURI_LOG_D(
+        TAG,
+        "raw consensus: %u of %u, quality: %u",
+        participants,
+        consensus->count,
+        consensus->quality);
+    return true;
+}
+
+bool xremote_consensus_build(XRemoteConsensus* consensus, InfraredSignal* signal) {
+    xremote_app_assert(consensus, false);
+    xremote_app_assert(consensus->count, false);
+
+    size_t best = 0;
+    size_t votes = xremote_consensus_vote_message(consensus, &best);
+
+    /* Majority of decoded captures wins, raw ones are counted as disagreeing */
+    if(votes && votes * 2 >= consensus->count) {
+        consensus->quality = votes * 100 / consensus->count;
+        infrared_signal_set_message(signal, &consensus->captures[best].message);
+        return true;
+    }
+
+    return xremote_consensus_build_raw(consensus, signal);
+}
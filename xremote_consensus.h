@@ -0,0 +1,34 @@
+/*!
+ *  @file flipper-xremote/xremote_consensus.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Consensus signal from multiple captures of the same button.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+#define XREMOTE_CONSENSUS_CAPTURES 5
+#define XREMOTE_CONSENSUS_TIMINGS  512
+
+/* Aligned timings agree when they are within percent of the median */
+#define XREMOTE_CONSENSUS_TOLERANCE 20
+
+/* Leading junk pulses which are skipped in mark and space pairs while aligning */
+#define XREMOTE_CONSENSUS_SHIFT_MAX 2
+
+typedef struct XRemoteConsensus XRemoteConsensus;
+
+XRemoteConsensus* xremote_consensus_alloc();
+void xremote_consensus_free(XRemoteConsensus* consensus);
+void xremote_consensus_reset(XRemoteConsensus* consensus);
+
+/* Raw capture longer than XREMOTE_CONSENSUS_TIMINGS is rejected and not counted */
+bool xremote_consensus_add(XRemoteConsensus* consensus, InfraredSignal* signal);
+size_t xremote_consensus_get_count(XRemoteConsensus* consensus);
+uint8_t xremote_consensus_get_quality(XRemoteConsensus* consensus);
+
+bool xremote_consensus_build(XRemoteConsensus* consensus, InfraredSignal* signal);
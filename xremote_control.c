@@ -8,6 +8,7 @@
 
 #include "xremote_control.h"
 #include "xremote_edit.h"
+#include "xremote_fit.h"
 #include "infrared/infrared_remote.h"
 
 #include "views/xremote_general_view.h"
@@ -31,10 +32,47 @@ static void xremote_buttons_clear_callback(void* context) {
     xremote_app_buttons_free((XRemoteAppButtons*)context);
 }
 
+static void xremote_control_fit_raw(XRemoteApp* app) {
+    XRemoteAppButtons* buttons = app->context;
+    size_t raw_count = 0;
+
+    /* Queued signals may reference the timings which are about to be replaced */
+    xremote_transmitter_flush(app->app_ctx->transmitter);
+
+    XRemoteFit* fit = xremote_fit_alloc();
+    size_t converted = xremote_fit_remote(fit, buttons->remote, &raw_count);
+    xremote_fit_free(fit);
+
+    if(converted) {
+        infrared_remote_store(buttons->remote);
+        xremote_app_extension_store(buttons, app->app_ctx->file_path);
+    }
+
+    char text[64];
+    snprintf(text, sizeof(text), "Converted %u of %u\nraw signals", converted, raw_count);
+
+    DialogsApp* dialogs = furi_record_open(RECORD_DIALOGS);
+    DialogMessage* message = dialog_message_alloc();
+
+    dialog_message_set_header(message, "Convert Raw", 64, 11, AlignCenter, AlignTop);
+    dialog_message_set_text(message, text, 64, 32, AlignCenter, AlignCenter);
+    dialog_message_set_buttons(message, NULL, "OK", NULL);
+    dialog_message_show(dialogs, message);
+
+    dialog_message_free(message);
+    furi_record_close(RECORD_DIALOGS);
+}
+
 static void xremote_control_submenu_callback(void* context, uint32_t index) {
     furi_assert(context);
     XRemoteApp* app = context;
 
+    /* Conversion runs in place and shows the result without a view */
+    if(index == XRemoteViewIRFitRaw) {
+        xremote_control_fit_raw(app);
+        return;
+    }
+
     /* Allocate new view based on selection */
     if(index == XRemoteViewIRGeneral)
         xremote_app_view_alloc(app, index, xremote_general_view_alloc);
@@ -81,6 +119,8 @@ XRemoteApp* xremote_control_alloc(XRemoteAppContext* app_ctx) {
         app, "Custom", XRemoteViewIRCustomPage, xremote_control_submenu_callback);
     xremote_app_submenu_add(
         app, "Edit", XRemoteViewIRCustomEditPage, xremote_control_submenu_callback);
+    xremote_app_submenu_add(
+        app, "Convert Raw", XRemoteViewIRFitRaw, xremote_control_submenu_callback);
 
     return app;
 }
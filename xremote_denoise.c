@@ -0,0 +1,160 @@
+/*!
+ *  @file flipper-xremote/xremote_denoise.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Timing clustering and denoising of the raw captures.
+ */
+
+#include "xremote_denoise.h"
+
+#define TAG "XRemoteDenoise"
+
+/* No cluster is assigned to the bin */
+#define XREMOTE_DENOISE_NONE 0xFF
+
+/* Marks and spaces are clustered separately, index 0 is mark and 1 is space */
+struct XRemoteDenoise {
+    uint16_t histogram[2][XREMOTE_DENOISE_BINS];
+    uint8_t bin_cluster[2][XREMOTE_DENOISE_BINS];
+    uint32_t sum[2][XREMOTE_DENOISE_CLUSTERS];
+    uint16_t count[2][XREMOTE_DENOISE_CLUSTERS];
+    size_t clusters[2];
+};
+
+XRemoteDenoise* xremote_denoise_alloc() {
+    XRemoteDenoise* denoise = malloc(sizeof(XRemoteDenoise));
+    xremote_app_assert(denoise, NULL);
+    return denoise;
+}
+
+void xremote_denoise_free(XRemoteDenoise* denoise) {
+    xremote_app_assert_void(denoise);
+    free(denoise);
+}
+
+static size_t xremote_denoise_trim(uint32_t* timings, size_t size) {
+    size_t start = 0;
+
+    /* Glitch or lone pulse before the frame is dropped with its space to keep the parity */
+    while(size - start > 2 && (timings[start] < XREMOTE_DENOISE_GLITCH_US ||
+                               timings[start + 1] >= XREMOTE_DENOISE_FRAME_GAP))
+        start += 2;
+
+    if(start) memmove(timings, &timings[start], (size - start) * sizeof(uint32_t));
+    return size - start;
+}
+
+static size_t xremote_denoise_merge(uint32_t* timings, size_t size) {
+    if(size < 3) return size;
+    size_t write = 1;
+
+    /* Short dropout splits one pulse in two, join them back with the dropout */
+    for(size_t read = 1; read < size; read++) {
+        if(timings[read] < XREMOTE_DENOISE_GLITCH_US && read + 1 < size) {
+            timings[write - 1] += timings[read] + timings[read + 1];
+            read++;
+            continue;
+        }
+
+        timings[write++] = timings[read];
+    }
+
+    return write;
+}
+
+static void xremote_denoise_cluster(XRemoteDenoise* denoise, size_t level) {
+    uint16_t* histogram = denoise->histogram[level];
+    uint8_t* bin_cluster = denoise->bin_cluster[level];
+    uint32_t first = 0;
+    size_t clusters = 0;
+
+    /* Neighbouring bins are merged while they stay within tolerance of the first one */
+    for(size_t bin = 0; bin < XREMOTE_DENOISE_BINS; bin++) {
+        bin_cluster[bin] = XREMOTE_DENOISE_NONE;
+        if(!histogram[bin]) continue;
+
+        uint32_t value = bin * XREMOTE_DENOISE_BIN_US;
+        uint32_t limit = first * (100 + XREMOTE_DENOISE_TOLERANCE) / 100 + XREMOTE_DENOISE_BIN_US;
+
+        if(!clusters || value > limit) {
+            if(clusters == XREMOTE_DENOISE_CLUSTERS) break;
+            denoise->sum[level][clusters] = 0;
+            denoise->count[level][clusters] = 0;
+            first = value;
+            clusters++;
+        }
+
+        bin_cluster[bin] = clusters - 1;
+    }
+
+    denoise->clusters[level] = clusters;
+}
+
+size_t xremote_denoise_raw(XRemoteDenoise* denoise, InfraredRawSignal* raw) {
+    xremote_app_assert(denoise, 0);
+    xremote_app_assert(raw, 0);
+
+    uint32_t* timings = raw->timings;
+    size_t size = xremote_denoise_trim(timings, raw->timings_size);
+    size = xremote_denoise_merge(timings, size);
+
+    /* Trailing space is the gap before the next repeat, it is bounded but not clustered */
+    size_t frame_size = size;
+    if(size > 1 && size % 2 == 0) {
+        timings[size - 1] = MIN(timings[size - 1], (uint32_t)XREMOTE_DENOISE_GAP_MAX);
+        frame_size--;
+    }
+
+    memset(denoise->histogram, 0, sizeof(denoise->histogram));
+
+    for(size_t i = 0; i < frame_size; i++) {
+        size_t bin = timings[i] / XREMOTE_DENOISE_BIN_US;
+        if(bin < XREMOTE_DENOISE_BINS) denoise->histogram[i & 1][bin]++;
+    }
+
+    xremote_denoise_cluster(denoise, 0);
+    xremote_denoise_cluster(denoise, 1);
+
+    /* Cluster centers are the mean of the actual timings, not of the bins */
+    for(size_t i = 0; i < frame_size; i++) {
+        size_t bin = timings[i] / XREMOTE_DENOISE_BIN_US;
+        if(bin >= XREMOTE_DENOISE_BINS) continue;
+
+        uint8_t cluster = denoise->bin_cluster[i & 1][bin];
+        if(cluster == XREMOTE_DENOISE_NONE) continue;
+
+        denoise->sum[i & 1][cluster] += timings[i];
+        denoise->count[i & 1][cluster]++;
+    }
+
+    for(size_t i = 0; i < frame_size; i++) {
+        size_t bin = timings[i] / XREMOTE_DENOISE_BIN_US;
+        if(bin >= XREMOTE_DENOISE_BINS) continue;
+
+        uint8_t cluster = denoise->bin_cluster[i & 1][bin];
+        if(cluster == XREMOTE_DENOISE_NONE) continue;
+
+        uint32_t count = denoise->count[i & 1][cluster];
+        timings[i] = (denoise->sum[i & 1][cluster] + count / 2) / count;
+    }
+
+    FURI_LOG_D(
+        TAG,
+        "timings: %u -> %u, clusters: %u/%u",
+        raw->timings_size,
+        size,
+        denoise->clusters[0],
+        denoise->clusters[1]);
+
+    raw->timings_size = size;
+    return size;
+}
+
+size_t xremote_denoise_signal(XRemoteDenoise* denoise, InfraredSignal* signal) {
+    xremote_app_assert(signal, 0);
+    if(!infrared_signal_is_raw(signal)) return 0;
+
+    InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+    return xremote_denoise_raw(denoise, raw);
+}
@@ -0,0 +1,36 @@
+/*!
+ *  @file flipper-xremote/xremote_denoise.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Timing clustering and denoising of the raw captures.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+/* Histogram of 50us bins covers timings up to 16ms, longer ones are kept as is */
+#define XREMOTE_DENOISE_BIN_US   50
+#define XREMOTE_DENOISE_BINS     320
+#define XREMOTE_DENOISE_CLUSTERS 16
+
+/* Bins within percent of the first bin of a cluster belong to the same cluster */
+#define XREMOTE_DENOISE_TOLERANCE 20
+
+/* Pulses shorter than this are receiver glitches and merged with their neighbours */
+#define XREMOTE_DENOISE_GLITCH_US 100
+
+/* Space which separates leading junk from the frame and maximum trailing gap */
+#define XREMOTE_DENOISE_FRAME_GAP 10000
+#define XREMOTE_DENOISE_GAP_MAX   150000
+
+typedef struct XRemoteDenoise XRemoteDenoise;
+
+XRemoteDenoise* xremote_denoise_alloc();
+void xremote_denoise_free(XRemoteDenoise* denoise);
+
+/* Cleans timings in place, the result is never longer than the input */
+size_t xremote_denoise_raw(XRemoteDenoise* denoise, InfraredRawSignal* raw);
+size_t xremote_denoise_signal(XRemoteDenoise* denoise, InfraredSignal* signal);
@@ -0,0 +1,275 @@
+/*!
+ *  @file flipper-xremote/xremote_diag.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Heap, stack and timing diagnostics of the running application.
+ */
+
+#include "xremote_diag.h"
+
+#include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
+
+#define TAG "XRemoteDiag"
+
+XRemoteDiag* xremote_diag_alloc() {
+    XRemoteDiag* diag = malloc(sizeof(XRemoteDiag));
+    memset(diag, 0, sizeof(XRemoteDiag));
+    return diag;
+}
+
+void xremote_diag_free(XRemoteDiag* diag) {
+    if(diag == NULL) return;
+    free(diag);
+}
+
+void xremote_diag_add_thread(XRemoteDiag* diag, const char* name, FuriThreadId id) {
+    if(diag == NULL || diag->thread_count >= XREMOTE_DIAG_THREADS_MAX) return;
+    diag->threads[diag->thread_count].name = name;
+    diag->threads[diag->thread_count].id = id;
+    diag->thread_count++;
+}
+
+void xremote_diag_remove_thread(XRemoteDiag* diag, FuriThreadId id) {
+    if(diag == NULL) return;
+
+    for(size_t i = 0; i < diag->thread_count; i++) {
+        if(diag->threads[i].id != id) continue;
+        diag->threads[i] = diag->threads[--diag->thread_count];
+        break;
+    }
+}
+
+void xremote_diag_set_remote(XRemoteDiag* diag, size_t buttons, size_t size) {
+    if(diag == NULL) return;
+    diag->remote_buttons = buttons;
+    diag->remote_size = size;
+}
+
+void xremote_diag_queue_depth(XRemoteDiag* diag, uint32_t depth) {
+    if(diag == NULL) return;
+    if(depth > diag->tx_depth_max) diag->tx_depth_max = depth;
+}
+
+void xremote_diag_queue_drop(XRemoteDiag* diag) {
+    if(diag == NULL) return;
+    diag->tx_dropped++;
+}
+
+void xremote_diag_cache_access(XRemoteDiag* diag, bool hit) {
+    if(diag == NULL) return;
+    if(hit)
+        diag->cache_hits++;
+    else
+        diag->cache_misses++;
+}
+
+uint32_t xremote_diag_start() {
+    return DWT->CYCCNT;
+}
+
+void xremote_diag_stop(XRemoteDiag* diag, XRemoteDiagStage stage, uint32_t start) {
+    if(diag == NULL || stage >= XRemoteDiagMax) return;
+
+    /* Cycle counter wraps around in ~67 seconds which is enough here */
+    uint32_t cycles = DWT->CYCCNT - start;
+    uint32_t elapsed_us = cycles / furi_hal_cortex_instructions_per_microsecond();
+
+    XRemoteDiagTiming* timing = &diag->timings[stage];
+    if(elapsed_us > timing->max_us) timing->max_us = elapsed_us;
+    timing->last_us = elapsed_us;
+    timing->count++;
+}
+
+#if XREMOTE_DIAG_LATENCY
+void xremote_diag_latency_begin(XRemoteDiag* diag) {
+    if(diag == NULL) return;
+    XRemoteLatency* latency = &diag->latency;
+
+    /* Fill the next trace first, the TX thread only marks the published one */
+    uint32_t head = latency->head + 1;
+    XRemoteLatencyTrace* trace = &latency->traces[head % XREMOTE_DIAG_LATENCY_TRACES];
+    trace->start = DWT->CYCCNT;
+    trace->marked = 0;
+
+    __atomic_store_n(&latency->head, head, __ATOMIC_RELEASE);
+}
+
+void xremote_diag_latency_mark(XRemoteDiag* diag, XRemoteLatencyStage stage) {
+    if(diag == NULL || stage >= XRemoteLatencyMax) return;
+    XRemoteLatency* latency = &diag->latency;
+
+    /* Each stage is marked once per press, repeats and held signals do not count.
+     * A queued signal of an older press may mark a newer trace, that is fine for
+     * debugging and keeps the hot path free of locks. */
+    uint32_t head = __atomic_load_n(&latency->head, __ATOMIC_ACQUIRE);
+    if(head == 0) return;
+
+    XRemoteLatencyTrace* trace = &latency->traces[head % XREMOTE_DIAG_LATENCY_TRACES];
+    if(trace->marked & (1UL << stage)) return;
+
+    uint32_t cycles = DWT->CYCCNT - trace->start;
+    trace->offsets_us[stage] = cycles / furi_hal_cortex_instructions_per_microsecond();
+    trace->marked |= 1UL << stage;
+}
+
+void xremote_diag_latency_stats(
+    XRemoteDiag* diag,
+    XRemoteLatencyStage stage,
+    XRemoteLatencyStats* stats) {
+    memset(stats, 0, sizeof(XRemoteLatencyStats));
+    if(diag == NULL || stage >= XRemoteLatencyMax) return;
+
+    XRemoteLatency* latency = &diag->latency;
+    uint32_t values[XREMOTE_DIAG_LATENCY_TRACES];
+    uint32_t count = MIN(latency->head, (uint32_t)XREMOTE_DIAG_LATENCY_TRACES);
+    uint64_t sum = 0;
+    size_t used = 0;
+
+    for(uint32_t i = 0; i < count; i++) {
+        XRemoteLatencyTrace* trace = &latency->traces[(latency->head - i) %
+                                                      XREMOTE_DIAG_LATENCY_TRACES];
+        if(!(trace->marked & (1UL << stage))) continue;
+
+        /* Insertion sort keeps the values ordered for the percentile */
+        uint32_t value = trace->offsets_us[stage];
+        size_t j = used++;
+
+        for(; j > 0 && values[j - 1] > value; j--) values[j] = values[j - 1];
+        values[j] = value;
+        sum += value;
+    }
+
+    if(!used) return;
+    stats->count = used;
+    stats->min_us = values[0];
+    stats->avg_us = sum / used;
+    stats->p95_us = values[(used * 95 + 99) / 100 - 1];
+}
+
+const char* xremote_diag_get_latency_str(XRemoteLatencyStage stage) {
+    if(stage == XRemoteLatencyInput) return "Inp";
+    if(stage == XRemoteLatencyLookup) return "Find";
+    if(stage == XRemoteLatencyDeed) return "Deed";
+    if(stage == XRemoteLatencyTxStart) return "Tx";
+    if(stage == XRemoteLatencyTxEnd) return "Sent";
+    if(stage == XRemoteLatencyNotify) return "Led";
+    return "";
+}
+
+void xremote_diag_format_latency(char* text, size_t length, uint32_t time_us) {
+    /* Milliseconds in at most three characters to fit the narrow columns */
+    if(time_us < 10000)
+        snprintf(text, length, "%lu.%lu", time_us / 1000, (time_us % 1000) / 100);
+    else
+        snprintf(text, length, "%lu", time_us / 1000);
+}
+#endif
+
+const char* xremote_diag_get_stage_str(XRemoteDiagStage stage) {
+    if(stage == XRemoteDiagLoad) return "Load";
+    if(stage == XRemoteDiagLookup) return "Find";
+    if(stage == XRemoteDiagTransmit) return "Send";
+    if(stage == XRemoteDiagEncode) return "Enc";
+    return "";
+}
+
+void xremote_diag_format_size(char* text, size_t length, size_t size) {
+    if(size < 1024)
+        snprintf(text, length, "%uB", size);
+    else
+        snprintf(text, length, "%u.%uK", size / 1024, (size % 1024) * 10 / 1024);
+}
+
+void xremote_diag_format_time(char* text, size_t length, uint32_t time_us) {
+    if(time_us < 10000)
+        snprintf(text, length, "%luus", time_us);
+    else
+        snprintf(text, length, "%lums", time_us / 1000);
+}
+
+bool xremote_diag_store(XRemoteDiag* diag) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+
+    FURI_LOG_I(TAG, "store diagnostics file: \'%s\'", XREMOTE_DIAG_FILE);
+    bool success = false;
+
+    do {
+        /* Write header in diagnostics file */
+        if(!flipper_format_file_open_always(ff, XREMOTE_DIAG_FILE)) break;
+        if(!flipper_format_write_header_cstr(ff, "XRemote Diagnostics", 1)) break;
+        if(!flipper_format_write_comment_cstr(ff, "Heap and remote sizes in bytes")) break;
+
+        uint32_t value = memmgr_get_free_heap();
+        if(!flipper_format_write_uint32(ff, "heap_free", &value, 1)) break;
+
+        value = memmgr_get_minimum_free_heap();
+        if(!flipper_format_write_uint32(ff, "heap_min", &value, 1)) break;
+
+        value = memmgr_heap_get_max_free_block();
+        if(!flipper_format_write_uint32(ff, "heap_max_block", &value, 1)) break;
+
+        value = diag->remote_size;
+        if(!flipper_format_write_uint32(ff, "remote_size", &value, 1)) break;
+
+        value = diag->remote_buttons;
+        if(!flipper_format_write_uint32(ff, "remote_buttons", &value, 1)) break;
+
+        /* Transmit queue high-water mark and signals dropped on overflow */
+        if(!flipper_format_write_uint32(ff, "tx_queue_max", &diag->tx_depth_max, 1)) break;
+        if(!flipper_format_write_uint32(ff, "tx_dropped", &diag->tx_dropped, 1)) break;
+
+        /* Pre-encoded transmit cache efficiency */
+        if(!flipper_format_write_uint32(ff, "cache_hits", &diag->cache_hits, 1)) break;
+        if(!flipper_format_write_uint32(ff, "cache_misses", &diag->cache_misses, 1)) break;
+
+        /* Stack watermarks are the minimum free stack space ever seen */
+        if(!flipper_format_write_comment_cstr(ff, "Minimum free stack in bytes")) break;
+        size_t i;
+
+        for(i = 0; i < diag->thread_count; i++) {
+            value = furi_thread_get_stack_space(diag->threads[i].id);
+            if(!flipper_format_write_uint32(ff, diag->threads[i].name, &value, 1)) break;
+        }
+
+        if(i < diag->thread_count) break;
+
+        /* Timings are written as last, max and sample count */
+        if(!flipper_format_write_comment_cstr(ff, "Timings: last_us, max_us, count")) break;
+
+        for(i = 0; i < XRemoteDiagMax; i++) {
+            XRemoteDiagTiming* timing = &diag->timings[i];
+            uint32_t values[3] = {timing->last_us, timing->max_us, timing->count};
+            if(!flipper_format_write_uint32(ff, xremote_diag_get_stage_str(i), values, 3)) break;
+        }
+
+        if(i < XRemoteDiagMax) break;
+
+#if XREMOTE_DIAG_LATENCY
+        /* Press to transmit latency over the last traces */
+        const char* keys[XRemoteLatencyMax] = {
+            "lat_input", "lat_lookup", "lat_deed", "lat_tx_start", "lat_tx_end", "lat_notify"};
+
+        if(!flipper_format_write_comment_cstr(ff, "Latency: min_us, avg_us, p95_us, count"))
+            break;
+
+        for(i = 0; i < XRemoteLatencyMax; i++) {
+            XRemoteLatencyStats stats;
+            xremote_diag_latency_stats(diag, i, &stats);
+            uint32_t values[4] = {stats.min_us, stats.avg_us, stats.p95_us, stats.count};
+            if(!flipper_format_write_uint32(ff, keys[i], values, 4)) break;
+        }
+
+        if(i < XRemoteLatencyMax) break;
+#endif
+
+        success = true;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(ff);
+
+    return success;
+}
@@ -0,0 +1,123 @@
+/*!
+ *  @file flipper-xremote/xremote_diag.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Heap, stack and timing diagnostics of the running application.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <furi_hal.h>
+
+#define XREMOTE_DIAG_FILE        APP_DATA_PATH("diagnostics.txt")
+#define XREMOTE_DIAG_THREADS_MAX 3
+
+/* Press to transmit latency tracing, set to 0 to compile it out completely */
+#ifndef XREMOTE_DIAG_LATENCY
+#define XREMOTE_DIAG_LATENCY 1
+#endif
+
+#define XREMOTE_DIAG_LATENCY_TRACES 32
+
+typedef enum {
+    XRemoteDiagLoad,
+    XRemoteDiagLookup,
+    XRemoteDiagTransmit,
+    XRemoteDiagEncode,
+    XRemoteDiagMax
+} XRemoteDiagStage;
+
+typedef enum {
+    XRemoteLatencyInput,
+    XRemoteLatencyLookup,
+    XRemoteLatencyDeed,
+    XRemoteLatencyTxStart,
+    XRemoteLatencyTxEnd,
+    XRemoteLatencyNotify,
+    XRemoteLatencyMax
+} XRemoteLatencyStage;
+
+typedef struct {
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p95_us;
+    uint32_t count;
+} XRemoteLatencyStats;
+
+#if XREMOTE_DIAG_LATENCY
+/* Stage offsets are relative to the input event arrival, or the receive when translating */
+typedef struct {
+    uint32_t start;
+    uint32_t offsets_us[XRemoteLatencyMax];
+    uint32_t marked;
+} XRemoteLatencyTrace;
+
+typedef struct {
+    XRemoteLatencyTrace traces[XREMOTE_DIAG_LATENCY_TRACES];
+    uint32_t head;
+} XRemoteLatency;
+
+#define XREMOTE_LATENCY_BEGIN(diag)       xremote_diag_latency_begin(diag)
+#define XREMOTE_LATENCY_MARK(diag, stage) xremote_diag_latency_mark(diag, stage)
+#else
+#define XREMOTE_LATENCY_BEGIN(diag)
+#define XREMOTE_LATENCY_MARK(diag, stage)
+#endif
+
+typedef struct {
+    uint32_t last_us;
+    uint32_t max_us;
+    uint32_t count;
+} XRemoteDiagTiming;
+
+typedef struct {
+    const char* name;
+    FuriThreadId id;
+} XRemoteDiagThread;
+
+typedef struct {
+    XRemoteDiagThread threads[XREMOTE_DIAG_THREADS_MAX];
+    XRemoteDiagTiming timings[XRemoteDiagMax];
+    size_t thread_count;
+    size_t remote_buttons;
+    size_t remote_size;
+    uint32_t tx_depth_max;
+    uint32_t tx_dropped;
+    uint32_t cache_hits;
+    uint32_t cache_misses;
+#if XREMOTE_DIAG_LATENCY
+    XRemoteLatency latency;
+#endif
+} XRemoteDiag;
+
+XRemoteDiag* xremote_diag_alloc();
+void xremote_diag_free(XRemoteDiag* diag);
+
+void xremote_diag_add_thread(XRemoteDiag* diag, const char* name, FuriThreadId id);
+void xremote_diag_remove_thread(XRemoteDiag* diag, FuriThreadId id);
+void xremote_diag_set_remote(XRemoteDiag* diag, size_t buttons, size_t size);
+void xremote_diag_queue_depth(XRemoteDiag* diag, uint32_t depth);
+void xremote_diag_queue_drop(XRemoteDiag* diag);
+void xremote_diag_cache_access(XRemoteDiag* diag, bool hit);
+
+uint32_t xremote_diag_start();
+void xremote_diag_stop(XRemoteDiag* diag, XRemoteDiagStage stage, uint32_t start);
+
+#if XREMOTE_DIAG_LATENCY
+void xremote_diag_latency_begin(XRemoteDiag* diag);
+void xremote_diag_latency_mark(XRemoteDiag* diag, XRemoteLatencyStage stage);
+void xremote_diag_latency_stats(
+    XRemoteDiag* diag,
+    XRemoteLatencyStage stage,
+    XRemoteLatencyStats* stats);
+const char* xremote_diag_get_latency_str(XRemoteLatencyStage stage);
+void xremote_diag_format_latency(char* text, size_t length, uint32_t time_us);
+#endif
+
+const char* xremote_diag_get_stage_str(XRemoteDiagStage stage);
+void xremote_diag_format_size(char* text, size_t length, size_t size);
+void xremote_diag_format_time(char* text, size_t length, uint32_t time_us);
+
+bool xremote_diag_store(XRemoteDiag* diag);
@@ -0,0 +1,119 @@
+/*!
+ *  @file flipper-xremote/xremote_diff.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Position by position comparison of two captured signals.
+ */
+
+#include "xremote_diff.h"
+
+static void xremote_diff_reset(XRemoteDiff* diff, bool is_raw) {
+    memset(diff->bitmap, 0, sizeof(diff->bitmap));
+    diff->positions = 0;
+    diff->differing = 0;
+    diff->is_raw = is_raw;
+    diff->protocol_differs = false;
+    diff->size_a = 0;
+    diff->size_b = 0;
+    diff->max_position = 0;
+    diff->max_delta = 0;
+    diff->truncated = false;
+    diff->offset = 0;
+}
+
+static void xremote_diff_set(XRemoteDiff* diff, size_t position) {
+    diff->bitmap[position / 32] |= 1UL << (position % 32);
+    diff->differing++;
+}
+
+bool xremote_diff_raw(
+    XRemoteDiff* diff,
+    const InfraredRawSignal* a,
+    const InfraredRawSignal* b) {
+    xremote_app_assert(diff, false);
+    xremote_diff_reset(diff, true);
+
+    size_t common = MIN(a->timings_size, b->timings_size);
+    size_t longest = MAX(a->timings_size, b->timings_size);
+
+    diff->size_a = a->timings_size;
+    diff->size_b = b->timings_size;
+    diff->positions = MIN(longest, (size_t)XREMOTE_DIFF_POSITIONS);
+    diff->truncated = longest > XREMOTE_DIFF_POSITIONS;
+
+    /* Single pass, positions missing in the shorter capture always differ */
+    for(size_t i = 0; i < diff->positions; i++) {
+        if(i >= common) {
+            xremote_diff_set(diff, i);
+            continue;
+        }
+
+        uint32_t high = MAX(a->timings[i], b->timings[i]);
+        uint32_t delta = high - MIN(a->timings[i], b->timings[i]);
+        uint32_t tolerance = MAX(high * XREMOTE_DIFF_TOLERANCE / 100, XREMOTE_DIFF_TOLERANCE_MIN);
+
+        if(delta > diff->max_delta) {
+            diff->max_delta = delta;
+            diff->max_position = i;
+        }
+
+        if(delta > tolerance) xremote_diff_set(diff, i);
+    }
+
+    return true;
+}
+
+bool xremote_diff_messages(XRemoteDiff* diff, const InfraredMessage* a, const InfraredMessage* b) {
+    xremote_app_assert(diff, false);
+    xremote_diff_reset(diff, false);
+
+    uint32_t address = a->address ^ b->address;
+    uint32_t command = a->command ^ b->command;
+
+    diff->positions = XREMOTE_DIFF_MESSAGE_BITS;
+    diff->protocol_differs = a->protocol != b->protocol;
+
+    for(size_t i = 0; i < 32; i++) {
+        if(address & (1UL << i)) xremote_diff_set(diff, i);
+        if(command & (1UL << i)) xremote_diff_set(diff, 32 + i);
+    }
+
+    return true;
+}
+
+bool xremote_diff_signals(XRemoteDiff* diff, InfraredSignal* a, InfraredSignal* b) {
+    xremote_app_assert(diff, false);
+    bool is_raw = infrared_signal_is_raw(a);
+
+    /* Raw capture and decoded message have nothing to compare position by position */
+    if(is_raw != infrared_signal_is_raw(b)) return false;
+
+    if(is_raw) {
+        return xremote_diff_raw(
+            diff, infrared_signal_get_raw_signal(a), infrared_signal_get_raw_signal(b));
+    }
+
+    return xremote_diff_messages(
+        diff, infrared_signal_get_message(a), infrared_signal_get_message(b));
+}
+
+bool xremote_diff_test(const XRemoteDiff* diff, size_t position) {
+    xremote_app_assert(diff, false);
+    if(position >= diff->positions) return false;
+    return diff->bitmap[position / 32] & (1UL << (position % 32));
+}
+
+int xremote_diff_find(const XRemoteDiff* diff, size_t position, bool forward) {
+    xremote_app_assert(diff, -1);
+
+    if(forward) {
+        for(size_t i = position + 1; i < diff->positions; i++)
+            if(xremote_diff_test(diff, i)) return i;
+    } else {
+        for(size_t i = MIN(position, diff->positions); i > 0; i--)
+            if(xremote_diff_test(diff, i - 1)) return i - 1;
+    }
+
+    return -1;
+}
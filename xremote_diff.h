@@ -0,0 +1,53 @@
+/*!
+ *  @file flipper-xremote/xremote_diff.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Position by position comparison of two captured signals.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+/* One bit per compared position, receiver never captures more timings */
+#define XREMOTE_DIFF_POSITIONS 1024
+
+/* Address bits are positions 0-31 and command bits 32-63 of a parsed message */
+#define XREMOTE_DIFF_MESSAGE_BITS 64
+
+/* Timings differ when apart more than percent of the longer one or minimum microseconds */
+#define XREMOTE_DIFF_TOLERANCE     20
+#define XREMOTE_DIFF_TOLERANCE_MIN 100
+
+typedef struct {
+    uint32_t bitmap[XREMOTE_DIFF_POSITIONS / 32];
+    size_t positions;
+    size_t differing;
+    bool is_raw;
+
+    /* Parsed messages, protocol is compared as a whole */
+    bool protocol_differs;
+
+    /* Raw captures, the longest one may have more positions than the bitmap */
+    size_t size_a;
+    size_t size_b;
+    size_t max_position;
+    uint32_t max_delta;
+    bool truncated;
+
+    /* First visible position of the diff view */
+    size_t offset;
+} XRemoteDiff;
+
+bool xremote_diff_raw(
+    XRemoteDiff* diff,
+    const InfraredRawSignal* a,
+    const InfraredRawSignal* b);
+bool xremote_diff_messages(XRemoteDiff* diff, const InfraredMessage* a, const InfraredMessage* b);
+bool xremote_diff_signals(XRemoteDiff* diff, InfraredSignal* a, InfraredSignal* b);
+
+bool xremote_diff_test(const XRemoteDiff* diff, size_t position);
+/* Next or previous differing position from the given one, negative when there is none */
+int xremote_diff_find(const XRemoteDiff* diff, size_t position, bool forward);
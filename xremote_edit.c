@@ -24,72 +24,62 @@ static void xremote_edit_buttons_store(XRemoteAppButtons* buttons) {
     xremote_app_extension_store(buttons, path);
 }
 
-static void xremote_item_update_item(VariableItem* item, FuriString* button) {
+static void xremote_item_update_item(VariableItem* item, XRemoteCustomKey key) {
     XRemoteEditContext* ctx = variable_item_get_context(item);
     XRemoteAppButtons* buttons = ctx->buttons;
 
-    int button_index = variable_item_get_current_value_index(item);
-    const char* button_name = xremote_button_get_name(button_index);
-    variable_item_set_current_value_text(item, button_name);
+    uint8_t button_index = variable_item_get_current_value_index(item);
+    xremote_app_buttons_set_custom(buttons, key, button_index);
 
-    furi_string_set_str(button, button_name);
+    const char* button_name = xremote_app_buttons_get_custom_name(buttons, key);
+    variable_item_set_current_value_text(item, button_name);
     xremote_edit_buttons_store(buttons);
 }
 
 static void xremote_edit_ok_press_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_ok);
+    xremote_item_update_item(item, XRemoteCustomOk);
 }
 
 static void xremote_edit_up_press_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_up);
+    xremote_item_update_item(item, XRemoteCustomUp);
 }
 
 static void xremote_edit_down_press_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_down);
+    xremote_item_update_item(item, XRemoteCustomDown);
 }
 
 static void xremote_edit_left_press_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_left);
+    xremote_item_update_item(item, XRemoteCustomLeft);
 }
 
 static void xremote_edit_right_press_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_right);
+    xremote_item_update_item(item, XRemoteCustomRight);
 }
 
 static void xremote_edit_ok_hold_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_ok_hold);
+    xremote_item_update_item(item, XRemoteCustomOkHold);
 }
 
 static void xremote_edit_up_hold_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_up_hold);
+    xremote_item_update_item(item, XRemoteCustomUpHold);
 }
 
 static void xremote_edit_down_hold_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_down_hold);
+    xremote_item_update_item(item, XRemoteCustomDownHold);
 }
 
 static void xremote_edit_left_hold_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_left_hold);
+    xremote_item_update_item(item, XRemoteCustomLeftHold);
 }
 
 static void xremote_edit_right_hold_changed(VariableItem* item) {
-    XRemoteEditContext* ctx = variable_item_get_context(item);
-    xremote_item_update_item(item, ctx->buttons->custom_right_hold);
+    xremote_item_update_item(item, XRemoteCustomRightHold);
 }
 
 static void xremote_edit_list_add_item(
     XRemoteEditContext* context,
     const char* item_name,
-    FuriString* button,
+    XRemoteCustomKey key,
     VariableItemChangeCallback change_callback) {
     VariableItemList* list = context->item_list;
     VariableItem* item;
@@ -98,8 +88,8 @@ static void xremote_edit_list_add_item(
     item = variable_item_list_add(list, item_name, XREMOTE_BUTTON_COUNT, change_callback, context);
 
     /* Get button name and index */
-    const char* button_name = furi_string_get_cstr(button);
-    uint32_t button_index = xremote_button_get_index(button_name);
+    uint8_t button_index = context->buttons->custom_commands[key];
+    const char* button_name = xremote_app_buttons_get_custom_name(context->buttons, key);
 
     /* Set button name and index to the list item */
     variable_item_set_current_value_index(item, button_index);
@@ -120,25 +110,25 @@ static XRemoteEditContext* xremote_edit_context_alloc(XRemoteAppButtons* buttons
 
     /* Add press items to the variable list */
     xremote_edit_list_add_item(
-        context, "Ok press", buttons->custom_ok, xremote_edit_ok_press_changed);
+        context, "Ok press", XRemoteCustomOk, xremote_edit_ok_press_changed);
     xremote_edit_list_add_item(
-        context, "Up press", buttons->custom_up, xremote_edit_up_press_changed);
+        context, "Up press", XRemoteCustomUp, xremote_edit_up_press_changed);
     xremote_edit_list_add_item(
-        context, "Down press", buttons->custom_down, xremote_edit_down_press_changed);
+        context, "Down press", XRemoteCustomDown, xremote_edit_down_press_changed);
     xremote_edit_list_add_item(
-        context, "Left press", buttons->custom_left, xremote_edit_left_press_changed);
+        context, "Left press", XRemoteCustomLeft, xremote_edit_left_press_changed);
     xremote_edit_list_add_item(
-        context, "Right press", buttons->custom_right, xremote_edit_right_press_changed);
+        context, "Right press", XRemoteCustomRight, xremote_edit_right_press_changed);
     xremote_edit_list_add_item(
-        context, "Ok hold", buttons->custom_ok_hold, xremote_edit_ok_hold_changed);
+        context, "Ok hold", XRemoteCustomOkHold, xremote_edit_ok_hold_changed);
     xremote_edit_list_add_item(
-        context, "Up hold", buttons->custom_up_hold, xremote_edit_up_hold_changed);
+        context, "Up hold", XRemoteCustomUpHold, xremote_edit_up_hold_changed);
     xremote_edit_list_add_item(
-        context, "Down hold", buttons->custom_down_hold, xremote_edit_down_hold_changed);
+        context, "Down hold", XRemoteCustomDownHold, xremote_edit_down_hold_changed);
     xremote_edit_list_add_item(
-        context, "Left hold", buttons->custom_left_hold, xremote_edit_left_hold_changed);
+        context, "Left hold", XRemoteCustomLeftHold, xremote_edit_left_hold_changed);
     xremote_edit_list_add_item(
-        context, "Right hold", buttons->custom_right_hold, xremote_edit_right_hold_changed);
+        context, "Right hold", XRemoteCustomRightHold, xremote_edit_right_hold_changed);
 
     return context;
 }
@@ -0,0 +1,70 @@
+/*!
+ *  @file flipper-xremote/xremote_fingerprint.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Short hashes identifying the same code across captures.
+ */
+
+#include "xremote_fingerprint.h"
+
+#define XREMOTE_FINGERPRINT_BASIS 2166136261UL
+#define XREMOTE_FINGERPRINT_PRIME 16777619UL
+
+typedef enum {
+    XRemoteFingerprintShorter,
+    XRemoteFingerprintEqual,
+    XRemoteFingerprintLonger,
+    XRemoteFingerprintMessage
+} XRemoteFingerprintSymbol;
+
+static uint32_t xremote_fingerprint_mix(uint32_t hash, uint32_t value) {
+    for(size_t i = 0; i < sizeof(value); i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= XREMOTE_FINGERPRINT_PRIME;
+    }
+
+    return hash;
+}
+
+static XRemoteFingerprintSymbol xremote_fingerprint_compare(uint32_t prev, uint32_t next) {
+    uint64_t scaled_prev = (uint64_t)prev * (100 - XREMOTE_FINGERPRINT_TOLERANCE);
+    uint64_t scaled_next = (uint64_t)next * (100 - XREMOTE_FINGERPRINT_TOLERANCE);
+
+    if((uint64_t)next * 100 < scaled_prev) return XRemoteFingerprintShorter;
+    if((uint64_t)prev * 100 < scaled_next) return XRemoteFingerprintLonger;
+    return XRemoteFingerprintEqual;
+}
+
+uint32_t xremote_fingerprint_message(const InfraredMessage* message) {
+    xremote_app_assert(message, 0);
+    uint32_t hash = xremote_fingerprint_mix(XREMOTE_FINGERPRINT_BASIS, XRemoteFingerprintMessage);
+    hash = xremote_fingerprint_mix(hash, message->protocol);
+    hash = xremote_fingerprint_mix(hash, message->address);
+    return xremote_fingerprint_mix(hash, message->command);
+}
+
+uint32_t xremote_fingerprint_raw(const uint32_t* timings, size_t size) {
+    xremote_app_assert(timings, 0);
+
+    /* Trailing space is the repeat gap of a compacted capture and not part of the code */
+    if(size && !(size % 2)) size--;
+    uint32_t hash = XREMOTE_FINGERPRINT_BASIS;
+
+    /* Every mark is compared with the previous mark and every space with the previous space */
+    for(size_t i = 2; i < size; i++) {
+        hash ^= xremote_fingerprint_compare(timings[i - 2], timings[i]);
+        hash *= XREMOTE_FINGERPRINT_PRIME;
+    }
+
+    return xremote_fingerprint_mix(hash, size);
+}
+
+uint32_t xremote_fingerprint_signal(InfraredSignal* signal) {
+    xremote_app_assert(signal, 0);
+    if(!infrared_signal_is_raw(signal))
+        return xremote_fingerprint_message(infrared_signal_get_message(signal));
+
+    InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+    return xremote_fingerprint_raw(raw->timings, raw->timings_size);
+}
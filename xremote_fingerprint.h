@@ -0,0 +1,22 @@
+/*!
+ *  @file flipper-xremote/xremote_fingerprint.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Short hashes identifying the same code across captures.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+/* Timing is shorter or longer than the previous one of its level when apart more than percent */
+#define XREMOTE_FINGERPRINT_TOLERANCE 20
+
+/* Parsed messages hash the protocol, address and command, repeat flag is ignored */
+uint32_t xremote_fingerprint_message(const InfraredMessage* message);
+
+/* Raw timings hash only their shape, so jitter between captures keeps the same value */
+uint32_t xremote_fingerprint_raw(const uint32_t* timings, size_t size);
+uint32_t xremote_fingerprint_signal(InfraredSignal* signal);
@@ -0,0 +1,187 @@
+/*!
+ *  @file flipper-xremote/xremote_fit.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Fitting of raw captures to the known infrared protocols.
+ */
+
+#include "xremote_fit.h"
+
+#define TAG "XRemoteFit"
+
+/* Mark skew in microseconds and timing scale in per mille */
+typedef struct {
+    int32_t skew;
+    uint32_t scale;
+} XRemoteFitTransform;
+
+struct XRemoteFit {
+    InfraredDecoderHandler* decoder;
+    uint32_t* timings;
+};
+
+XRemoteFit* xremote_fit_alloc() {
+    XRemoteFit* fit = malloc(sizeof(XRemoteFit));
+    xremote_app_assert(fit, NULL);
+
+    fit->decoder = infrared_alloc_decoder();
+    fit->timings = malloc(XREMOTE_FIT_TIMINGS * sizeof(uint32_t));
+    return fit;
+}
+
+void xremote_fit_free(XRemoteFit* fit) {
+    xremote_app_assert_void(fit);
+    infrared_free_decoder(fit->decoder);
+    free(fit->timings);
+    free(fit);
+}
+
+static uint32_t xremote_fit_apply(const XRemoteFitTransform* tf, uint32_t timing, bool mark) {
+    int64_t value = mark ? (int64_t)timing - tf->skew : (int64_t)timing + tf->skew;
+    value = value * tf->scale / 1000;
+    return value > 1 ? value : 1;
+}
+
+static size_t xremote_fit_frame_size(const uint32_t* timings, size_t size) {
+    /* Frame ends at the first long space, repeats and trailing gap are not compared */
+    for(size_t i = 1; i < size; i += 2)
+        if(timings[i] >= XREMOTE_FIT_FRAME_GAP) return i;
+    return size;
+}
+
+static int32_t xremote_fit_estimate_skew(const InfraredRawSignal* raw) {
+    size_t size = xremote_fit_frame_size(raw->timings, raw->timings_size);
+    uint32_t min[2] = {UINT32_MAX, UINT32_MAX};
+    uint32_t sum[2] = {0, 0};
+    uint32_t count[2] = {0, 0};
+
+    /* Receivers stretch marks and shrink spaces by about the same amount */
+    for(size_t i = 0; i < size; i++) min[i & 1] = MIN(min[i & 1], raw->timings[i]);
+
+    for(size_t i = 0; i < size; i++) {
+        uint32_t timing = raw->timings[i];
+        if(timing > min[i & 1] * 3 / 2) continue;
+        sum[i & 1] += timing;
+        count[i & 1]++;
+    }
+
+    /* Shortest mark and space are the same unit in every supported protocol */
+    if(!count[0] || !count[1]) return 0;
+    return ((int32_t)(sum[0] / count[0]) - (int32_t)(sum[1] / count[1])) / 2;
+}
+
+static bool xremote_fit_decode(
+    XRemoteFit* fit,
+    const InfraredRawSignal* raw,
+    const XRemoteFitTransform* tf,
+    InfraredMessage* message) {
+    const InfraredMessage* decoded = NULL;
+    infrared_reset_decoder(fit->decoder);
+
+    for(size_t i = 0; i < raw->timings_size; i++) {
+        bool mark = !(i & 1);
+        uint32_t timing = xremote_fit_apply(tf, raw->timings[i], mark);
+
+        decoded = infrared_decode(fit->decoder, mark, timing);
+        if(decoded != NULL && !decoded->repeat) break;
+    }
+
+    if(decoded == NULL || decoded->repeat) decoded = infrared_check_decoder_ready(fit->decoder);
+    xremote_app_assert((decoded && !decoded->repeat), false);
+
+    *message = *decoded;
+    return true;
+}
+
+static bool xremote_fit_verify(
+    XRemoteFit* fit,
+    const InfraredRawSignal* raw,
+    const XRemoteFitTransform* tf,
+    const InfraredMessage* message) {
+    uint32_t frequency = infrared_get_protocol_frequency(message->protocol);
+    uint32_t delta = raw->frequency > frequency ? raw->frequency - frequency :
+                                                  frequency - raw->frequency;
+    xremote_app_assert((delta <= XREMOTE_FIT_FREQUENCY_MAX), false);
+
+    size_t size =
+        infrared_signal_encode_message(message, 1, fit->timings, XREMOTE_FIT_TIMINGS);
+    xremote_app_assert(size, false);
+
+    /* Decoder may accept a prefix, the whole frame has to be explained */
+    size_t frame_size = xremote_fit_frame_size(fit->timings, size);
+    if(frame_size != xremote_fit_frame_size(raw->timings, raw->timings_size)) return false;
+
+    for(size_t i = 0; i < frame_size; i++) {
+        uint32_t expected = fit->timings[i];
+        uint32_t actual = xremote_fit_apply(tf, raw->timings[i], !(i & 1));
+        uint32_t diff = expected > actual ? expected - actual : actual - expected;
+        if(diff > MAX(expected * XREMOTE_FIT_TOLERANCE / 100, XREMOTE_FIT_TOLERANCE_MIN))
+            return false;
+    }
+
+    return true;
+}
+
+bool xremote_fit_raw(XRemoteFit* fit, const InfraredRawSignal* raw, InfraredMessage* message) {
+    xremote_app_assert(fit, false);
+    xremote_app_assert((raw && raw->timings_size), false);
+
+    /* Normalized timings first, then the capture as is and slower or faster clocks */
+    int32_t skew = xremote_fit_estimate_skew(raw);
+    const XRemoteFitTransform transforms[] = {
+        {skew, 1000},
+        {0, 1000},
+        {skew, 920},
+        {skew, 1080},
+    };
+
+    for(size_t i = 0; i < COUNT_OF(transforms); i++) {
+        if(i == 1 && skew == 0) continue;
+        if(!xremote_fit_decode(fit, raw, &transforms[i], message)) continue;
+        if(!xremote_fit_verify(fit, raw, &transforms[i], message)) continue;
+
+        FURI_LOG_D(
+            TAG,
+            "fitted %s 0x%lX 0x%lX, skew: %ld, scale: %lu",
+            infrared_get_protocol_name(message->protocol),
+            message->address,
+            message->command,
+            transforms[i].skew,
+            transforms[i].scale);
+
+        return true;
+    }
+
+    return false;
+}
+
+bool xremote_fit_signal(XRemoteFit* fit, InfraredSignal* signal) {
+    xremote_app_assert(signal, false);
+    xremote_app_assert(infrared_signal_is_raw(signal), false);
+
+    InfraredMessage message;
+    InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+    xremote_app_assert(xremote_fit_raw(fit, raw, &message), false);
+
+    /* Compact message replaces the timings of the capture */
+    infrared_signal_set_message(signal, &message);
+    return true;
+}
+
+size_t xremote_fit_remote(XRemoteFit* fit, InfraredRemote* remote, size_t* raw_count) {
+    size_t count = infrared_remote_get_button_count(remote);
+    size_t converted = 0;
+    *raw_count = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        InfraredRemoteButton* button = infrared_remote_get_button(remote, i);
+        InfraredSignal* signal = infrared_remote_button_get_signal(button);
+        if(!infrared_signal_is_raw(signal)) continue;
+
+        (*raw_count)++;
+        if(xremote_fit_signal(fit, signal)) converted++;
+    }
+
+    return converted;
+}
@@ -0,0 +1,32 @@
+/*!
+ *  @file flipper-xremote/xremote_fit.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Fitting of raw captures to the known infrared protocols.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_remote.h"
+
+/* Scratch space for the re-encoded frame used to verify a fitted message */
+#define XREMOTE_FIT_TIMINGS 512
+
+/* Re-encoded timings must match the capture within percent or minimum microseconds */
+#define XREMOTE_FIT_TOLERANCE     25
+#define XREMOTE_FIT_TOLERANCE_MIN 120
+
+/* Space which ends a frame and maximum carrier difference from the protocol */
+#define XREMOTE_FIT_FRAME_GAP     10000
+#define XREMOTE_FIT_FREQUENCY_MAX 2000
+
+typedef struct XRemoteFit XRemoteFit;
+
+XRemoteFit* xremote_fit_alloc();
+void xremote_fit_free(XRemoteFit* fit);
+
+bool xremote_fit_raw(XRemoteFit* fit, const InfraredRawSignal* raw, InfraredMessage* message);
+bool xremote_fit_signal(XRemoteFit* fit, InfraredSignal* signal);
+size_t xremote_fit_remote(XRemoteFit* fit, InfraredRemote* remote, size_t* raw_count);
@@ -0,0 +1,413 @@
+/*!
+ *  @file flipper-xremote/xremote_free_learn.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Learn a remote from button presses in any order.
+ */
+
+#include "xremote_free_learn.h"
+#include "xremote_learn.h"
+#include "xremote_fingerprint.h"
+#include "views/xremote_free_learn_view.h"
+
+#define TAG "XRemoteFreeLearn"
+
+struct XRemoteFreeLearn {
+    XRemoteSignalReceiver* ir_receiver;
+    XRemoteAppContext* app_ctx;
+    InfraredRemote* ir_remote;
+    XRemoteView* view;
+    FuriMutex* mutex;
+
+    /* User interactions */
+    TextInput* text_input;
+    DialogEx* dialog_ex;
+    Submenu* submenu;
+
+    /* Fingerprint of every learned button, in the order of the remote buttons */
+    uint32_t fingerprints[XREMOTE_FREE_LEARN_MAX];
+    size_t count;
+    size_t last;
+    uint32_t seen;
+    bool has_last;
+    bool repeated;
+
+    char text_store[XREMOTE_APP_TEXT_MAX + 1];
+    uint32_t rename_index;
+    bool running;
+    bool saved;
+};
+
+XRemoteAppContext* xremote_free_learn_get_app_context(XRemoteFreeLearn* learn) {
+    xremote_app_assert(learn, NULL);
+    return learn->app_ctx;
+}
+
+void xremote_free_learn_send_event(XRemoteFreeLearn* learn, XRemoteEvent event) {
+    xremote_app_assert_void(learn);
+    view_dispatcher_send_custom_event(learn->app_ctx->view_dispatcher, event);
+}
+
+void xremote_free_learn_get_status(XRemoteFreeLearn* learn, XRemoteFreeLearnStatus* status) {
+    memset(status, 0, sizeof(XRemoteFreeLearnStatus));
+    xremote_app_assert_void(learn);
+
+    furi_mutex_acquire(learn->mutex, FuriWaitForever);
+    status->count = learn->count;
+    status->seen = learn->seen;
+    status->repeated = learn->repeated;
+    status->full = learn->has_last && learn->last >= learn->count;
+
+    if(learn->has_last && learn->last < learn->count) {
+        InfraredRemoteButton* button = infrared_remote_get_button(learn->ir_remote, learn->last);
+        InfraredSignal* signal = infrared_remote_button_get_signal(button);
+        status->name = infrared_remote_button_get_name(button);
+        status->is_raw = infrared_signal_is_raw(signal);
+
+        if(status->is_raw)
+            status->timings_size = infrared_signal_get_raw_signal(signal)->timings_size;
+        else
+            status->message = *infrared_signal_get_message(signal);
+    }
+
+    furi_mutex_release(learn->mutex);
+}
+
+bool xremote_free_learn_undo(XRemoteFreeLearn* learn) {
+    xremote_app_assert(learn, false);
+    bool removed = false;
+
+    /* Only the latest button is removed, it is the one most likely caught by accident */
+    furi_mutex_acquire(learn->mutex, FuriWaitForever);
+    if(learn->count && infrared_remote_pop_button(learn->ir_remote)) {
+        learn->has_last = false;
+        learn->count--;
+        removed = true;
+    }
+    furi_mutex_release(learn->mutex);
+
+    return removed;
+}
+
+static void xremote_free_learn_signal_callback(void* context, InfraredSignal* signal) {
+    XRemoteFreeLearn* learn = context;
+    uint32_t fingerprint = xremote_fingerprint_signal(signal);
+    size_t index;
+
+    furi_mutex_acquire(learn->mutex, FuriWaitForever);
+
+    for(index = 0; index < learn->count; index++)
+        if(learn->fingerprints[index] == fingerprint) break;
+
+    learn->repeated = index < learn->count;
+    learn->has_last = true;
+    learn->last = index;
+    learn->seen++;
+
+    /* Continuous receiver reuses the signal, new codes are copied into the remote */
+    if(!learn->repeated && learn->count < XREMOTE_FREE_LEARN_MAX) {
+        char name[XREMOTE_NAME_MAX];
+        snprintf(name, sizeof(name), "%s%02u", XREMOTE_FREE_LEARN_PREFIX, learn->count + 1);
+        infrared_remote_push_button(learn->ir_remote, name, signal);
+        learn->fingerprints[learn->count++] = fingerprint;
+    }
+
+    furi_mutex_release(learn->mutex);
+    xremote_free_learn_send_event(learn, XRemoteEventSignalReceived);
+}
+
+static void xremote_free_learn_update_view(XRemoteFreeLearn* learn) {
+    if(learn->view == NULL) return;
+
+    with_view_model(
+        xremote_view_get_view(learn->view),
+        XRemoteViewModel * model,
+        { model->context = learn; },
+        true);
+}
+
+static void xremote_free_learn_switch_to_view(XRemoteFreeLearn* learn, XRemoteViewID view_id) {
+    view_dispatcher_switch_to_view(learn->app_ctx->view_dispatcher, view_id);
+}
+
+static void xremote_free_learn_rx_start(XRemoteFreeLearn* learn) {
+    if(learn->running) return;
+    xremote_signal_receiver_start(learn->ir_receiver);
+    learn->running = true;
+}
+
+static void xremote_free_learn_rx_stop(XRemoteFreeLearn* learn) {
+    if(!learn->running) return;
+    xremote_signal_receiver_stop(learn->ir_receiver);
+    learn->running = false;
+}
+
+static void xremote_free_learn_rename_callback(void* context) {
+    XRemoteFreeLearn* learn = context;
+    size_t index = learn->rename_index;
+
+    /* Remote is already stored, every rename updates the file */
+    if(learn->text_store[0] != '\0' && index < learn->count)
+        infrared_remote_rename_button(learn->ir_remote, learn->text_store, index);
+
+    xremote_free_learn_send_event(learn, XRemoteEventSignalSave);
+}
+
+static void xremote_free_learn_submenu_callback(void* context, uint32_t index) {
+    XRemoteFreeLearn* learn = context;
+    InfraredRemoteButton* button = infrared_remote_get_button(learn->ir_remote, index);
+    xremote_app_assert_void(button);
+
+    learn->rename_index = index;
+    snprintf(
+        learn->text_store, XREMOTE_NAME_MAX, "%s", infrared_remote_button_get_name(button));
+    text_input_set_header_text(learn->text_input, "Rename button");
+
+    text_input_set_result_callback(
+        learn->text_input,
+        xremote_free_learn_rename_callback,
+        learn,
+        learn->text_store,
+        XREMOTE_NAME_MAX,
+        false);
+
+    xremote_free_learn_switch_to_view(learn, XRemoteViewTextInput);
+}
+
+static void xremote_free_learn_list_show(XRemoteFreeLearn* learn) {
+    uint32_t selected = learn->rename_index;
+    submenu_reset(learn->submenu);
+    submenu_set_header(learn->submenu, "Rename buttons");
+
+    for(size_t i = 0; i < learn->count; i++) {
+        InfraredRemoteButton* button = infrared_remote_get_button(learn->ir_remote, i);
+        const char* name = infrared_remote_button_get_name(button);
+        submenu_add_item(learn->submenu, name, i, xremote_free_learn_submenu_callback, learn);
+    }
+
+    submenu_set_selected_item(learn->submenu, selected);
+    xremote_free_learn_switch_to_view(learn, XRemoteViewFreeLearnList);
+}
+
+static void xremote_free_learn_store_callback(void* context) {
+    XRemoteFreeLearn* learn = context;
+
+    if(learn->text_store[0] == '\0') {
+        xremote_free_learn_send_event(learn, XRemoteEventSignalRetry);
+        return;
+    }
+
+    char output_file[256];
+    snprintf(
+        output_file,
+        sizeof(output_file),
+        "%s/%s%s",
+        XREMOTE_APP_FOLDER,
+        learn->text_store,
+        XREMOTE_APP_EXTENSION);
+
+    /* Raw captures are cleaned up once, right before the single write */
+    for(size_t i = 0; i < learn->count; i++) {
+        InfraredRemoteButton* button = infrared_remote_get_button(learn->ir_remote, i);
+        xremote_learn_fit_signal(infrared_remote_button_get_signal(button));
+    }
+
+    infrared_remote_set_name(learn->ir_remote, learn->text_store);
+    infrared_remote_set_path(learn->ir_remote, output_file);
+    learn->saved = infrared_remote_store(learn->ir_remote);
+
+    FURI_LOG_I(TAG, "stored %u buttons: \'%s\'", learn->count, output_file);
+    xremote_free_learn_send_event(learn, XRemoteEventSignalSave);
+}
+
+static void xremote_free_learn_finish(XRemoteFreeLearn* learn) {
+    /* Nothing to save yet, keep listening */
+    if(!learn->count) return;
+    xremote_free_learn_rx_stop(learn);
+
+    snprintf(learn->text_store, XREMOTE_APP_TEXT_MAX, "Remote_");
+    text_input_set_header_text(learn->text_input, "Name new remote");
+
+    text_input_set_result_callback(
+        learn->text_input,
+        xremote_free_learn_store_callback,
+        learn,
+        learn->text_store,
+        XREMOTE_APP_TEXT_MAX,
+        true);
+
+    xremote_free_learn_switch_to_view(learn, XRemoteViewTextInput);
+}
+
+static void xremote_free_learn_dialog_callback(DialogExResult result, void* context) {
+    XRemoteFreeLearn* learn = context;
+    xremote_free_learn_switch_to_view(learn, XRemoteViewSubmenu);
+
+    if(result == DialogExResultLeft)
+        xremote_free_learn_send_event(learn, XRemoteEventSignalExit);
+    else if(result == DialogExResultRight)
+        xremote_free_learn_send_event(learn, XRemoteEventSignalRetry);
+    else if(result == DialogExResultCenter)
+        xremote_free_learn_send_event(learn, XRemoteEventSignalFinish);
+}
+
+static void xremote_free_learn_ask_exit(XRemoteFreeLearn* learn) {
+    if(!learn->count) {
+        xremote_free_learn_send_event(learn, XRemoteEventSignalExit);
+        return;
+    }
+
+    DialogEx* dialog_ex = learn->dialog_ex;
+    dialog_ex_set_header(dialog_ex, "Exit to XRemote Menu?", 64, 11, AlignCenter, AlignTop);
+    dialog_ex_set_text(
+        dialog_ex, "All unsaved data\nwill be lost!", 64, 25, AlignCenter, AlignTop);
+    dialog_ex_set_icon(dialog_ex, 0, 0, NULL);
+
+    dialog_ex_set_left_button_text(dialog_ex, "Exit");
+    dialog_ex_set_center_button_text(dialog_ex, "Save");
+    dialog_ex_set_right_button_text(dialog_ex, "Stay");
+
+    dialog_ex_set_result_callback(dialog_ex, xremote_free_learn_dialog_callback);
+    dialog_ex_set_context(dialog_ex, learn);
+    xremote_free_learn_switch_to_view(learn, XRemoteViewDialogExit);
+}
+
+static bool xremote_free_learn_custom_event_callback(void* context, uint32_t event) {
+    xremote_app_assert(context, false);
+    XRemoteFreeLearn* learn = context;
+
+    if(event == XRemoteEventSignalReceived) {
+        xremote_free_learn_update_view(learn);
+    } else if(event == XRemoteEventSignalFinish) {
+        xremote_free_learn_finish(learn);
+    } else if(event == XRemoteEventSignalSave) {
+        /* Stored remote is offered for renaming until the list is left */
+        if(learn->saved)
+            xremote_free_learn_list_show(learn);
+        else
+            xremote_free_learn_switch_to_view(learn, XRemoteViewSubmenu);
+    } else if(event == XRemoteEventSignalRetry) {
+        xremote_free_learn_rx_start(learn);
+        xremote_free_learn_update_view(learn);
+        xremote_free_learn_switch_to_view(learn, XRemoteViewFreeLearn);
+    } else if(event == XRemoteEventSignalAskExit) {
+        xremote_free_learn_rx_stop(learn);
+        xremote_free_learn_ask_exit(learn);
+    } else if(event == XRemoteEventSignalExit) {
+        xremote_free_learn_rx_stop(learn);
+        xremote_free_learn_switch_to_view(learn, XRemoteViewSubmenu);
+    }
+
+    return true;
+}
+
+static uint32_t xremote_free_learn_text_input_exit_callback(void* context) {
+    TextInput* text_input = context;
+    XRemoteFreeLearn* learn = text_input_get_validator_callback_context(text_input);
+    xremote_app_assert(learn, XRemoteViewSubmenu);
+
+    /* Leaving the name input before saving goes back to learning */
+    if(learn->saved) return XRemoteViewFreeLearnList;
+    xremote_free_learn_send_event(learn, XRemoteEventSignalRetry);
+    return XRemoteViewTextInput;
+}
+
+static uint32_t xremote_free_learn_list_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+static void xremote_free_learn_free(XRemoteFreeLearn* learn) {
+    xremote_app_assert_void(learn);
+    xremote_free_learn_rx_stop(learn);
+
+    ViewDispatcher* view_disp = learn->app_ctx->view_dispatcher;
+    view_dispatcher_set_custom_event_callback(view_disp, NULL);
+    view_dispatcher_set_event_callback_context(view_disp, NULL);
+
+    view_dispatcher_remove_view(view_disp, XRemoteViewTextInput);
+    text_input_free(learn->text_input);
+
+    view_dispatcher_remove_view(view_disp, XRemoteViewDialogExit);
+    dialog_ex_free(learn->dialog_ex);
+
+    view_dispatcher_remove_view(view_disp, XRemoteViewFreeLearnList);
+    submenu_free(learn->submenu);
+
+    xremote_signal_receiver_free(learn->ir_receiver);
+    infrared_remote_free(learn->ir_remote);
+    furi_mutex_free(learn->mutex);
+    free(learn);
+}
+
+static void xremote_free_learn_clear_callback(void* context) {
+    XRemoteFreeLearn* learn = context;
+    xremote_free_learn_free(learn);
+}
+
+static XRemoteFreeLearn* xremote_free_learn_ctx_alloc(XRemoteAppContext* app_ctx) {
+    XRemoteFreeLearn* learn = malloc(sizeof(XRemoteFreeLearn));
+    learn->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    learn->ir_remote = infrared_remote_alloc();
+    learn->app_ctx = app_ctx;
+    learn->view = NULL;
+
+    learn->text_store[0] = '\0';
+    learn->rename_index = 0;
+    learn->has_last = false;
+    learn->repeated = false;
+    learn->running = false;
+    learn->saved = false;
+    learn->count = 0;
+    learn->last = 0;
+    learn->seen = 0;
+
+    ViewDispatcher* view_disp = app_ctx->view_dispatcher;
+    learn->text_input = text_input_alloc();
+    text_input_set_validator(learn->text_input, NULL, learn);
+
+    View* view = text_input_get_view(learn->text_input);
+    view_set_previous_callback(view, xremote_free_learn_text_input_exit_callback);
+    view_dispatcher_add_view(view_disp, XRemoteViewTextInput, view);
+
+    learn->dialog_ex = dialog_ex_alloc();
+    view = dialog_ex_get_view(learn->dialog_ex);
+    view_dispatcher_add_view(view_disp, XRemoteViewDialogExit, view);
+
+    learn->submenu = submenu_alloc();
+    view = submenu_get_view(learn->submenu);
+    view_set_previous_callback(view, xremote_free_learn_list_exit_callback);
+    view_dispatcher_add_view(view_disp, XRemoteViewFreeLearnList, view);
+
+    view_dispatcher_set_custom_event_callback(
+        view_disp, xremote_free_learn_custom_event_callback);
+    view_dispatcher_set_event_callback_context(view_disp, learn);
+
+    /* Default filter collapses a held button into a single capture */
+    learn->ir_receiver = xremote_signal_receiver_alloc(app_ctx);
+    xremote_signal_receiver_set_continuous(learn->ir_receiver, true);
+    xremote_signal_receiver_set_context(learn->ir_receiver, learn, NULL);
+    xremote_signal_receiver_set_rx_callback(
+        learn->ir_receiver, xremote_free_learn_signal_callback);
+
+    return learn;
+}
+
+static uint32_t xremote_free_learn_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+XRemoteApp* xremote_free_learn_alloc(XRemoteAppContext* app_ctx) {
+    XRemoteFreeLearn* learn = xremote_free_learn_ctx_alloc(app_ctx);
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+
+    xremote_app_view_alloc2(app, XRemoteViewFreeLearn, xremote_free_learn_view_alloc, learn);
+    xremote_app_view_set_previous_callback(app, xremote_free_learn_view_exit_callback);
+    xremote_app_set_user_context(app, learn, xremote_free_learn_clear_callback);
+
+    learn->view = app->view_ctx;
+    xremote_free_learn_rx_start(learn);
+    return app;
+}
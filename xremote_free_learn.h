@@ -0,0 +1,36 @@
+/*!
+ *  @file flipper-xremote/xremote_free_learn.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Learn a remote from button presses in any order.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "xremote_signal.h"
+
+/* Two digit names, every distinct code becomes one button */
+#define XREMOTE_FREE_LEARN_MAX    99
+#define XREMOTE_FREE_LEARN_PREFIX "Btn_"
+
+typedef struct {
+    InfraredMessage message;
+    size_t timings_size;
+    const char* name;
+    size_t count;
+    uint32_t seen;
+    bool is_raw;
+    bool repeated;
+    bool full;
+} XRemoteFreeLearnStatus;
+
+typedef struct XRemoteFreeLearn XRemoteFreeLearn;
+
+XRemoteAppContext* xremote_free_learn_get_app_context(XRemoteFreeLearn* learn);
+void xremote_free_learn_get_status(XRemoteFreeLearn* learn, XRemoteFreeLearnStatus* status);
+void xremote_free_learn_send_event(XRemoteFreeLearn* learn, XRemoteEvent event);
+bool xremote_free_learn_undo(XRemoteFreeLearn* learn);
+
+XRemoteApp* xremote_free_learn_alloc(XRemoteAppContext* app_ctx);
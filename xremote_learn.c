@@ -7,6 +7,9 @@
  */
 
 #include "xremote_learn.h"
+#include "xremote_fit.h"
+#include "xremote_denoise.h"
+#include "xremote_consensus.h"
 #include "views/xremote_learn_view.h"
 
 struct XRemoteLearnContext {
@@ -14,12 +17,16 @@ struct XRemoteLearnContext {
     XRemoteSignalReceiver* ir_receiver;
     XRemoteAppContext* app_ctx;
     XRemoteView* signal_view;
+    XRemoteView* learn_view;
     XRemoteViewID curr_view;
     XRemoteViewID prev_view;
 
     /* Main infrared app context */
     InfraredRemote* ir_remote;
-    InfraredSignal* ir_signal;
+
+    /* Captures of the current button and the signal built from them */
+    XRemoteConsensus* consensus;
+    InfraredSignal* consensus_signal;
 
     /* User interactions */
     TextInput* text_input;
@@ -34,6 +41,7 @@ struct XRemoteLearnContext {
     uint8_t current_button;
     bool finish_learning;
     bool stop_receiver;
+    bool is_single;
     bool is_dirty;
 };
 
@@ -59,9 +67,27 @@ InfraredRemote* xremote_learn_get_ir_remote(XRemoteLearnContext* learn_ctx) {
     return learn_ctx->ir_remote;
 }
 
+static uint32_t xremote_learn_get_captures(XRemoteLearnContext* learn_ctx) {
+    uint32_t captures = learn_ctx->app_ctx->app_settings->learn_captures;
+    return CLAMP(captures, XREMOTE_CONSENSUS_CAPTURES, 1);
+}
+
 InfraredSignal* xremote_learn_get_ir_signal(XRemoteLearnContext* learn_ctx) {
     xremote_app_assert(learn_ctx, NULL);
-    return learn_ctx->ir_signal;
+    if(xremote_learn_get_captures(learn_ctx) > 1) return learn_ctx->consensus_signal;
+    return xremote_signal_receiver_get_signal(learn_ctx->ir_receiver);
+}
+
+size_t xremote_learn_get_capture_count(XRemoteLearnContext* learn_ctx, size_t* total) {
+    xremote_app_assert(learn_ctx, 0);
+    if(total != NULL) *total = xremote_learn_get_captures(learn_ctx);
+    return xremote_consensus_get_count(learn_ctx->consensus);
+}
+
+uint8_t xremote_learn_get_quality(XRemoteLearnContext* learn_ctx) {
+    xremote_app_assert(learn_ctx, 0);
+    if(xremote_learn_get_captures(learn_ctx) < 2 || learn_ctx->is_single) return 100;
+    return xremote_consensus_get_quality(learn_ctx->consensus);
 }
 
 XRemoteSignalReceiver* xremote_learn_get_ir_receiver(XRemoteLearnContext* learn_ctx) {
@@ -95,7 +121,10 @@ static void xremote_learn_context_rx_stop(XRemoteLearnContext* learn_ctx) {
 
 static void xremote_learn_context_rx_start(XRemoteLearnContext* learn_ctx) {
     xremote_app_assert_void(learn_ctx);
+    xremote_consensus_reset(learn_ctx->consensus);
+    xremote_signal_filter_reset(xremote_signal_receiver_get_filter(learn_ctx->ir_receiver));
     learn_ctx->finish_learning = false;
+    learn_ctx->is_single = false;
     learn_ctx->stop_receiver = false;
     xremote_signal_receiver_start(learn_ctx->ir_receiver);
 }
@@ -174,6 +203,20 @@ static uint32_t xremote_learn_text_input_exit_callback(void* context) {
     return XRemoteViewTextInput;
 }
 
+void xremote_learn_fit_signal(InfraredSignal* signal) {
+    if(!infrared_signal_is_raw(signal)) return;
+
+    /* Jitter is snapped to cluster centers before fitting and saving */
+    XRemoteDenoise* denoise = xremote_denoise_alloc();
+    xremote_denoise_signal(denoise, signal);
+    xremote_denoise_free(denoise);
+
+    /* Raw capture which is a near miss of a known protocol is saved as message */
+    XRemoteFit* fit = xremote_fit_alloc();
+    xremote_fit_signal(fit, signal);
+    xremote_fit_free(fit);
+}
+
 static void xremote_learn_text_input_callback(void* context) {
     xremote_app_assert_void(context);
     XRemoteLearnContext* learn_ctx = context;
@@ -182,6 +225,7 @@ static void xremote_learn_text_input_callback(void* context) {
         const char* name = xremote_learn_get_curr_button_name(learn_ctx);
         if(!infrared_remote_get_button_by_name(learn_ctx->ir_remote, name)) {
             InfraredSignal* signal = xremote_learn_get_ir_signal(learn_ctx);
+            xremote_learn_fit_signal(signal);
             infrared_remote_push_button(learn_ctx->ir_remote, name, signal);
         }
 
@@ -209,6 +253,7 @@ static void xremote_learn_text_input_callback(void* context) {
 }
 
 static void xremote_learn_signal_callback(void* context, InfraredSignal* signal) {
+    UNUSED(signal);
     XRemoteLearnContext* learn_ctx = context;
     xremote_app_assert_void(!learn_ctx->stop_receiver);
     xremote_app_assert_void(!learn_ctx->finish_learning);
@@ -216,7 +261,7 @@ static void xremote_learn_signal_callback(void* context, InfraredSignal* signal)
     learn_ctx->stop_receiver = true;
     learn_ctx->is_dirty = true;
 
-    infrared_signal_set_signal(learn_ctx->ir_signal, signal);
+    /* Capture is copied from the receiver buffer only when saved */
     xremote_learn_send_event(learn_ctx, XRemoteEventSignalReceived);
 }
 
@@ -263,6 +308,49 @@ static bool xremote_learn_custom_event_dummy_callback(void* context, uint32_t ev
     return true;
 }
 
+static bool xremote_learn_add_capture(XRemoteLearnContext* learn_ctx) {
+    InfraredSignal* signal = xremote_signal_receiver_get_signal(learn_ctx->ir_receiver);
+
+    /* Capture too long to be combined is used alone, as with a single capture */
+    if(!xremote_consensus_add(learn_ctx->consensus, signal)) {
+        infrared_signal_set_signal(learn_ctx->consensus_signal, signal);
+        learn_ctx->is_single = true;
+        return true;
+    }
+
+    /* Codes from other remotes in the room are ignored after the first decoded capture */
+    if(xremote_consensus_get_count(learn_ctx->consensus) == 1 && !infrared_signal_is_raw(signal)) {
+        XRemoteSignalFilter* filter = xremote_signal_receiver_get_filter(learn_ctx->ir_receiver);
+        InfraredMessage* message = infrared_signal_get_message(signal);
+        xremote_signal_filter_allow(filter, message->protocol, message->address, false);
+    }
+
+    /* Keep listening on the learn view until the button is captured enough times */
+    size_t count = xremote_consensus_get_count(learn_ctx->consensus);
+    if(count >= xremote_learn_get_captures(learn_ctx) &&
+       xremote_consensus_build(learn_ctx->consensus, learn_ctx->consensus_signal))
+        return true;
+
+    /* Captures which could not be combined are dropped and learning starts over */
+    if(count >= xremote_learn_get_captures(learn_ctx)) {
+        XRemoteSignalFilter* filter = xremote_signal_receiver_get_filter(learn_ctx->ir_receiver);
+        xremote_consensus_reset(learn_ctx->consensus);
+        xremote_signal_filter_reset(filter);
+    }
+
+    learn_ctx->stop_receiver = false;
+    learn_ctx->is_dirty = false;
+    xremote_signal_receiver_start(learn_ctx->ir_receiver);
+
+    with_view_model(
+        xremote_view_get_view(learn_ctx->learn_view),
+        XRemoteViewModel * model,
+        { model->context = learn_ctx; },
+        true);
+
+    return false;
+}
+
 static bool xremote_learn_custom_event_callback(void* context, uint32_t event) {
     xremote_app_assert(context, false);
     XRemoteLearnContext* learn_ctx = context;
@@ -273,12 +361,19 @@ static bool xremote_learn_custom_event_callback(void* context, uint32_t event) {
 
     if(event == XRemoteEventSignalReceived) {
         xremote_learn_context_rx_stop(learn_ctx);
+
+        if(xremote_learn_get_captures(learn_ctx) > 1 &&
+           learn_ctx->curr_view == XRemoteViewLearn &&
+           !xremote_learn_add_capture(learn_ctx))
+            return true;
+
         xremote_learn_switch_to_view(learn_ctx, XRemoteViewSignal);
     } else if(event == XRemoteEventSignalSave) {
         const char* name = xremote_learn_get_curr_button_name(learn_ctx);
         infrared_remote_delete_button_by_name(learn_ctx->ir_remote, name);
 
         InfraredSignal* signal = xremote_learn_get_ir_signal(learn_ctx);
+        xremote_learn_fit_signal(signal);
         infrared_remote_push_button(learn_ctx->ir_remote, name, signal);
         learn_ctx->is_dirty = false;
 
@@ -327,10 +422,12 @@ static bool xremote_learn_custom_event_callback(void* context, uint32_t event) {
 
 static XRemoteLearnContext* xremote_learn_context_alloc(XRemoteAppContext* app_ctx) {
     XRemoteLearnContext* learn_ctx = malloc(sizeof(XRemoteLearnContext));
-    learn_ctx->ir_signal = infrared_signal_alloc();
     learn_ctx->ir_remote = infrared_remote_alloc();
+    learn_ctx->consensus = xremote_consensus_alloc();
+    learn_ctx->consensus_signal = infrared_signal_alloc();
 
     learn_ctx->app_ctx = app_ctx;
+    learn_ctx->learn_view = NULL;
     learn_ctx->dialog_ex = NULL;
     learn_ctx->text_store[0] = 0;
     learn_ctx->current_button = 0;
@@ -340,6 +437,7 @@ static XRemoteLearnContext* xremote_learn_context_alloc(XRemoteAppContext* app_c
 
     learn_ctx->finish_learning = false;
     learn_ctx->stop_receiver = false;
+    learn_ctx->is_single = false;
     learn_ctx->is_dirty = false;
 
     learn_ctx->signal_view = xremote_learn_success_view_alloc(app_ctx, learn_ctx);
@@ -381,7 +479,8 @@ static void xremote_learn_context_free(XRemoteLearnContext* learn_ctx) {
     xremote_view_free(learn_ctx->signal_view);
 
     xremote_signal_receiver_free(learn_ctx->ir_receiver);
-    infrared_signal_free(learn_ctx->ir_signal);
+    infrared_signal_free(learn_ctx->consensus_signal);
+    xremote_consensus_free(learn_ctx->consensus);
     infrared_remote_free(learn_ctx->ir_remote);
     free(learn_ctx);
 }
@@ -397,6 +496,7 @@ XRemoteApp* xremote_learn_alloc(XRemoteAppContext* app_ctx) {
 
     XRemoteLearnContext* learn = xremote_learn_context_alloc(app_ctx);
     app->view_ctx = xremote_learn_view_alloc(app->app_ctx, learn);
+    learn->learn_view = app->view_ctx;
     View* view = xremote_view_get_view(app->view_ctx);
 
     ViewDispatcher* view_disp = app_ctx->view_dispatcher;
@@ -22,5 +22,10 @@ XRemoteSignalReceiver* xremote_learn_get_ir_receiver(XRemoteLearnContext* learn_
 XRemoteAppContext* xremote_learn_get_app_context(XRemoteLearnContext* learn_ctx);
 InfraredRemote* xremote_learn_get_ir_remote(XRemoteLearnContext* learn_ctx);
 InfraredSignal* xremote_learn_get_ir_signal(XRemoteLearnContext* learn_ctx);
+size_t xremote_learn_get_capture_count(XRemoteLearnContext* learn_ctx, size_t* total);
+uint8_t xremote_learn_get_quality(XRemoteLearnContext* learn_ctx);
+
+/* Denoises and fits a raw capture to a known protocol before it is saved */
+void xremote_learn_fit_signal(InfraredSignal* signal);
 
 XRemoteApp* xremote_learn_alloc(XRemoteAppContext* app_ctx);
@@ -0,0 +1,286 @@
+/*!
+ *  @file flipper-xremote/xremote_log.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Binary capture log written to the SD card by a background thread.
+ */
+
+#include "xremote_log.h"
+
+#include <storage/storage.h>
+
+#define TAG "XRemoteLog"
+
+typedef enum {
+    XRemoteLogFlagWrite = (1 << 0),
+    XRemoteLogFlagExit = (1 << 1)
+} XRemoteLogFlag;
+
+struct XRemoteLog {
+    Storage* storage;
+    File* file;
+    FuriThread* thread;
+
+    /* Producer fills the active buffer, the writer thread owns the pending one */
+    uint8_t* buffers[2];
+    size_t length[2];
+    bool pending[2];
+    uint8_t active;
+
+    uint32_t start_tick;
+    uint32_t swap_tick;
+    uint32_t records;
+    uint32_t dropped;
+    uint32_t unreported;
+};
+
+static uint8_t* xremote_log_put_u16(uint8_t* data, uint16_t value) {
+    *data++ = value & 0xFF;
+    *data++ = value >> 8;
+    return data;
+}
+
+static uint8_t* xremote_log_put_u32(uint8_t* data, uint32_t value) {
+    data = xremote_log_put_u16(data, value & 0xFFFF);
+    return xremote_log_put_u16(data, value >> 16);
+}
+
+static uint8_t* xremote_log_put_varint(uint8_t* data, uint32_t value) {
+    /* Seven bits per byte, typical timings take two bytes instead of four */
+    while(value >= 0x80) {
+        *data++ = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+
+    *data++ = value;
+    return data;
+}
+
+static void xremote_log_write(XRemoteLog* log, const uint8_t* data, size_t length) {
+    if(!length) return;
+    size_t written = storage_file_write(log->file, data, length);
+    if(written != length) FURI_LOG_W(TAG, "write failed: %u of %u bytes", written, length);
+}
+
+static int32_t xremote_log_thread(void* context) {
+    XRemoteLog* log = context;
+    uint32_t flags = 0;
+
+    while(!(flags & XRemoteLogFlagExit)) {
+        flags = furi_thread_flags_wait(
+            XRemoteLogFlagWrite | XRemoteLogFlagExit, FuriFlagWaitAny, FuriWaitForever);
+
+        if(flags & FuriFlagError) {
+            flags = 0;
+            continue;
+        }
+
+        for(size_t i = 0; i < 2; i++) {
+            if(!__atomic_load_n(&log->pending[i], __ATOMIC_ACQUIRE)) continue;
+            xremote_log_write(log, log->buffers[i], log->length[i]);
+            __atomic_store_n(&log->pending[i], false, __ATOMIC_RELEASE);
+        }
+    }
+
+    return 0;
+}
+
+static bool xremote_log_swap(XRemoteLog* log) {
+    uint8_t active = log->active;
+    uint8_t next = !active;
+
+    /* Writer is still busy with the previous buffer */
+    if(__atomic_load_n(&log->pending[next], __ATOMIC_ACQUIRE)) return false;
+    log->swap_tick = furi_get_tick();
+    if(!log->length[active]) return true;
+
+    __atomic_store_n(&log->pending[active], true, __ATOMIC_RELEASE);
+    log->length[next] = 0;
+    log->active = next;
+
+    furi_thread_flags_set(furi_thread_get_id(log->thread), XRemoteLogFlagWrite);
+    return true;
+}
+
+static uint8_t* xremote_log_put_header(
+    XRemoteLog* log,
+    uint8_t* data,
+    XRemoteLogRecord type,
+    uint8_t flags,
+    uint16_t length) {
+    uint64_t ticks = furi_get_tick() - log->start_tick;
+    uint32_t time_ms = ticks * 1000 / furi_kernel_get_tick_frequency();
+
+    *data++ = type;
+    *data++ = flags;
+    data = xremote_log_put_u16(data, length);
+    return xremote_log_put_u32(data, time_ms);
+}
+
+static size_t xremote_log_encode_message(XRemoteLog* log, uint8_t* data, InfraredSignal* signal) {
+    InfraredMessage* message = infrared_signal_get_message(signal);
+    const char* name = infrared_get_protocol_name(message->protocol);
+    uint8_t name_len = name != NULL ? strnlen(name, UINT8_MAX) : 0;
+
+    uint8_t* ptr = xremote_log_put_header(
+        log, data, XRemoteLogRecordMessage, 0, 10 + name_len);
+
+    ptr = xremote_log_put_u32(ptr, message->address);
+    ptr = xremote_log_put_u32(ptr, message->command);
+    *ptr++ = message->repeat;
+    *ptr++ = name_len;
+
+    if(name_len) memcpy(ptr, name, name_len);
+    return ptr + name_len - data;
+}
+
+static size_t xremote_log_encode_raw(
+    XRemoteLog* log,
+    uint8_t* data,
+    InfraredSignal* signal,
+    size_t capacity) {
+    InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+    uint8_t* payload = data + XREMOTE_LOG_HEADER_SIZE;
+    uint8_t* ptr = xremote_log_put_u32(payload, raw->frequency);
+    uint8_t flags = 0;
+
+    /* Varint is at most five bytes, stop before the one which might not fit */
+    for(size_t i = 0; i < raw->timings_size; i++) {
+        if((size_t)(ptr - data) + 5 > capacity) {
+            flags |= XREMOTE_LOG_FLAG_TRUNCATED;
+            break;
+        }
+
+        ptr = xremote_log_put_varint(ptr, raw->timings[i]);
+    }
+
+    xremote_log_put_header(log, data, XRemoteLogRecordRaw, flags, ptr - payload);
+    return ptr - data;
+}
+
+bool xremote_log_push(XRemoteLog* log, InfraredSignal* signal) {
+    xremote_app_assert(log, false);
+    bool is_raw = infrared_signal_is_raw(signal);
+
+    /* Worst case size, including the record which reports earlier drops */
+    size_t size = XREMOTE_LOG_HEADER_SIZE * 2 + 4;
+    if(is_raw)
+        size += 4 + infrared_signal_get_raw_signal(signal)->timings_size * 5;
+    else
+        size += 10 + UINT8_MAX;
+
+    uint32_t elapsed = furi_get_tick() - log->swap_tick;
+    bool stale = elapsed >= furi_ms_to_ticks(XREMOTE_LOG_FLUSH_MS);
+
+    if(stale || log->length[log->active] + size > XREMOTE_LOG_BUFFER) xremote_log_swap(log);
+
+    /* Raw capture larger than an empty buffer is truncated instead of dropped */
+    size = MIN(size, (size_t)XREMOTE_LOG_BUFFER);
+
+    /* Dropped rather than waiting for the SD card, the next record reports it */
+    if(log->length[log->active] + size > XREMOTE_LOG_BUFFER) {
+        log->unreported++;
+        log->dropped++;
+        return false;
+    }
+
+    uint8_t* data = log->buffers[log->active] + log->length[log->active];
+    uint8_t* ptr = data;
+
+    if(log->unreported) {
+        ptr = xremote_log_put_header(log, ptr, XRemoteLogRecordDropped, 0, 4);
+        ptr = xremote_log_put_u32(ptr, log->unreported);
+        log->unreported = 0;
+    }
+
+    size_t capacity = XREMOTE_LOG_BUFFER - log->length[log->active] - (ptr - data);
+
+    if(is_raw)
+        ptr += xremote_log_encode_raw(log, ptr, signal, capacity);
+    else
+        ptr += xremote_log_encode_message(log, ptr, signal);
+
+    log->length[log->active] += ptr - data;
+    log->records++;
+
+    return true;
+}
+
+XRemoteLog* xremote_log_open(const char* path) {
+    XRemoteLog* log = malloc(sizeof(XRemoteLog));
+    xremote_app_assert(log, NULL);
+
+    log->storage = furi_record_open(RECORD_STORAGE);
+    log->file = storage_file_alloc(log->storage);
+
+    if(!storage_file_open(log->file, path, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        FURI_LOG_E(TAG, "can not open log file: \'%s\'", path);
+        storage_file_free(log->file);
+        furi_record_close(RECORD_STORAGE);
+        free(log);
+        return NULL;
+    }
+
+    /* Magic is written only once, every session appends its own records */
+    if(!storage_file_size(log->file)) {
+        uint8_t header[8] = {0};
+        memcpy(header, XREMOTE_LOG_MAGIC, 4);
+        header[4] = XREMOTE_LOG_VERSION;
+        xremote_log_write(log, header, sizeof(header));
+    }
+
+    log->buffers[0] = malloc(XREMOTE_LOG_BUFFER);
+    log->buffers[1] = malloc(XREMOTE_LOG_BUFFER);
+    log->length[0] = log->length[1] = 0;
+    log->pending[0] = log->pending[1] = false;
+    log->active = 0;
+
+    log->start_tick = furi_get_tick();
+    log->swap_tick = log->start_tick;
+    log->records = 0;
+    log->dropped = 0;
+    log->unreported = 0;
+
+    uint8_t* ptr = xremote_log_put_header(log, log->buffers[0], XRemoteLogRecordSession, 0, 4);
+    ptr = xremote_log_put_u32(ptr, furi_hal_rtc_get_timestamp());
+    log->length[0] = ptr - log->buffers[0];
+
+    log->thread = furi_thread_alloc_ex(
+        "XRemoteLog", XREMOTE_LOG_STACK_SIZE, xremote_log_thread, log);
+
+    furi_thread_start(log->thread);
+    FURI_LOG_I(TAG, "log session started: \'%s\'", path);
+
+    return log;
+}
+
+void xremote_log_close(XRemoteLog* log) {
+    xremote_app_assert_void(log);
+
+    /* Pending buffer is written before the thread exits, the active one is left to us */
+    furi_thread_flags_set(furi_thread_get_id(log->thread), XRemoteLogFlagExit);
+    furi_thread_join(log->thread);
+    furi_thread_free(log->thread);
+
+    xremote_log_write(log, log->buffers[log->active], log->length[log->active]);
+    FURI_LOG_I(TAG, "log session closed: %lu records, %lu dropped", log->records, log->dropped);
+
+    storage_file_close(log->file);
+    storage_file_free(log->file);
+    furi_record_close(RECORD_STORAGE);
+
+    free(log->buffers[0]);
+    free(log->buffers[1]);
+    free(log);
+}
+
+uint32_t xremote_log_get_records(XRemoteLog* log) {
+    xremote_app_assert(log, 0);
+    return log->records;
+}
+
+uint32_t xremote_log_get_dropped(XRemoteLog* log) {
+    xremote_app_assert(log, 0);
+    return log->dropped;
+}
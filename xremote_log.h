@@ -0,0 +1,46 @@
+/*!
+ *  @file flipper-xremote/xremote_log.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Binary capture log written to the SD card by a background thread.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+#define XREMOTE_LOG_PATH XREMOTE_APP_FOLDER "/XRemote_Captures.xlog"
+
+/* File starts with the magic and version, sessions are appended after it */
+#define XREMOTE_LOG_MAGIC   "XRLG"
+#define XREMOTE_LOG_VERSION 1
+
+/* Two buffers are swapped when full or older than the flush interval */
+#define XREMOTE_LOG_BUFFER     4096
+#define XREMOTE_LOG_FLUSH_MS   1000
+#define XREMOTE_LOG_STACK_SIZE 1024
+
+/* Record header is type, flags, payload length and milliseconds since the session start */
+#define XREMOTE_LOG_HEADER_SIZE 8
+
+typedef enum {
+    XRemoteLogRecordSession = 1,
+    XRemoteLogRecordMessage,
+    XRemoteLogRecordRaw,
+    XRemoteLogRecordDropped
+} XRemoteLogRecord;
+
+/* Raw record did not fit into the buffer and the rest of its timings are missing */
+#define XREMOTE_LOG_FLAG_TRUNCATED (1 << 0)
+
+typedef struct XRemoteLog XRemoteLog;
+
+XRemoteLog* xremote_log_open(const char* path);
+void xremote_log_close(XRemoteLog* log);
+
+/* Called by a single producer, never waits for the SD card */
+bool xremote_log_push(XRemoteLog* log, InfraredSignal* signal);
+uint32_t xremote_log_get_records(XRemoteLog* log);
+uint32_t xremote_log_get_dropped(XRemoteLog* log);
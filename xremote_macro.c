@@ -0,0 +1,325 @@
+/*!
+ *  @file flipper-xremote/xremote_macro.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Macro player for timed sequences of buttons from multiple remotes.
+ */
+
+#include "xremote_macro.h"
+#include "views/xremote_macro_view.h"
+
+#include <m-array.h>
+#include <toolbox/path.h>
+
+#define TAG "XRemoteMacro"
+
+/* Retry period when transmit queue is full */
+#define XREMOTE_MACRO_RETRY_MS 10
+
+typedef struct {
+    InfraredSignal* signal;
+    const char* button;
+    uint32_t repeat;
+    uint32_t delay;
+} XRemoteMacroStep;
+
+ARRAY_DEF(XRemoteMacroSteps, XRemoteMacroStep, M_POD_OPLIST);
+ARRAY_DEF(XRemoteMacroRemotes, InfraredRemote*, M_PTR_OPLIST);
+
+struct XRemoteMacro {
+    XRemoteMacroRemotes_t remotes;
+    XRemoteMacroSteps_t steps;
+    XRemoteAppContext* app_ctx;
+    XRemoteMacroState state;
+    XRemoteView* view;
+    FuriString* name;
+    FuriTimer* timer;
+    uint32_t delay;
+    bool draining;
+    size_t step;
+};
+
+XRemoteAppContext* xremote_macro_get_app_context(XRemoteMacro* macro) {
+    xremote_app_assert(macro, NULL);
+    return macro->app_ctx;
+}
+
+XRemoteMacroState xremote_macro_get_state(XRemoteMacro* macro) {
+    xremote_app_assert(macro, XRemoteMacroStateIdle);
+    return macro->state;
+}
+
+const char* xremote_macro_get_state_str(XRemoteMacro* macro) {
+    xremote_app_assert(macro, "");
+    if(macro->state == XRemoteMacroStatePlaying) return "Playing";
+    if(macro->state == XRemoteMacroStateDone) return "Done";
+    if(macro->state == XRemoteMacroStateCancelled) return "Cancelled";
+    return "Ready";
+}
+
+const char* xremote_macro_get_name(XRemoteMacro* macro) {
+    xremote_app_assert(macro, "");
+    return furi_string_get_cstr(macro->name);
+}
+
+const char* xremote_macro_get_button(XRemoteMacro* macro) {
+    xremote_app_assert(macro, "");
+    size_t count = XRemoteMacroSteps_size(macro->steps);
+    size_t index = macro->step < count ? macro->step : count - 1;
+    return XRemoteMacroSteps_get(macro->steps, index)->button;
+}
+
+size_t xremote_macro_get_step_count(XRemoteMacro* macro) {
+    xremote_app_assert(macro, 0);
+    return XRemoteMacroSteps_size(macro->steps);
+}
+
+size_t xremote_macro_get_step(XRemoteMacro* macro) {
+    xremote_app_assert(macro, 0);
+    return macro->step;
+}
+
+static void xremote_macro_update_view(XRemoteMacro* macro) {
+    with_view_model(
+        xremote_view_get_view(macro->view),
+        XRemoteViewModel * model,
+        { model->context = macro; },
+        true);
+}
+
+static void xremote_macro_run_step(XRemoteMacro* macro) {
+    XRemoteTransmitter* transmitter = macro->app_ctx->transmitter;
+
+    /* Delay of the previous step counts from the end of its transmit, not from queueing it */
+    if(macro->draining) {
+        if(xremote_transmitter_get_pending(transmitter)) {
+            furi_timer_start(macro->timer, furi_ms_to_ticks(XREMOTE_MACRO_RETRY_MS));
+            return;
+        }
+
+        uint32_t ticks = furi_ms_to_ticks(macro->delay);
+        furi_timer_start(macro->timer, ticks ? ticks : 1);
+        macro->draining = false;
+        return;
+    }
+
+    XRemoteMacroStep* step = XRemoteMacroSteps_get(macro->steps, macro->step);
+
+    /* Queue is full, try again shortly without losing the step */
+    if(!xremote_transmitter_send(transmitter, step->signal, step->repeat)) {
+        furi_timer_start(macro->timer, furi_ms_to_ticks(XREMOTE_MACRO_RETRY_MS));
+        return;
+    }
+
+    if(++macro->step < XRemoteMacroSteps_size(macro->steps)) {
+        furi_timer_start(macro->timer, furi_ms_to_ticks(XREMOTE_MACRO_RETRY_MS));
+        macro->delay = step->delay;
+        macro->draining = true;
+    } else {
+        macro->state = XRemoteMacroStateDone;
+    }
+
+    xremote_macro_update_view(macro);
+}
+
+static void xremote_macro_timer_callback(void* context) {
+    XRemoteMacro* macro = context;
+    view_dispatcher_send_custom_event(macro->app_ctx->view_dispatcher, XRemoteEventMacroStep);
+}
+
+static bool xremote_macro_custom_event_callback(void* context, uint32_t event) {
+    xremote_app_assert(context, false);
+    XRemoteMacro* macro = context;
+
+    /* Steps are sent from GUI thread, transmit queue has a single producer */
+    if(event == XRemoteEventMacroStep && macro->state == XRemoteMacroStatePlaying)
+        xremote_macro_run_step(macro);
+
+    return true;
+}
+
+void xremote_macro_play(XRemoteMacro* macro) {
+    xremote_app_assert_void(macro);
+    furi_timer_stop(macro->timer);
+
+    macro->state = XRemoteMacroStatePlaying;
+    macro->draining = false;
+    macro->step = 0;
+
+    dolphin_deed(DolphinDeedIrSend);
+    xremote_macro_run_step(macro);
+}
+
+void xremote_macro_cancel(XRemoteMacro* macro) {
+    xremote_app_assert_void(macro);
+    furi_timer_stop(macro->timer);
+
+    /* Step on the air is finished, nothing queued is left to fire after the cancel */
+    xremote_transmitter_flush(macro->app_ctx->transmitter);
+    macro->state = XRemoteMacroStateCancelled;
+    macro->draining = false;
+}
+
+static InfraredRemote* xremote_macro_get_remote(XRemoteMacro* macro, FuriString* path) {
+    XRemoteMacroRemotes_it_t it;
+
+    /* Every remote is loaded only once, no matter how many steps use it */
+    for(XRemoteMacroRemotes_it(it, macro->remotes); !XRemoteMacroRemotes_end_p(it);
+        XRemoteMacroRemotes_next(it)) {
+        InfraredRemote* remote = *XRemoteMacroRemotes_cref(it);
+        if(furi_string_cmp_str(path, infrared_remote_get_path(remote)) == 0) return remote;
+    }
+
+    InfraredRemote* remote = infrared_remote_alloc();
+    if(!infrared_remote_load(remote, path)) {
+        FURI_LOG_E(TAG, "failed to load remote: \'%s\'", furi_string_get_cstr(path));
+        infrared_remote_free(remote);
+        return NULL;
+    }
+
+    XRemoteMacroRemotes_push_back(macro->remotes, remote);
+    return remote;
+}
+
+static bool xremote_macro_load(XRemoteMacro* macro, FuriString* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    FuriString* remote_path = furi_string_alloc();
+    FuriString* button = furi_string_alloc();
+    FuriString* header = furi_string_alloc();
+
+    FURI_LOG_I(TAG, "load macro file: \'%s\'", furi_string_get_cstr(path));
+    bool alt_names = macro->app_ctx->app_settings->alt_names;
+    bool success = false;
+    uint32_t version = 0;
+
+    do {
+        /* Open file and read the header */
+        if(!flipper_format_buffered_file_open_existing(ff, furi_string_get_cstr(path))) break;
+        if(!flipper_format_read_header(ff, header, &version)) break;
+        if(!furi_string_equal(header, XREMOTE_MACRO_FILETYPE)) break;
+        if(version != XREMOTE_MACRO_VERSION) break;
+        success = true;
+
+        /* Every step is a remote file, button name, repeat count and delay in ms */
+        while(flipper_format_read_string(ff, "remote", remote_path)) {
+            XRemoteMacroStep step;
+            success = false;
+
+            if(!flipper_format_read_string(ff, "button", button)) break;
+            if(!flipper_format_read_uint32(ff, "repeat", &step.repeat, 1)) break;
+            if(!flipper_format_read_uint32(ff, "delay", &step.delay, 1)) break;
+
+            InfraredRemote* remote = xremote_macro_get_remote(macro, remote_path);
+            if(remote == NULL) break;
+
+            /* Signals are resolved once, playback only references them */
+            const char* name = furi_string_get_cstr(button);
+            InfraredRemoteButton* ir_button = xremote_button_lookup(remote, name, alt_names);
+
+            if(ir_button == NULL) {
+                FURI_LOG_E(TAG, "button not found: \'%s\'", name);
+                break;
+            }
+
+            step.signal = infrared_remote_button_get_signal(ir_button);
+            step.button = infrared_remote_button_get_name(ir_button);
+            XRemoteMacroSteps_push_back(macro->steps, step);
+            success = true;
+        }
+
+        success = success && XRemoteMacroSteps_size(macro->steps) > 0;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(ff);
+    furi_string_free(remote_path);
+    furi_string_free(button);
+    furi_string_free(header);
+
+    return success;
+}
+
+static void xremote_macro_free(XRemoteMacro* macro) {
+    xremote_app_assert_void(macro);
+    furi_timer_stop(macro->timer);
+    furi_timer_free(macro->timer);
+
+    ViewDispatcher* view_disp = macro->app_ctx->view_dispatcher;
+    view_dispatcher_set_custom_event_callback(view_disp, NULL);
+    view_dispatcher_set_event_callback_context(view_disp, NULL);
+
+    /* Queued steps reference the signals of loaded remotes */
+    xremote_transmitter_flush(macro->app_ctx->transmitter);
+    XRemoteMacroRemotes_it_t it;
+
+    for(XRemoteMacroRemotes_it(it, macro->remotes); !XRemoteMacroRemotes_end_p(it);
+        XRemoteMacroRemotes_next(it)) {
+        infrared_remote_free(*XRemoteMacroRemotes_cref(it));
+    }
+
+    XRemoteMacroRemotes_clear(macro->remotes);
+    XRemoteMacroSteps_clear(macro->steps);
+    furi_string_free(macro->name);
+    free(macro);
+}
+
+static void xremote_macro_clear_callback(void* context) {
+    XRemoteMacro* macro = context;
+    xremote_macro_free(macro);
+}
+
+static XRemoteMacro* xremote_macro_alloc_from_path(XRemoteAppContext* app_ctx, FuriString* path) {
+    XRemoteMacro* macro = malloc(sizeof(XRemoteMacro));
+    macro->state = XRemoteMacroStateIdle;
+    macro->app_ctx = app_ctx;
+    macro->view = NULL;
+    macro->draining = false;
+    macro->delay = 0;
+    macro->step = 0;
+
+    XRemoteMacroRemotes_init(macro->remotes);
+    XRemoteMacroSteps_init(macro->steps);
+
+    macro->name = furi_string_alloc();
+    path_extract_filename(path, macro->name, true);
+
+    macro->timer = furi_timer_alloc(xremote_macro_timer_callback, FuriTimerTypeOnce, macro);
+    view_dispatcher_set_custom_event_callback(
+        app_ctx->view_dispatcher, xremote_macro_custom_event_callback);
+    view_dispatcher_set_event_callback_context(app_ctx->view_dispatcher, macro);
+
+    if(!xremote_macro_load(macro, path)) {
+        xremote_macro_free(macro);
+        return NULL;
+    }
+
+    return macro;
+}
+
+static uint32_t xremote_macro_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+XRemoteApp* xremote_macro_alloc(XRemoteAppContext* app_ctx) {
+    FuriString* path = NULL;
+    XRemoteMacro* macro = NULL;
+
+    /* Show file selection dialog and load the macro with its remotes */
+    if(xremote_app_browser_select_file(&path, XREMOTE_MACRO_EXTENSION))
+        macro = xremote_macro_alloc_from_path(app_ctx, path);
+
+    if(path != NULL) furi_string_free(path);
+    xremote_app_assert(macro, NULL);
+
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+    xremote_app_view_alloc2(app, XRemoteViewMacro, xremote_macro_view_alloc, macro);
+    xremote_app_view_set_previous_callback(app, xremote_macro_view_exit_callback);
+    xremote_app_set_user_context(app, macro, xremote_macro_clear_callback);
+
+    macro->view = app->view_ctx;
+    return app;
+}
@@ -0,0 +1,37 @@
+/*!
+ *  @file flipper-xremote/xremote_macro.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Macro player for timed sequences of buttons from multiple remotes.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+
+#define XREMOTE_MACRO_EXTENSION ".xrm"
+#define XREMOTE_MACRO_FILETYPE  "XRemote Macro"
+#define XREMOTE_MACRO_VERSION   1
+
+typedef enum {
+    XRemoteMacroStateIdle,
+    XRemoteMacroStatePlaying,
+    XRemoteMacroStateDone,
+    XRemoteMacroStateCancelled
+} XRemoteMacroState;
+
+typedef struct XRemoteMacro XRemoteMacro;
+
+XRemoteAppContext* xremote_macro_get_app_context(XRemoteMacro* macro);
+XRemoteMacroState xremote_macro_get_state(XRemoteMacro* macro);
+const char* xremote_macro_get_state_str(XRemoteMacro* macro);
+const char* xremote_macro_get_name(XRemoteMacro* macro);
+const char* xremote_macro_get_button(XRemoteMacro* macro);
+size_t xremote_macro_get_step_count(XRemoteMacro* macro);
+size_t xremote_macro_get_step(XRemoteMacro* macro);
+
+void xremote_macro_play(XRemoteMacro* macro);
+void xremote_macro_cancel(XRemoteMacro* macro);
+
+XRemoteApp* xremote_macro_alloc(XRemoteAppContext* app_ctx);
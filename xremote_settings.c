@@ -7,6 +7,7 @@
  */
 
 #include "xremote_settings.h"
+#include "xremote_consensus.h"
 
 typedef struct {
     VariableItemList* item_list;
@@ -25,6 +26,11 @@ typedef struct {
 #define XREMOTE_ALT_NAMES_TEXT "Alt Names"
 #define XREMOTE_ALT_NAMES_MAX 2
 
+#define XREMOTE_LEARN_CAPTURES_TEXT "Learn Captures"
+
+#define XREMOTE_CAPTURE_LOG_TEXT "Capture Log"
+#define XREMOTE_CAPTURE_LOG_MAX  2
+
 static uint32_t xremote_settings_view_exit_callback(void* context) {
     UNUSED(context);
     return XRemoteViewSubmenu;
@@ -82,6 +88,27 @@ static void infrared_settings_alt_names_changed(VariableItem* item) {
     xremote_app_settings_store(settings);
 }
 
+static void infrared_settings_learn_captures_changed(VariableItem* item) {
+    XRemoteSettingsContext* ctx = variable_item_get_context(item);
+    XRemoteAppSettings* settings = ctx->app_ctx->app_settings;
+    char captures_str[8];
+
+    settings->learn_captures = variable_item_get_current_value_index(item) + 1;
+    snprintf(captures_str, sizeof(captures_str), "%lu", settings->learn_captures);
+
+    variable_item_set_current_value_text(item, captures_str);
+    xremote_app_settings_store(settings);
+}
+
+static void infrared_settings_capture_log_changed(VariableItem* item) {
+    XRemoteSettingsContext* ctx = variable_item_get_context(item);
+    XRemoteAppSettings* settings = ctx->app_ctx->app_settings;
+
+    settings->capture_log = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, settings->capture_log ? "On" : "Off");
+    xremote_app_settings_store(settings);
+}
+
 static XRemoteSettingsContext* xremote_settings_context_alloc(XRemoteAppContext* app_ctx) {
     XRemoteSettingsContext* context = malloc(sizeof(XRemoteSettingsContext));
     XRemoteAppSettings* settings = app_ctx->app_settings;
@@ -152,6 +179,32 @@ static XRemoteSettingsContext* xremote_settings_context_alloc(XRemoteAppContext*
     variable_item_set_current_value_index(item, settings->alt_names);
     variable_item_set_current_value_text(item, xremote_app_get_alt_names_str(settings->alt_names));
 
+    /* Add number of captures averaged per learned button */
+    item = variable_item_list_add(
+        context->item_list,
+        XREMOTE_LEARN_CAPTURES_TEXT,
+        XREMOTE_CONSENSUS_CAPTURES,
+        infrared_settings_learn_captures_changed,
+        context);
+
+    /* Set learn captures item index and string */
+    settings->learn_captures = CLAMP(settings->learn_captures, XREMOTE_CONSENSUS_CAPTURES, 1);
+    snprintf(repeat_str, sizeof(repeat_str), "%lu", settings->learn_captures);
+    variable_item_set_current_value_index(item, settings->learn_captures - 1);
+    variable_item_set_current_value_text(item, repeat_str);
+
+    /* Add analyzer capture log switch to variable item list */
+    item = variable_item_list_add(
+        context->item_list,
+        XREMOTE_CAPTURE_LOG_TEXT,
+        XREMOTE_CAPTURE_LOG_MAX,
+        infrared_settings_capture_log_changed,
+        context);
+
+    settings->capture_log = settings->capture_log ? 1 : 0;
+    variable_item_set_current_value_index(item, settings->capture_log);
+    variable_item_set_current_value_text(item, settings->capture_log ? "On" : "Off");
+
     return context;
 }
 
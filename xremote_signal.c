@@ -7,6 +7,7 @@
  */
 
 #include "xremote_signal.h"
+#include "xremote_fingerprint.h"
 
 struct XRemoteSignalReceiver {
     XRemoteClearCallback on_clear;
@@ -16,13 +17,122 @@ struct XRemoteSignalReceiver {
     InfraredWorker* worker;
     InfraredSignal* signal;
 
+    /* Fixed capacity capture buffer referenced by the signal */
+    uint32_t* timings;
+
+    /* Rules checked before anything is copied and the last accepted code */
+    XRemoteSignalFilter filter;
+    InfraredMessage last_message;
+    uint32_t last_hash;
+    uint32_t last_tick;
+    bool last_raw;
+    bool has_last;
+
     void* context;
+    volatile bool captured;
+    bool continuous;
     bool started;
 };
 
+void xremote_signal_filter_reset(XRemoteSignalFilter* filter) {
+    xremote_app_assert_void(filter);
+    filter->whitelist_count = 0;
+    filter->min_timings = XREMOTE_SIGNAL_MIN_TIMINGS;
+    filter->repeat_ms = XREMOTE_SIGNAL_REPEAT_MS;
+}
+
+bool xremote_signal_filter_allow(
+    XRemoteSignalFilter* filter,
+    InfraredProtocol protocol,
+    uint32_t address,
+    bool any_address) {
+    xremote_app_assert(filter, false);
+    xremote_app_assert((filter->whitelist_count < XREMOTE_SIGNAL_WHITELIST), false);
+
+    XRemoteSignalMatch* match = &filter->whitelist[filter->whitelist_count++];
+    match->protocol = protocol;
+    match->address = address;
+    match->any_address = any_address;
+    return true;
+}
+
+static bool xremote_signal_filter_match(XRemoteSignalFilter* filter, const InfraredMessage* msg) {
+    if(!filter->whitelist_count) return true;
+
+    for(size_t i = 0; i < filter->whitelist_count; i++) {
+        XRemoteSignalMatch* match = &filter->whitelist[i];
+        if(match->protocol != msg->protocol) continue;
+        if(match->any_address || match->address == msg->address) return true;
+    }
+
+    return false;
+}
+
+static bool xremote_signal_receiver_is_repeat(
+    XRemoteSignalReceiver* rx_ctx,
+    const InfraredMessage* message,
+    const uint32_t* timings,
+    size_t timings_size) {
+    uint32_t tick = furi_get_tick();
+    bool is_raw = message == NULL;
+    bool repeat = false;
+
+    /* Raw captures have jitter, the same timing shape within the window is the same code */
+    uint32_t hash = is_raw ? xremote_fingerprint_raw(timings, timings_size) : 0;
+
+    if(rx_ctx->has_last && tick - rx_ctx->last_tick < furi_ms_to_ticks(rx_ctx->filter.repeat_ms)) {
+        if(!is_raw)
+            repeat = !rx_ctx->last_raw && rx_ctx->last_message.protocol == message->protocol &&
+                     rx_ctx->last_message.address == message->address &&
+                     rx_ctx->last_message.command == message->command;
+        else
+            repeat = rx_ctx->last_raw && rx_ctx->last_hash == hash;
+    }
+
+    /* Holding a button keeps extending the window until it is released */
+    if(!is_raw) rx_ctx->last_message = *message;
+    rx_ctx->last_hash = hash;
+    rx_ctx->last_raw = is_raw;
+    rx_ctx->last_tick = tick;
+    rx_ctx->has_last = true;
+
+    return repeat;
+}
+
+static bool xremote_signal_receiver_accept(
+    XRemoteSignalReceiver* rx_ctx,
+    InfraredWorkerSignal* ir_signal) {
+    XRemoteSignalFilter* filter = &rx_ctx->filter;
+
+    if(infrared_worker_signal_is_decoded(ir_signal)) {
+        const InfraredMessage* message = infrared_worker_get_decoded_signal(ir_signal);
+        if(!xremote_signal_filter_match(filter, message)) return false;
+        if(!filter->repeat_ms) return true;
+        return !xremote_signal_receiver_is_repeat(rx_ctx, message, NULL, 0) && !message->repeat;
+    }
+
+    /* Raw captures have no protocol or address, whitelist accepts decoded codes only */
+    if(filter->whitelist_count) return false;
+
+    const uint32_t* timings;
+    size_t timings_size = 0;
+
+    infrared_worker_get_raw_signal(ir_signal, &timings, &timings_size);
+    if(timings_size < filter->min_timings) return false;
+    if(!filter->repeat_ms) return true;
+
+    return !xremote_signal_receiver_is_repeat(rx_ctx, NULL, timings, timings_size);
+}
+
 static void xremote_signal_receiver_rx_callback(void* context, InfraredWorkerSignal* ir_signal) {
     furi_assert(context);
     XRemoteSignalReceiver* rx_ctx = context;
+
+    /* Keep the delivered capture intact until the receiver is restarted */
+    xremote_app_assert_void(!rx_ctx->captured);
+
+    /* Rejected codes never reach the capture buffer, the LED or the event queue */
+    if(!xremote_signal_receiver_accept(rx_ctx, ir_signal)) return;
     xremote_app_notification_blink(rx_ctx->notifications);
 
     if(infrared_worker_signal_is_decoded(ir_signal)) {
@@ -34,14 +144,22 @@ static void xremote_signal_receiver_rx_callback(void* context, InfraredWorkerSig
         size_t timings_size = 0;
 
         infrared_worker_get_raw_signal(ir_signal, &timings, &timings_size);
-        infrared_signal_set_raw_signal(
+        if(timings_size > MAX_TIMINGS_AMOUNT) timings_size = MAX_TIMINGS_AMOUNT;
+        memcpy(rx_ctx->timings, timings, timings_size * sizeof(uint32_t));
+
+        infrared_signal_set_raw_signal_ref(
             rx_ctx->signal,
-            timings,
+            rx_ctx->timings,
             timings_size,
             INFRARED_COMMON_CARRIER_FREQUENCY,
             INFRARED_COMMON_DUTY_CYCLE);
+
+        /* Repeated frames are collapsed and regenerated on transmit */
+        infrared_signal_compact_raw(rx_ctx->signal);
     }
 
+    /* Continuous receiver hands over every capture, the callback must copy it */
+    if(!rx_ctx->continuous) rx_ctx->captured = true;
     if(rx_ctx->rx_callback != NULL) rx_ctx->rx_callback(rx_ctx->context, rx_ctx->signal);
 }
 
@@ -61,10 +179,16 @@ XRemoteSignalReceiver* xremote_signal_receiver_alloc(XRemoteAppContext* app_ctx)
     rx_ctx->worker = infrared_worker_alloc();
 
     rx_ctx->notifications = app_ctx->notifications;
+    rx_ctx->timings = NULL;
+    rx_ctx->captured = false;
+    rx_ctx->continuous = false;
     rx_ctx->rx_callback = NULL;
     rx_ctx->on_clear = NULL;
     rx_ctx->context = NULL;
     rx_ctx->started = false;
+    rx_ctx->has_last = false;
+
+    xremote_signal_filter_reset(&rx_ctx->filter);
     return rx_ctx;
 }
 
@@ -74,6 +198,7 @@ void xremote_signal_receiver_free(XRemoteSignalReceiver* rx_ctx) {
     infrared_worker_free(rx_ctx->worker);
     infrared_signal_free(rx_ctx->signal);
     xremote_signal_receiver_clear_context(rx_ctx);
+    if(rx_ctx->timings != NULL) free(rx_ctx->timings);
     free(rx_ctx);
 }
 
@@ -93,6 +218,23 @@ void xremote_signal_receiver_set_rx_callback(
     rx_ctx->rx_callback = rx_callback;
 }
 
+void xremote_signal_receiver_set_continuous(XRemoteSignalReceiver* rx_ctx, bool continuous) {
+    xremote_app_assert_void(rx_ctx);
+    rx_ctx->continuous = continuous;
+}
+
+void xremote_signal_receiver_set_filter(
+    XRemoteSignalReceiver* rx_ctx,
+    const XRemoteSignalFilter* filter) {
+    xremote_app_assert_void(rx_ctx);
+    rx_ctx->filter = *filter;
+}
+
+XRemoteSignalFilter* xremote_signal_receiver_get_filter(XRemoteSignalReceiver* rx_ctx) {
+    xremote_app_assert(rx_ctx, NULL);
+    return &rx_ctx->filter;
+}
+
 void xremote_signal_receiver_attach(XRemoteSignalReceiver* rx_ctx) {
     xremote_app_assert_void((rx_ctx && rx_ctx->worker));
     infrared_worker_rx_set_received_signal_callback(
@@ -106,6 +248,11 @@ void xremote_signal_receiver_detach(XRemoteSignalReceiver* rx_ctx) {
 
 void xremote_signal_receiver_start(XRemoteSignalReceiver* rx_ctx) {
     xremote_app_assert_void((rx_ctx && !rx_ctx->started));
+
+    /* Allocate capture buffer once, captures are written in place */
+    if(rx_ctx->timings == NULL) rx_ctx->timings = malloc(MAX_TIMINGS_AMOUNT * sizeof(uint32_t));
+
+    rx_ctx->captured = false;
     xremote_signal_receiver_attach(rx_ctx);
     infrared_worker_rx_start(rx_ctx->worker);
     xremote_app_notification_blink(rx_ctx->notifications);
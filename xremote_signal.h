@@ -11,6 +11,32 @@
 #include "xremote_app.h"
 #include "infrared/infrared_signal.h"
 
+/* Raw captures shorter than this are noise, same code within the interval is a repeat */
+#define XREMOTE_SIGNAL_MIN_TIMINGS 6
+#define XREMOTE_SIGNAL_REPEAT_MS   300
+#define XREMOTE_SIGNAL_WHITELIST   4
+
+typedef struct {
+    InfraredProtocol protocol;
+    uint32_t address;
+    bool any_address;
+} XRemoteSignalMatch;
+
+/* Empty whitelist accepts every protocol, a non-empty one rejects all raw captures */
+typedef struct {
+    XRemoteSignalMatch whitelist[XREMOTE_SIGNAL_WHITELIST];
+    size_t whitelist_count;
+    size_t min_timings;
+    uint32_t repeat_ms;
+} XRemoteSignalFilter;
+
+void xremote_signal_filter_reset(XRemoteSignalFilter* filter);
+bool xremote_signal_filter_allow(
+    XRemoteSignalFilter* filter,
+    InfraredProtocol protocol,
+    uint32_t address,
+    bool any_address);
+
 typedef void (*XRemoteRxCallback)(void* context, InfraredSignal* signal);
 typedef struct XRemoteSignalReceiver XRemoteSignalReceiver;
 
@@ -25,6 +51,13 @@ void xremote_signal_receiver_set_context(
 void xremote_signal_receiver_set_rx_callback(
     XRemoteSignalReceiver* rx_ctx,
     XRemoteRxCallback rx_callback);
+void xremote_signal_receiver_set_continuous(XRemoteSignalReceiver* rx_ctx, bool continuous);
+
+/* Filter is read by the worker thread, change it only while the receiver is stopped */
+void xremote_signal_receiver_set_filter(
+    XRemoteSignalReceiver* rx_ctx,
+    const XRemoteSignalFilter* filter);
+XRemoteSignalFilter* xremote_signal_receiver_get_filter(XRemoteSignalReceiver* rx_ctx);
 
 void xremote_signal_receiver_detach(XRemoteSignalReceiver* rx_ctx);
 void xremote_signal_receiver_attach(XRemoteSignalReceiver* rx_ctx);
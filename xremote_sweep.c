@@ -0,0 +1,641 @@
+/*!
+ *  @file flipper-xremote/xremote_sweep.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Protocol address and command sweeper for devices without a remote.
+ */
+
+#include "xremote_sweep.h"
+#include "views/xremote_sweep_view.h"
+
+#define TAG "XRemoteSweep"
+
+#define XREMOTE_SWEEP_RATE_MAX 5
+#define XREMOTE_SWEEP_SPIN_MAX 3
+
+typedef enum {
+    XRemoteSweepItemProtocol,
+    XRemoteSweepItemAddrFrom,
+    XRemoteSweepItemAddrTo,
+    XRemoteSweepItemCmdFrom,
+    XRemoteSweepItemCmdTo,
+    XRemoteSweepItemRate,
+    XRemoteSweepItemPause,
+    XRemoteSweepItemStart,
+    XRemoteSweepItemMax
+} XRemoteSweepItem;
+
+/* Step period in milliseconds, zero keeps the transmitter always busy */
+static const uint32_t g_sweep_periods[XREMOTE_SWEEP_RATE_MAX] = {0, 100, 250, 500, 1000};
+static const char* g_sweep_rates[XREMOTE_SWEEP_RATE_MAX] = {"Max", "10/s", "4/s", "2/s", "1/s"};
+
+struct XRemoteSweep {
+    InfraredProtocol protocols[InfraredProtocolMAX];
+    uint8_t protocol_count;
+    uint8_t protocol_index;
+
+    VariableItem* items[XRemoteSweepItemMax];
+    VariableItemList* item_list;
+    XRemoteAppContext* app_ctx;
+    InfraredRemote* remote;
+    InfraredSignal* hit;
+    XRemoteView* view;
+    FuriTimer* timer;
+
+    /* The only generated code, every step mutates it in place */
+    InfraredMessage message;
+    XRemoteSweepState state;
+    bool started;
+
+    uint32_t addr_from;
+    uint32_t addr_to;
+    uint32_t cmd_from;
+    uint32_t cmd_to;
+    uint32_t rate;
+    uint32_t hits;
+    bool pause_on_key;
+};
+
+static uint32_t xremote_sweep_get_max(uint8_t bits) {
+    return bits >= 32 ? UINT32_MAX : (1UL << bits) - 1;
+}
+
+static InfraredProtocol xremote_sweep_get_protocol(XRemoteSweep* sweep) {
+    return sweep->protocols[sweep->protocol_index];
+}
+
+static uint32_t xremote_sweep_get_addr_max(XRemoteSweep* sweep) {
+    InfraredProtocol protocol = xremote_sweep_get_protocol(sweep);
+    return xremote_sweep_get_max(infrared_get_protocol_address_length(protocol));
+}
+
+static uint32_t xremote_sweep_get_cmd_max(XRemoteSweep* sweep) {
+    InfraredProtocol protocol = xremote_sweep_get_protocol(sweep);
+    return xremote_sweep_get_max(infrared_get_protocol_command_length(protocol));
+}
+
+XRemoteAppContext* xremote_sweep_get_app_context(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, NULL);
+    return sweep->app_ctx;
+}
+
+XRemoteSweepState xremote_sweep_get_state(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, XRemoteSweepStateSetup);
+    return sweep->state;
+}
+
+const char* xremote_sweep_get_state_str(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, "");
+    if(sweep->state == XRemoteSweepStateRunning) return "Sweeping";
+    if(sweep->state == XRemoteSweepStatePaused) return "Paused";
+    if(sweep->state == XRemoteSweepStateDone) return "Done";
+    return "Ready";
+}
+
+const InfraredMessage* xremote_sweep_get_message(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, NULL);
+    return &sweep->message;
+}
+
+const char* xremote_sweep_get_rate_str(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, "");
+    return g_sweep_rates[sweep->rate];
+}
+
+uint32_t xremote_sweep_get_position(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, 0);
+    if(!sweep->started) return 0;
+
+    uint64_t cmd_span = (uint64_t)sweep->cmd_to - sweep->cmd_from + 1;
+    uint64_t position = (sweep->message.address - sweep->addr_from) * cmd_span +
+                        (sweep->message.command - sweep->cmd_from) + 1;
+
+    return position > UINT32_MAX ? UINT32_MAX : position;
+}
+
+uint32_t xremote_sweep_get_total(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, 0);
+    uint64_t addr_span = (uint64_t)sweep->addr_to - sweep->addr_from + 1;
+    uint64_t cmd_span = (uint64_t)sweep->cmd_to - sweep->cmd_from + 1;
+    uint64_t total = addr_span * cmd_span;
+
+    return total > UINT32_MAX ? UINT32_MAX : total;
+}
+
+uint32_t xremote_sweep_get_hits(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, 0);
+    return sweep->hits;
+}
+
+bool xremote_sweep_is_pause_on_key(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, false);
+    return sweep->pause_on_key;
+}
+
+static void xremote_sweep_update_view(XRemoteSweep* sweep) {
+    if(sweep->view == NULL) return;
+
+    with_view_model(
+        xremote_view_get_view(sweep->view),
+        XRemoteViewModel * model,
+        { model->context = sweep; },
+        true);
+}
+
+static void xremote_sweep_set_hex_text(VariableItem* item, uint32_t value, uint8_t bits) {
+    char text[16];
+    int digits = bits ? (bits + 3) / 4 : 1;
+    snprintf(text, sizeof(text), "0x%0*lX", digits, value);
+    variable_item_set_current_value_text(item, text);
+}
+
+static void xremote_sweep_update_items(XRemoteSweep* sweep) {
+    InfraredProtocol protocol = xremote_sweep_get_protocol(sweep);
+    uint8_t addr_bits = infrared_get_protocol_address_length(protocol);
+    uint8_t cmd_bits = infrared_get_protocol_command_length(protocol);
+    VariableItem** items = sweep->items;
+
+    variable_item_set_current_value_text(
+        items[XRemoteSweepItemProtocol], infrared_get_protocol_name(protocol));
+    xremote_sweep_set_hex_text(items[XRemoteSweepItemAddrFrom], sweep->addr_from, addr_bits);
+    xremote_sweep_set_hex_text(items[XRemoteSweepItemAddrTo], sweep->addr_to, addr_bits);
+    xremote_sweep_set_hex_text(items[XRemoteSweepItemCmdFrom], sweep->cmd_from, cmd_bits);
+    xremote_sweep_set_hex_text(items[XRemoteSweepItemCmdTo], sweep->cmd_to, cmd_bits);
+
+    variable_item_set_current_value_text(items[XRemoteSweepItemRate], g_sweep_rates[sweep->rate]);
+    variable_item_set_current_value_text(
+        items[XRemoteSweepItemPause], sweep->pause_on_key ? "Any Key" : "OK Only");
+
+    const char* start_str = sweep->started ? "Resume" : "Start";
+    variable_item_set_current_value_text(items[XRemoteSweepItemStart], start_str);
+}
+
+static void xremote_sweep_reset(XRemoteSweep* sweep) {
+    furi_timer_stop(sweep->timer);
+    sweep->state = XRemoteSweepStateSetup;
+    sweep->started = false;
+
+    sweep->message.protocol = xremote_sweep_get_protocol(sweep);
+    sweep->message.address = sweep->addr_from;
+    sweep->message.command = sweep->cmd_from;
+    sweep->message.repeat = false;
+}
+
+static bool xremote_sweep_advance(XRemoteSweep* sweep, bool forward) {
+    InfraredMessage* message = &sweep->message;
+
+    /* Commands are swept first, address moves on when the command range wraps */
+    if(forward) {
+        if(message->command < sweep->cmd_to)
+            message->command++;
+        else if(message->address < sweep->addr_to) {
+            message->address++;
+            message->command = sweep->cmd_from;
+        } else
+            return false;
+    } else {
+        if(message->command > sweep->cmd_from)
+            message->command--;
+        else if(message->address > sweep->addr_from) {
+            message->address--;
+            message->command = sweep->cmd_to;
+        } else
+            return false;
+    }
+
+    return true;
+}
+
+static bool xremote_sweep_send(XRemoteSweep* sweep) {
+    XRemoteAppContext* app_ctx = sweep->app_ctx;
+    uint32_t repeat = app_ctx->app_settings->repeat_count;
+    return xremote_transmitter_send_message(app_ctx->transmitter, &sweep->message, repeat);
+}
+
+static bool xremote_sweep_checkpoint_store(XRemoteSweep* sweep) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+
+    InfraredProtocol protocol = xremote_sweep_get_protocol(sweep);
+    uint32_t resume = sweep->started && sweep->state != XRemoteSweepStateDone;
+    uint32_t pause = sweep->pause_on_key;
+    bool success = false;
+
+    do {
+        /* Checkpoint is small and written only when the sweep stops */
+        if(!flipper_format_file_open_always(ff, XREMOTE_SWEEP_CHECKPOINT)) break;
+        if(!flipper_format_write_header_cstr(ff, XREMOTE_SWEEP_FILETYPE, XREMOTE_SWEEP_VERSION))
+            break;
+
+        const char* name = infrared_get_protocol_name(protocol);
+        if(!flipper_format_write_string_cstr(ff, "protocol", name)) break;
+        if(!flipper_format_write_uint32(ff, "addrFrom", &sweep->addr_from, 1)) break;
+        if(!flipper_format_write_uint32(ff, "addrTo", &sweep->addr_to, 1)) break;
+        if(!flipper_format_write_uint32(ff, "cmdFrom", &sweep->cmd_from, 1)) break;
+        if(!flipper_format_write_uint32(ff, "cmdTo", &sweep->cmd_to, 1)) break;
+        if(!flipper_format_write_uint32(ff, "rate", &sweep->rate, 1)) break;
+        if(!flipper_format_write_uint32(ff, "pause", &pause, 1)) break;
+        if(!flipper_format_write_uint32(ff, "resume", &resume, 1)) break;
+        if(!flipper_format_write_uint32(ff, "address", &sweep->message.address, 1)) break;
+        if(!flipper_format_write_uint32(ff, "command", &sweep->message.command, 1)) break;
+
+        success = true;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(ff);
+
+    return success;
+}
+
+static bool xremote_sweep_checkpoint_load(XRemoteSweep* sweep) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* header = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    uint32_t values[XRemoteSweepItemMax];
+    uint32_t version = 0;
+    uint32_t resume = 0;
+    bool success = false;
+
+    do {
+        /* Open file and read the header */
+        if(!flipper_format_buffered_file_open_existing(ff, XREMOTE_SWEEP_CHECKPOINT)) break;
+        if(!flipper_format_read_header(ff, header, &version)) break;
+        if(!furi_string_equal(header, XREMOTE_SWEEP_FILETYPE)) break;
+        if(version != XREMOTE_SWEEP_VERSION) break;
+
+        if(!flipper_format_read_string(ff, "protocol", name)) break;
+        InfraredProtocol protocol = infrared_get_protocol_by_name(furi_string_get_cstr(name));
+
+        uint8_t index;
+        for(index = 0; index < sweep->protocol_count; index++)
+            if(sweep->protocols[index] == protocol) break;
+        if(index == sweep->protocol_count) break;
+
+        if(!flipper_format_read_uint32(ff, "addrFrom", &values[XRemoteSweepItemAddrFrom], 1))
+            break;
+        if(!flipper_format_read_uint32(ff, "addrTo", &values[XRemoteSweepItemAddrTo], 1)) break;
+        if(!flipper_format_read_uint32(ff, "cmdFrom", &values[XRemoteSweepItemCmdFrom], 1)) break;
+        if(!flipper_format_read_uint32(ff, "cmdTo", &values[XRemoteSweepItemCmdTo], 1)) break;
+        if(!flipper_format_read_uint32(ff, "rate", &values[XRemoteSweepItemRate], 1)) break;
+        if(!flipper_format_read_uint32(ff, "pause", &values[XRemoteSweepItemPause], 1)) break;
+        if(!flipper_format_read_uint32(ff, "resume", &resume, 1)) break;
+        if(!flipper_format_read_uint32(ff, "address", &sweep->message.address, 1)) break;
+        if(!flipper_format_read_uint32(ff, "command", &sweep->message.command, 1)) break;
+
+        /* Ranges are validated against the protocol before anything is applied */
+        uint32_t addr_max = xremote_sweep_get_max(infrared_get_protocol_address_length(protocol));
+        uint32_t cmd_max = xremote_sweep_get_max(infrared_get_protocol_command_length(protocol));
+
+        if(values[XRemoteSweepItemAddrFrom] > values[XRemoteSweepItemAddrTo] ||
+           values[XRemoteSweepItemAddrTo] > addr_max ||
+           values[XRemoteSweepItemCmdFrom] > values[XRemoteSweepItemCmdTo] ||
+           values[XRemoteSweepItemCmdTo] > cmd_max ||
+           values[XRemoteSweepItemRate] >= XREMOTE_SWEEP_RATE_MAX)
+            break;
+
+        sweep->protocol_index = index;
+        sweep->addr_from = values[XRemoteSweepItemAddrFrom];
+        sweep->addr_to = values[XRemoteSweepItemAddrTo];
+        sweep->cmd_from = values[XRemoteSweepItemCmdFrom];
+        sweep->cmd_to = values[XRemoteSweepItemCmdTo];
+        sweep->rate = values[XRemoteSweepItemRate];
+        sweep->pause_on_key = values[XRemoteSweepItemPause];
+        success = true;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(header);
+    furi_string_free(name);
+    flipper_format_free(ff);
+
+    uint32_t address = sweep->message.address;
+    uint32_t command = sweep->message.command;
+    xremote_sweep_reset(sweep);
+
+    /* Position is restored only when it is still inside the sweep ranges */
+    if(success && resume && address >= sweep->addr_from && address <= sweep->addr_to &&
+       command >= sweep->cmd_from && command <= sweep->cmd_to) {
+        sweep->message.address = address;
+        sweep->message.command = command;
+        sweep->state = XRemoteSweepStatePaused;
+        sweep->started = true;
+    }
+
+    return success;
+}
+
+static void xremote_sweep_run_step(XRemoteSweep* sweep) {
+    XRemoteTransmitter* transmitter = sweep->app_ctx->transmitter;
+    if(xremote_transmitter_get_pending(transmitter) >= XREMOTE_SWEEP_PENDING_MAX) return;
+
+    if(!sweep->started)
+        sweep->started = true;
+    else if(!xremote_sweep_advance(sweep, true)) {
+        furi_timer_stop(sweep->timer);
+        sweep->state = XRemoteSweepStateDone;
+        xremote_sweep_checkpoint_store(sweep);
+        xremote_sweep_update_items(sweep);
+        xremote_sweep_update_view(sweep);
+        return;
+    }
+
+    xremote_sweep_send(sweep);
+    xremote_sweep_update_view(sweep);
+}
+
+static void xremote_sweep_timer_callback(void* context) {
+    XRemoteSweep* sweep = context;
+    view_dispatcher_send_custom_event(sweep->app_ctx->view_dispatcher, XRemoteEventSweepStep);
+}
+
+static bool xremote_sweep_custom_event_callback(void* context, uint32_t event) {
+    xremote_app_assert(context, false);
+    XRemoteSweep* sweep = context;
+
+    /* Codes are queued from GUI thread, transmit queue has a single producer */
+    if(event == XRemoteEventSweepStep && sweep->state == XRemoteSweepStateRunning)
+        xremote_sweep_run_step(sweep);
+
+    return true;
+}
+
+void xremote_sweep_resume(XRemoteSweep* sweep) {
+    xremote_app_assert_void(sweep);
+    if(sweep->state == XRemoteSweepStateRunning) return;
+    if(sweep->state == XRemoteSweepStateDone) xremote_sweep_reset(sweep);
+
+    sweep->state = XRemoteSweepStateRunning;
+    uint32_t ticks = furi_ms_to_ticks(g_sweep_periods[sweep->rate]);
+    furi_timer_start(sweep->timer, ticks ? ticks : 1);
+
+    dolphin_deed(DolphinDeedIrSend);
+    xremote_sweep_run_step(sweep);
+}
+
+void xremote_sweep_pause(XRemoteSweep* sweep) {
+    xremote_app_assert_void(sweep);
+    if(sweep->state != XRemoteSweepStateRunning) return;
+
+    furi_timer_stop(sweep->timer);
+    sweep->state = XRemoteSweepStatePaused;
+
+    xremote_sweep_checkpoint_store(sweep);
+    xremote_sweep_update_items(sweep);
+    xremote_sweep_update_view(sweep);
+}
+
+bool xremote_sweep_step(XRemoteSweep* sweep, bool forward) {
+    xremote_app_assert(sweep, false);
+    if(sweep->state != XRemoteSweepStatePaused) return false;
+
+    /* Operator narrows down the hit by walking around the paused position */
+    if(!sweep->started)
+        sweep->started = true;
+    else if(!xremote_sweep_advance(sweep, forward))
+        return false;
+
+    xremote_sweep_update_view(sweep);
+    return xremote_sweep_send(sweep);
+}
+
+bool xremote_sweep_resend(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, false);
+    if(sweep->state != XRemoteSweepStatePaused || !sweep->started) return false;
+    return xremote_sweep_send(sweep);
+}
+
+bool xremote_sweep_save_hit(XRemoteSweep* sweep) {
+    xremote_app_assert(sweep, false);
+    xremote_app_assert(sweep->started, false);
+
+    InfraredMessage* message = &sweep->message;
+    const char* protocol_name = infrared_get_protocol_name(message->protocol);
+    char name[32];
+
+    snprintf(
+        name, sizeof(name), "%s_%lX_%lX", protocol_name, message->address, message->command);
+    if(infrared_remote_get_button_by_name(sweep->remote, name) != NULL) return true;
+
+    infrared_signal_set_message(sweep->hit, message);
+    infrared_remote_push_button(sweep->remote, name, sweep->hit);
+    if(!infrared_remote_store(sweep->remote)) return false;
+
+    FURI_LOG_I(TAG, "saved hit: \'%s\'", name);
+    sweep->hits++;
+
+    xremote_sweep_update_view(sweep);
+    return true;
+}
+
+static void xremote_sweep_protocol_changed(VariableItem* item) {
+    XRemoteSweep* sweep = variable_item_get_context(item);
+    sweep->protocol_index = variable_item_get_current_value_index(item);
+
+    /* New protocol starts with its full address and command space */
+    sweep->addr_from = 0;
+    sweep->addr_to = xremote_sweep_get_addr_max(sweep);
+    sweep->cmd_from = 0;
+    sweep->cmd_to = xremote_sweep_get_cmd_max(sweep);
+
+    xremote_sweep_reset(sweep);
+    xremote_sweep_update_items(sweep);
+}
+
+static void xremote_sweep_range_changed(VariableItem* item) {
+    XRemoteSweep* sweep = variable_item_get_context(item);
+    VariableItem** items = sweep->items;
+
+    /* Values spin around the middle index, so ranges are not limited to item count */
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_index(item, 1);
+
+    bool is_addr = item == items[XRemoteSweepItemAddrFrom] ||
+                   item == items[XRemoteSweepItemAddrTo];
+    bool is_from = item == items[XRemoteSweepItemAddrFrom] ||
+                   item == items[XRemoteSweepItemCmdFrom];
+
+    uint32_t max = is_addr ? xremote_sweep_get_addr_max(sweep) : xremote_sweep_get_cmd_max(sweep);
+    uint32_t* from = is_addr ? &sweep->addr_from : &sweep->cmd_from;
+    uint32_t* to = is_addr ? &sweep->addr_to : &sweep->cmd_to;
+    uint32_t* value = is_from ? from : to;
+
+    if(index == 0)
+        *value = *value ? *value - 1 : max;
+    else if(index == 2)
+        *value = *value < max ? *value + 1 : 0;
+
+    if(*from > *to) {
+        if(is_from)
+            *to = *from;
+        else
+            *from = *to;
+    }
+
+    xremote_sweep_reset(sweep);
+    xremote_sweep_update_items(sweep);
+}
+
+static void xremote_sweep_rate_changed(VariableItem* item) {
+    XRemoteSweep* sweep = variable_item_get_context(item);
+    sweep->rate = variable_item_get_current_value_index(item);
+    xremote_sweep_update_items(sweep);
+}
+
+static void xremote_sweep_pause_changed(VariableItem* item) {
+    XRemoteSweep* sweep = variable_item_get_context(item);
+    sweep->pause_on_key = variable_item_get_current_value_index(item);
+    xremote_sweep_update_items(sweep);
+}
+
+static void xremote_sweep_enter_callback(void* context, uint32_t index) {
+    XRemoteSweep* sweep = context;
+    if(index != XRemoteSweepItemStart) return;
+
+    view_dispatcher_switch_to_view(sweep->app_ctx->view_dispatcher, XRemoteViewSweepRun);
+    xremote_sweep_resume(sweep);
+}
+
+static uint32_t xremote_sweep_setup_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+static void xremote_sweep_setup_alloc(XRemoteSweep* sweep) {
+    ViewDispatcher* view_disp = sweep->app_ctx->view_dispatcher;
+    sweep->item_list = variable_item_list_alloc();
+    VariableItem** items = sweep->items;
+
+    View* view = variable_item_list_get_view(sweep->item_list);
+    view_set_previous_callback(view, xremote_sweep_setup_exit_callback);
+    view_dispatcher_add_view(view_disp, XRemoteViewSweep, view);
+
+    items[XRemoteSweepItemProtocol] = variable_item_list_add(
+        sweep->item_list,
+        "Protocol",
+        sweep->protocol_count,
+        xremote_sweep_protocol_changed,
+        sweep);
+    variable_item_set_current_value_index(items[XRemoteSweepItemProtocol], sweep->protocol_index);
+
+    const char* range_names[] = {"Addr From", "Addr To", "Cmd From", "Cmd To"};
+    for(size_t i = 0; i < COUNT_OF(range_names); i++) {
+        VariableItem* item = variable_item_list_add(
+            sweep->item_list,
+            range_names[i],
+            XREMOTE_SWEEP_SPIN_MAX,
+            xremote_sweep_range_changed,
+            sweep);
+
+        variable_item_set_current_value_index(item, 1);
+        items[XRemoteSweepItemAddrFrom + i] = item;
+    }
+
+    items[XRemoteSweepItemRate] = variable_item_list_add(
+        sweep->item_list, "Rate", XREMOTE_SWEEP_RATE_MAX, xremote_sweep_rate_changed, sweep);
+    variable_item_set_current_value_index(items[XRemoteSweepItemRate], sweep->rate);
+
+    items[XRemoteSweepItemPause] = variable_item_list_add(
+        sweep->item_list, "Pause On", 2, xremote_sweep_pause_changed, sweep);
+    variable_item_set_current_value_index(items[XRemoteSweepItemPause], sweep->pause_on_key);
+
+    items[XRemoteSweepItemStart] =
+        variable_item_list_add(sweep->item_list, "Sweep", 1, NULL, sweep);
+    variable_item_list_set_enter_callback(sweep->item_list, xremote_sweep_enter_callback, sweep);
+
+    xremote_sweep_update_items(sweep);
+}
+
+static void xremote_sweep_free(XRemoteSweep* sweep) {
+    xremote_app_assert_void(sweep);
+    furi_timer_stop(sweep->timer);
+    furi_timer_free(sweep->timer);
+
+    ViewDispatcher* view_disp = sweep->app_ctx->view_dispatcher;
+    view_dispatcher_set_custom_event_callback(view_disp, NULL);
+    view_dispatcher_set_event_callback_context(view_disp, NULL);
+
+    if(sweep->item_list != NULL) {
+        if(sweep->started) xremote_sweep_checkpoint_store(sweep);
+        view_dispatcher_remove_view(view_disp, XRemoteViewSweep);
+        variable_item_list_free(sweep->item_list);
+    }
+
+    infrared_remote_free(sweep->remote);
+    infrared_signal_free(sweep->hit);
+    free(sweep);
+}
+
+static void xremote_sweep_clear_callback(void* context) {
+    XRemoteSweep* sweep = context;
+    xremote_sweep_free(sweep);
+}
+
+static XRemoteSweep* xremote_sweep_alloc_from_path(XRemoteAppContext* app_ctx, FuriString* path) {
+    XRemoteSweep* sweep = malloc(sizeof(XRemoteSweep));
+    sweep->remote = infrared_remote_alloc();
+    sweep->hit = infrared_signal_alloc();
+    sweep->app_ctx = app_ctx;
+    sweep->item_list = NULL;
+    sweep->view = NULL;
+
+    sweep->pause_on_key = true;
+    sweep->protocol_count = 0;
+    sweep->protocol_index = 0;
+    sweep->rate = 0;
+    sweep->hits = 0;
+
+    sweep->timer = furi_timer_alloc(xremote_sweep_timer_callback, FuriTimerTypePeriodic, sweep);
+    view_dispatcher_set_custom_event_callback(
+        app_ctx->view_dispatcher, xremote_sweep_custom_event_callback);
+    view_dispatcher_set_event_callback_context(app_ctx->view_dispatcher, sweep);
+
+    /* Hits are stored into the selected remote */
+    if(!infrared_remote_load(sweep->remote, path)) {
+        FURI_LOG_E(TAG, "failed to load remote: \'%s\'", furi_string_get_cstr(path));
+        xremote_sweep_free(sweep);
+        return NULL;
+    }
+
+    for(int i = 0; i < InfraredProtocolMAX; i++)
+        if(infrared_is_protocol_valid(i)) sweep->protocols[sweep->protocol_count++] = i;
+
+    sweep->addr_from = 0;
+    sweep->addr_to = xremote_sweep_get_addr_max(sweep);
+    sweep->cmd_from = 0;
+    sweep->cmd_to = xremote_sweep_get_cmd_max(sweep);
+
+    /* Previous sweep configuration and position are restored when available */
+    xremote_sweep_checkpoint_load(sweep);
+    xremote_sweep_setup_alloc(sweep);
+
+    return sweep;
+}
+
+static uint32_t xremote_sweep_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSweep;
+}
+
+XRemoteApp* xremote_sweep_alloc(XRemoteAppContext* app_ctx) {
+    FuriString* path = NULL;
+    XRemoteSweep* sweep = NULL;
+
+    /* Show file selection dialog for the remote receiving the hits */
+    if(xremote_app_browser_select_file(&path, XREMOTE_APP_EXTENSION))
+        sweep = xremote_sweep_alloc_from_path(app_ctx, path);
+
+    if(path != NULL) furi_string_free(path);
+    xremote_app_assert(sweep, NULL);
+
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+    xremote_app_view_alloc2(app, XRemoteViewSweepRun, xremote_sweep_view_alloc, sweep);
+    xremote_app_view_set_previous_callback(app, xremote_sweep_view_exit_callback);
+    xremote_app_set_user_context(app, sweep, xremote_sweep_clear_callback);
+
+    sweep->view = app->view_ctx;
+    return app;
+}
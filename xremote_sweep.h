@@ -0,0 +1,45 @@
+/*!
+ *  @file flipper-xremote/xremote_sweep.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Protocol address and command sweeper for devices without a remote.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+
+#define XREMOTE_SWEEP_CHECKPOINT APP_DATA_PATH("sweep.txt")
+#define XREMOTE_SWEEP_FILETYPE   "XRemote Sweep"
+#define XREMOTE_SWEEP_VERSION    1
+
+/* Sweeper keeps the transmitter busy without queueing more than it can undo */
+#define XREMOTE_SWEEP_PENDING_MAX 2
+
+typedef enum {
+    XRemoteSweepStateSetup,
+    XRemoteSweepStateRunning,
+    XRemoteSweepStatePaused,
+    XRemoteSweepStateDone
+} XRemoteSweepState;
+
+typedef struct XRemoteSweep XRemoteSweep;
+
+XRemoteAppContext* xremote_sweep_get_app_context(XRemoteSweep* sweep);
+XRemoteSweepState xremote_sweep_get_state(XRemoteSweep* sweep);
+const char* xremote_sweep_get_state_str(XRemoteSweep* sweep);
+const InfraredMessage* xremote_sweep_get_message(XRemoteSweep* sweep);
+const char* xremote_sweep_get_rate_str(XRemoteSweep* sweep);
+uint32_t xremote_sweep_get_position(XRemoteSweep* sweep);
+uint32_t xremote_sweep_get_total(XRemoteSweep* sweep);
+uint32_t xremote_sweep_get_hits(XRemoteSweep* sweep);
+bool xremote_sweep_is_pause_on_key(XRemoteSweep* sweep);
+
+void xremote_sweep_resume(XRemoteSweep* sweep);
+void xremote_sweep_pause(XRemoteSweep* sweep);
+bool xremote_sweep_step(XRemoteSweep* sweep, bool forward);
+bool xremote_sweep_resend(XRemoteSweep* sweep);
+bool xremote_sweep_save_hit(XRemoteSweep* sweep);
+
+XRemoteApp* xremote_sweep_alloc(XRemoteAppContext* app_ctx);
@@ -0,0 +1,396 @@
+/*!
+ *  @file flipper-xremote/xremote_translate.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Translator retransmitting received codes as the mapped ones of another remote.
+ */
+
+#include "xremote_translate.h"
+#include "xremote_fingerprint.h"
+#include "views/xremote_translate_view.h"
+
+#define TAG "XRemoteTranslate"
+
+typedef struct {
+    InfraredSignal* target;
+    const char* name;
+    InfraredMessage message;
+    uint32_t hash;
+    bool is_raw;
+    bool used;
+} XRemoteTranslateSlot;
+
+struct XRemoteTranslate {
+    XRemoteSignalReceiver* ir_receiver;
+    XRemoteAppContext* app_ctx;
+    InfraredRemote* target;
+    XRemoteView* view;
+    FuriMutex* mutex;
+
+    /* Open addressing table, capacity is a power of two and at least twice the mappings */
+    XRemoteTranslateSlot* slots;
+    size_t capacity;
+    size_t count;
+
+    /* Match handed from the receiver worker to the GUI thread, guarded by the mutex */
+    XRemoteTranslateSlot* pending;
+    int pending_times;
+
+    XRemoteTranslateLast last;
+    uint32_t sent;
+    uint32_t missed;
+    bool running;
+};
+
+XRemoteAppContext* xremote_translate_get_app_context(XRemoteTranslate* translate) {
+    xremote_app_assert(translate, NULL);
+    return translate->app_ctx;
+}
+
+size_t xremote_translate_get_mappings(XRemoteTranslate* translate) {
+    xremote_app_assert(translate, 0);
+    return translate->count;
+}
+
+uint32_t xremote_translate_get_sent(XRemoteTranslate* translate) {
+    xremote_app_assert(translate, 0);
+    return translate->sent;
+}
+
+uint32_t xremote_translate_get_missed(XRemoteTranslate* translate) {
+    xremote_app_assert(translate, 0);
+    return translate->missed;
+}
+
+bool xremote_translate_get_last(XRemoteTranslate* translate, XRemoteTranslateLast* last) {
+    xremote_app_assert(translate, false);
+    furi_mutex_acquire(translate->mutex, FuriWaitForever);
+    *last = translate->last;
+    furi_mutex_release(translate->mutex);
+    return last->valid;
+}
+
+bool xremote_translate_is_running(XRemoteTranslate* translate) {
+    xremote_app_assert(translate, false);
+    return translate->running;
+}
+
+void xremote_translate_send_event(XRemoteTranslate* translate, uint32_t event) {
+    xremote_app_assert_void(translate);
+    view_dispatcher_send_custom_event(translate->app_ctx->view_dispatcher, event);
+}
+
+static void xremote_translate_update_view(XRemoteTranslate* translate) {
+    if(translate->view == NULL) return;
+
+    with_view_model(
+        xremote_view_get_view(translate->view),
+        XRemoteViewModel * model,
+        { model->context = translate; },
+        true);
+}
+
+static XRemoteTranslateSlot*
+    xremote_translate_probe(XRemoteTranslate* translate, InfraredSignal* signal, uint32_t hash) {
+    bool is_raw = infrared_signal_is_raw(signal);
+    const InfraredMessage* message = is_raw ? NULL : infrared_signal_get_message(signal);
+    size_t mask = translate->capacity - 1;
+
+    /* Table is never full, probing stops at the matching or the first free slot */
+    for(size_t i = hash & mask;; i = (i + 1) & mask) {
+        XRemoteTranslateSlot* slot = &translate->slots[i];
+        if(!slot->used) return slot;
+        if(slot->hash != hash || slot->is_raw != is_raw) continue;
+
+        /* Raw codes are known by their fingerprint only, messages are compared as a whole */
+        if(is_raw || (slot->message.protocol == message->protocol &&
+                      slot->message.address == message->address &&
+                      slot->message.command == message->command))
+            return slot;
+    }
+}
+
+static bool xremote_translate_add(
+    XRemoteTranslate* translate,
+    InfraredRemoteButton* source,
+    InfraredRemoteButton* target) {
+    xremote_app_assert((source && target), false);
+    InfraredSignal* signal = infrared_remote_button_get_signal(source);
+    InfraredSignal* target_signal = infrared_remote_button_get_signal(target);
+    xremote_app_assert((signal && target_signal), false);
+
+    /* Received raw codes are compacted to a single frame, so are the stored ones */
+    bool is_raw = infrared_signal_is_raw(signal);
+    if(is_raw) infrared_signal_compact_raw(signal);
+
+    uint32_t hash = xremote_fingerprint_signal(signal);
+    XRemoteTranslateSlot* slot = xremote_translate_probe(translate, signal, hash);
+
+    /* Explicit pairs are added first and win over the ones paired by name */
+    if(slot->used) return false;
+
+    if(!is_raw) slot->message = *infrared_signal_get_message(signal);
+    slot->target = target_signal;
+    slot->name = infrared_remote_button_get_name(target);
+    slot->is_raw = is_raw;
+    slot->hash = hash;
+    slot->used = true;
+
+    translate->count++;
+    return true;
+}
+
+static void
+    xremote_translate_add_pair(XRemoteTranslate* translate, InfraredRemote* source, char* pair) {
+    char* separator = strchr(pair, ',');
+    xremote_app_assert_void(separator);
+    *separator = '\0';
+
+    char* target_name = separator + 1;
+    while(*target_name == ' ') target_name++;
+
+    bool alt_names = translate->app_ctx->app_settings->alt_names;
+    InfraredRemoteButton* button = infrared_remote_get_button_by_name(source, pair);
+    InfraredRemoteButton* target =
+        xremote_button_lookup(translate->target, target_name, alt_names);
+
+    if(!xremote_translate_add(translate, button, target))
+        FURI_LOG_W(TAG, "skipping pair: \'%s\' -> \'%s\'", pair, target_name);
+}
+
+static bool xremote_translate_load(XRemoteTranslate* translate) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    InfraredRemote* source = infrared_remote_alloc();
+    FuriString* header = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+
+    bool alt_names = translate->app_ctx->app_settings->alt_names;
+    uint32_t version = 0;
+    bool success = false;
+
+    do {
+        /* Open file and read the header */
+        if(!flipper_format_buffered_file_open_existing(ff, XREMOTE_TRANSLATE_FILE)) break;
+        if(!flipper_format_read_header(ff, header, &version)) break;
+        if(!furi_string_equal(header, XREMOTE_TRANSLATE_FILETYPE)) break;
+        if(version != XREMOTE_TRANSLATE_VERSION) break;
+
+        /* Both remotes are loaded once, only the target one is kept for transmit */
+        if(!flipper_format_read_string(ff, "Source", value)) break;
+        if(!infrared_remote_load(source, value)) break;
+        if(!flipper_format_read_string(ff, "Target", value)) break;
+        if(!infrared_remote_load(translate->target, value)) break;
+
+        size_t buttons = infrared_remote_get_button_count(source);
+        translate->capacity = 8;
+        while(translate->capacity < buttons * 2) translate->capacity <<= 1;
+        translate->slots = calloc(translate->capacity, sizeof(XRemoteTranslateSlot));
+
+        while(flipper_format_read_string(ff, "Map", value)) {
+            char pair[XREMOTE_NAME_MAX * 2 + 2];
+            snprintf(pair, sizeof(pair), "%s", furi_string_get_cstr(value));
+            xremote_translate_add_pair(translate, source, pair);
+        }
+
+        /* Every other source button is sent as the target button of the same name */
+        for(size_t i = 0; i < buttons; i++) {
+            InfraredRemoteButton* button = infrared_remote_get_button(source, i);
+            const char* name = infrared_remote_button_get_name(button);
+            InfraredRemoteButton* target =
+                xremote_button_lookup(translate->target, name, alt_names);
+            if(target != NULL) xremote_translate_add(translate, button, target);
+        }
+
+        FURI_LOG_I(TAG, "loaded %u mappings of %u buttons", translate->count, buttons);
+        success = translate->count > 0;
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    infrared_remote_free(source);
+    furi_string_free(header);
+    furi_string_free(value);
+    flipper_format_free(ff);
+
+    return success;
+}
+
+static void xremote_translate_signal_callback(void* context, InfraredSignal* signal) {
+    XRemoteTranslate* translate = context;
+    XRemoteAppContext* app_ctx = translate->app_ctx;
+
+    /* Captures arriving before the GUI thread pauses the receiver are dropped */
+    furi_mutex_acquire(translate->mutex, FuriWaitForever);
+    bool busy = translate->pending != NULL;
+    furi_mutex_release(translate->mutex);
+    if(busy) return;
+
+    XREMOTE_LATENCY_BEGIN(app_ctx->diag);
+    uint32_t hash = xremote_fingerprint_signal(signal);
+    XRemoteTranslateSlot* slot = xremote_translate_probe(translate, signal, hash);
+    XREMOTE_LATENCY_MARK(app_ctx->diag, XRemoteLatencyLookup);
+    bool is_raw = infrared_signal_is_raw(signal);
+    bool send = false;
+
+    /* Only this thread sets the pending match, the GUI thread only clears it */
+    furi_mutex_acquire(translate->mutex, FuriWaitForever);
+    if(slot->used) {
+        /* Held source button keeps sending, every repeat frame goes out once */
+        bool repeat = !is_raw && infrared_signal_get_message(signal)->repeat;
+        translate->pending_times = repeat ? 1 : (int)app_ctx->app_settings->repeat_count;
+        translate->pending = slot;
+        send = true;
+    } else {
+        translate->missed++;
+    }
+
+    XRemoteTranslateLast* last = &translate->last;
+    if(!is_raw) last->message = *infrared_signal_get_message(signal);
+    if(is_raw) last->timings_size = infrared_signal_get_raw_signal(signal)->timings_size;
+    last->target = slot->used ? slot->name : NULL;
+    last->is_raw = is_raw;
+    last->valid = true;
+    furi_mutex_release(translate->mutex);
+
+    xremote_translate_send_event(
+        translate, send ? XRemoteEventTranslateSend : XRemoteEventTranslateUpdate);
+}
+
+static void xremote_translate_transmit(XRemoteTranslate* translate) {
+    XRemoteAppContext* app_ctx = translate->app_ctx;
+
+    furi_mutex_acquire(translate->mutex, FuriWaitForever);
+    XRemoteTranslateSlot* slot = translate->pending;
+    int times = translate->pending_times;
+    furi_mutex_release(translate->mutex);
+
+    /* Paused translator drops the match, the receiver is already stopped */
+    if(slot != NULL && translate->running) {
+        /* Receiver is paused so the own transmission is never captured */
+        xremote_signal_receiver_stop(translate->ir_receiver);
+        if(xremote_transmitter_send(app_ctx->transmitter, slot->target, times)) translate->sent++;
+        xremote_transmitter_flush(app_ctx->transmitter);
+        xremote_signal_receiver_start(translate->ir_receiver);
+    }
+
+    furi_mutex_acquire(translate->mutex, FuriWaitForever);
+    translate->pending = NULL;
+    furi_mutex_release(translate->mutex);
+}
+
+static void xremote_translate_start(XRemoteTranslate* translate) {
+    if(translate->running || !translate->count) return;
+    xremote_signal_receiver_start(translate->ir_receiver);
+    translate->running = true;
+}
+
+static void xremote_translate_stop(XRemoteTranslate* translate) {
+    if(!translate->running) return;
+    xremote_signal_receiver_stop(translate->ir_receiver);
+    translate->running = false;
+}
+
+void xremote_translate_toggle(XRemoteTranslate* translate) {
+    xremote_app_assert_void(translate);
+    if(translate->running)
+        xremote_translate_stop(translate);
+    else
+        xremote_translate_start(translate);
+
+    xremote_translate_update_view(translate);
+}
+
+static bool xremote_translate_custom_event_callback(void* context, uint32_t event) {
+    xremote_app_assert(context, false);
+    XRemoteTranslate* translate = context;
+    ViewDispatcher* view_disp = translate->app_ctx->view_dispatcher;
+
+    if(event == XRemoteEventSignalExit) {
+        xremote_translate_stop(translate);
+        view_dispatcher_switch_to_view(view_disp, XRemoteViewSubmenu);
+    } else if(event == XRemoteEventTranslateSend) {
+        xremote_translate_transmit(translate);
+        xremote_translate_update_view(translate);
+    } else if(event == XRemoteEventTranslateUpdate) {
+        xremote_translate_update_view(translate);
+    }
+
+    return true;
+}
+
+static void xremote_translate_free(XRemoteTranslate* translate) {
+    xremote_app_assert_void(translate);
+    xremote_translate_stop(translate);
+
+    ViewDispatcher* view_disp = translate->app_ctx->view_dispatcher;
+    view_dispatcher_set_custom_event_callback(view_disp, NULL);
+    view_dispatcher_set_event_callback_context(view_disp, NULL);
+
+    /* Queued signals reference the target remote */
+    xremote_transmitter_flush(translate->app_ctx->transmitter);
+    xremote_signal_receiver_free(translate->ir_receiver);
+    infrared_remote_free(translate->target);
+    furi_mutex_free(translate->mutex);
+
+    if(translate->slots != NULL) free(translate->slots);
+    free(translate);
+}
+
+static void xremote_translate_clear_callback(void* context) {
+    XRemoteTranslate* translate = context;
+    xremote_translate_free(translate);
+}
+
+static XRemoteTranslate* xremote_translate_ctx_alloc(XRemoteAppContext* app_ctx) {
+    XRemoteTranslate* translate = malloc(sizeof(XRemoteTranslate));
+    translate->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    translate->target = infrared_remote_alloc();
+    translate->app_ctx = app_ctx;
+    translate->view = NULL;
+    translate->slots = NULL;
+    translate->capacity = 0;
+    translate->count = 0;
+    translate->pending = NULL;
+    translate->pending_times = 0;
+    translate->running = false;
+    translate->sent = 0;
+    translate->missed = 0;
+    memset(&translate->last, 0, sizeof(XRemoteTranslateLast));
+
+    /* Missing or broken file leaves the table empty, the view tells how to fix it */
+    if(!xremote_translate_load(translate))
+        FURI_LOG_W(TAG, "no mappings loaded from: \'%s\'", XREMOTE_TRANSLATE_FILE);
+
+    view_dispatcher_set_custom_event_callback(
+        app_ctx->view_dispatcher, xremote_translate_custom_event_callback);
+    view_dispatcher_set_event_callback_context(app_ctx->view_dispatcher, translate);
+
+    /* Every frame is translated, holding a button is passed through as it is */
+    translate->ir_receiver = xremote_signal_receiver_alloc(app_ctx);
+    xremote_signal_receiver_get_filter(translate->ir_receiver)->repeat_ms = 0;
+    xremote_signal_receiver_set_continuous(translate->ir_receiver, true);
+    xremote_signal_receiver_set_context(translate->ir_receiver, translate, NULL);
+    xremote_signal_receiver_set_rx_callback(
+        translate->ir_receiver, xremote_translate_signal_callback);
+
+    return translate;
+}
+
+static uint32_t xremote_translate_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+XRemoteApp* xremote_translate_alloc(XRemoteAppContext* app_ctx) {
+    XRemoteTranslate* translate = xremote_translate_ctx_alloc(app_ctx);
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+
+    xremote_app_view_alloc2(app, XRemoteViewTranslate, xremote_translate_view_alloc, translate);
+    xremote_app_view_set_previous_callback(app, xremote_translate_view_exit_callback);
+    xremote_app_set_user_context(app, translate, xremote_translate_clear_callback);
+
+    translate->view = app->view_ctx;
+    xremote_translate_start(translate);
+    return app;
+}
@@ -0,0 +1,38 @@
+/*!
+ *  @file flipper-xremote/xremote_translate.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Translator retransmitting received codes as the mapped ones of another remote.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "xremote_signal.h"
+
+#define XREMOTE_TRANSLATE_FILE     APP_DATA_PATH("translate.txt")
+#define XREMOTE_TRANSLATE_FILETYPE "XRemote Translate"
+#define XREMOTE_TRANSLATE_VERSION  1
+
+typedef struct {
+    InfraredMessage message;
+    size_t timings_size;
+    const char* target;
+    bool is_raw;
+    bool valid;
+} XRemoteTranslateLast;
+
+typedef struct XRemoteTranslate XRemoteTranslate;
+
+XRemoteAppContext* xremote_translate_get_app_context(XRemoteTranslate* translate);
+size_t xremote_translate_get_mappings(XRemoteTranslate* translate);
+uint32_t xremote_translate_get_sent(XRemoteTranslate* translate);
+uint32_t xremote_translate_get_missed(XRemoteTranslate* translate);
+bool xremote_translate_get_last(XRemoteTranslate* translate, XRemoteTranslateLast* last);
+bool xremote_translate_is_running(XRemoteTranslate* translate);
+
+void xremote_translate_send_event(XRemoteTranslate* translate, uint32_t event);
+void xremote_translate_toggle(XRemoteTranslate* translate);
+
+XRemoteApp* xremote_translate_alloc(XRemoteAppContext* app_ctx);
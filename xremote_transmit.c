@@ -0,0 +1,308 @@
+/*!
+ *  @file flipper-xremote/xremote_transmit.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Asynchronous infrared signal transmitter running in its own thread.
+ */
+
+#include "xremote_transmit.h"
+#include "xremote_app.h"
+#include "xremote_cache.h"
+
+#define TAG "XRemoteTransmit"
+
+typedef enum {
+    XRemoteTransmitterFlagSend = (1 << 0),
+    XRemoteTransmitterFlagRepeat = (1 << 1),
+    XRemoteTransmitterFlagExit = (1 << 2)
+} XRemoteTransmitterFlag;
+
+typedef struct {
+    InfraredSignal** signals;
+    InfraredSignal* signal;
+    InfraredMessage message;
+    bool is_message;
+    size_t count;
+    int times;
+} XRemoteTransmitItem;
+
+struct XRemoteTransmitter {
+    XRemoteTransmitItem queue[XREMOTE_TRANSMIT_QUEUE_SIZE];
+    NotificationApp* notifications;
+    FuriThread* thread;
+    FuriTimer* timer;
+    XRemoteCache* cache;
+    XRemoteDiag* diag;
+    uint32_t blink_tick;
+
+    /* Held signal is repeated by the TX thread on every timer tick */
+    InfraredSignal* hold_signal;
+    bool holding;
+    bool busy;
+
+    /* Single producer (GUI thread) and single consumer (TX thread) indexes */
+    uint32_t head;
+    uint32_t tail;
+};
+
+static void xremote_transmitter_blink(XRemoteTransmitter* tx_ctx) {
+    /* Coalesce blinks so continuous transmit does not flood notifications */
+    uint32_t now = furi_get_tick();
+    if(now - tx_ctx->blink_tick < furi_ms_to_ticks(XREMOTE_TRANSMIT_BLINK_PERIOD)) return;
+
+    xremote_app_notification_blink(tx_ctx->notifications);
+    XREMOTE_LATENCY_MARK(tx_ctx->diag, XRemoteLatencyNotify);
+    tx_ctx->blink_tick = now;
+}
+
+static void xremote_transmitter_send_signal(
+    XRemoteTransmitter* tx_ctx,
+    InfraredSignal* signal,
+    int times) {
+    if(tx_ctx->cache != NULL && !infrared_signal_is_raw(signal)) {
+        InfraredMessage* message = infrared_signal_get_message(signal);
+        XRemoteCacheEntry* entry = xremote_cache_find(tx_ctx->cache, message, times);
+        xremote_diag_cache_access(tx_ctx->diag, entry != NULL);
+
+        if(entry == NULL) {
+            /* Encode once, next presses go straight to the raw transmit */
+            uint32_t start = xremote_diag_start();
+            entry = xremote_cache_add(tx_ctx->cache, message, times);
+            xremote_diag_stop(tx_ctx->diag, XRemoteDiagEncode, start);
+        }
+
+        if(entry != NULL) {
+            infrared_send_raw_ext(
+                entry->timings, entry->timings_size, true, entry->frequency, entry->duty_cycle);
+            return;
+        }
+    }
+
+    infrared_signal_transmit_times(signal, times);
+}
+
+static void xremote_transmitter_send_item(XRemoteTransmitter* tx_ctx, XRemoteTransmitItem* item) {
+    /* Generated messages are encoded on the fly and never cached */
+    if(item->is_message) {
+        infrared_send(&item->message, item->times);
+        return;
+    }
+
+    InfraredSignal** signals = item->signals ? item->signals : &item->signal;
+
+    for(size_t i = 0; i < item->count; i++) {
+        /* Keep only the minimum silence between the signals of a batch */
+        if(i > 0) furi_delay_us(infrared_signal_get_gap(signals[i - 1]));
+        xremote_transmitter_send_signal(tx_ctx, signals[i], item->times);
+    }
+}
+
+static void xremote_transmitter_timer_callback(void* context) {
+    XRemoteTransmitter* tx_ctx = context;
+    furi_thread_flags_set(furi_thread_get_id(tx_ctx->thread), XRemoteTransmitterFlagRepeat);
+}
+
+static void xremote_transmitter_repeat(XRemoteTransmitter* tx_ctx) {
+    /* Busy is raised before holding is checked, so flush never misses a frame in flight */
+    __atomic_store_n(&tx_ctx->busy, true, __ATOMIC_SEQ_CST);
+
+    if(__atomic_load_n(&tx_ctx->holding, __ATOMIC_SEQ_CST)) {
+        /* Signal may be rearmed at any time, the one read here is sent as a whole */
+        InfraredSignal* signal = __atomic_load_n(&tx_ctx->hold_signal, __ATOMIC_ACQUIRE);
+
+        /* Full frame went out with the press, receivers expect only repeat frames now */
+        uint32_t start = xremote_diag_start();
+        infrared_signal_transmit_frame(signal, true);
+        xremote_diag_stop(tx_ctx->diag, XRemoteDiagTransmit, start);
+        xremote_transmitter_blink(tx_ctx);
+    }
+
+    __atomic_store_n(&tx_ctx->busy, false, __ATOMIC_SEQ_CST);
+}
+
+static int32_t xremote_transmitter_thread(void* context) {
+    XRemoteTransmitter* tx_ctx = context;
+    uint32_t flags = 0;
+
+    while(!(flags & XRemoteTransmitterFlagExit)) {
+        flags = furi_thread_flags_wait(
+            XRemoteTransmitterFlagSend | XRemoteTransmitterFlagRepeat |
+                XRemoteTransmitterFlagExit,
+            FuriFlagWaitAny,
+            FuriWaitForever);
+
+        if(flags & FuriFlagError) {
+            flags = 0;
+            continue;
+        }
+
+        uint32_t tail = tx_ctx->tail;
+        while(tail != __atomic_load_n(&tx_ctx->head, __ATOMIC_ACQUIRE)) {
+            XRemoteTransmitItem* item = &tx_ctx->queue[tail % XREMOTE_TRANSMIT_QUEUE_SIZE];
+
+            uint32_t start = xremote_diag_start();
+            XREMOTE_LATENCY_MARK(tx_ctx->diag, XRemoteLatencyTxStart);
+            xremote_transmitter_send_item(tx_ctx, item);
+            XREMOTE_LATENCY_MARK(tx_ctx->diag, XRemoteLatencyTxEnd);
+            xremote_diag_stop(tx_ctx->diag, XRemoteDiagTransmit, start);
+            xremote_transmitter_blink(tx_ctx);
+
+            /* Slot is released only after the signal is off the air */
+            __atomic_store_n(&tx_ctx->tail, ++tail, __ATOMIC_RELEASE);
+        }
+
+        if(flags & XRemoteTransmitterFlagRepeat) xremote_transmitter_repeat(tx_ctx);
+    }
+
+    return 0;
+}
+
+XRemoteTransmitter* xremote_transmitter_alloc(NotificationApp* notifications, XRemoteDiag* diag) {
+    XRemoteTransmitter* tx_ctx = malloc(sizeof(XRemoteTransmitter));
+    xremote_app_assert(tx_ctx, NULL);
+
+    tx_ctx->notifications = notifications;
+    tx_ctx->diag = diag;
+    tx_ctx->head = 0;
+    tx_ctx->tail = 0;
+
+    tx_ctx->blink_tick = furi_get_tick() - furi_ms_to_ticks(XREMOTE_TRANSMIT_BLINK_PERIOD);
+    tx_ctx->hold_signal = NULL;
+    tx_ctx->holding = false;
+    tx_ctx->busy = false;
+
+    /* Cache budget of zero disables pre-encoding */
+    tx_ctx->cache = XREMOTE_CACHE_BYTES ? xremote_cache_alloc(XREMOTE_CACHE_BYTES) : NULL;
+
+    tx_ctx->timer = furi_timer_alloc(
+        xremote_transmitter_timer_callback, FuriTimerTypePeriodic, tx_ctx);
+
+    tx_ctx->thread = furi_thread_alloc_ex(
+        "XRemoteTx", XREMOTE_TRANSMIT_STACK_SIZE, xremote_transmitter_thread, tx_ctx);
+
+    furi_thread_start(tx_ctx->thread);
+    xremote_diag_add_thread(diag, "stack_tx", furi_thread_get_id(tx_ctx->thread));
+
+    return tx_ctx;
+}
+
+void xremote_transmitter_free(XRemoteTransmitter* tx_ctx) {
+    xremote_app_assert_void(tx_ctx);
+    FuriThreadId thread_id = furi_thread_get_id(tx_ctx->thread);
+    xremote_diag_remove_thread(tx_ctx->diag, thread_id);
+
+    xremote_transmitter_release(tx_ctx);
+    furi_timer_free(tx_ctx->timer);
+
+    /* Pending signals are sent before the thread exits */
+    furi_thread_flags_set(thread_id, XRemoteTransmitterFlagExit);
+    furi_thread_join(tx_ctx->thread);
+    furi_thread_free(tx_ctx->thread);
+    xremote_cache_free(tx_ctx->cache);
+
+    free(tx_ctx);
+}
+
+static bool xremote_transmitter_push(XRemoteTransmitter* tx_ctx, const XRemoteTransmitItem* item) {
+    uint32_t tail = __atomic_load_n(&tx_ctx->tail, __ATOMIC_ACQUIRE);
+    uint32_t head = tx_ctx->head;
+
+    if(head - tail >= XREMOTE_TRANSMIT_QUEUE_SIZE) {
+        FURI_LOG_W(TAG, "queue is full, dropping signal");
+        xremote_diag_queue_drop(tx_ctx->diag);
+        return false;
+    }
+
+    tx_ctx->queue[head % XREMOTE_TRANSMIT_QUEUE_SIZE] = *item;
+
+    __atomic_store_n(&tx_ctx->head, head + 1, __ATOMIC_RELEASE);
+    xremote_diag_queue_depth(tx_ctx->diag, head + 1 - tail);
+
+    furi_thread_flags_set(furi_thread_get_id(tx_ctx->thread), XRemoteTransmitterFlagSend);
+    return true;
+}
+
+bool xremote_transmitter_send(XRemoteTransmitter* tx_ctx, InfraredSignal* signal, int times) {
+    xremote_app_assert(signal, false);
+    XRemoteTransmitItem item = {.signal = signal, .count = 1, .times = times};
+    return xremote_transmitter_push(tx_ctx, &item);
+}
+
+bool xremote_transmitter_send_batch(
+    XRemoteTransmitter* tx_ctx,
+    InfraredSignal** signals,
+    size_t count,
+    int times) {
+    xremote_app_assert((signals && count), false);
+    XRemoteTransmitItem item = {.signals = signals, .count = count, .times = times};
+    return xremote_transmitter_push(tx_ctx, &item);
+}
+
+bool xremote_transmitter_send_message(
+    XRemoteTransmitter* tx_ctx,
+    const InfraredMessage* message,
+    int times) {
+    xremote_app_assert(message, false);
+    XRemoteTransmitItem item = {.message = *message, .is_message = true, .times = times};
+    return xremote_transmitter_push(tx_ctx, &item);
+}
+
+size_t xremote_transmitter_get_pending(XRemoteTransmitter* tx_ctx) {
+    xremote_app_assert(tx_ctx, 0);
+    return tx_ctx->head - __atomic_load_n(&tx_ctx->tail, __ATOMIC_ACQUIRE);
+}
+
+void xremote_transmitter_flush(XRemoteTransmitter* tx_ctx) {
+    xremote_app_assert_void(tx_ctx);
+    xremote_transmitter_release(tx_ctx);
+
+    /* Wait until every queued signal is transmitted and released */
+    while(__atomic_load_n(&tx_ctx->tail, __ATOMIC_ACQUIRE) != tx_ctx->head) furi_delay_tick(1);
+    while(__atomic_load_n(&tx_ctx->busy, __ATOMIC_SEQ_CST)) furi_delay_tick(1);
+
+    /* Encoded timings of the finished session are released, entries never go stale */
+    xremote_cache_clear(tx_ctx->cache);
+}
+
+static uint32_t xremote_transmitter_get_period(InfraredSignal* signal) {
+    uint32_t period_us = 0;
+
+    if(infrared_signal_is_raw(signal)) {
+        InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+        size_t frame_size = raw->timings_size;
+
+        /* Trailing space is replaced by the gap the raw transmit keeps between frames */
+        if(frame_size > 1 && frame_size % 2 == 0) frame_size--;
+        for(size_t i = 0; i < frame_size; i++) period_us += raw->timings[i];
+        period_us += infrared_signal_get_gap(signal);
+    } else {
+        /* Every protocol has its own spacing, SIRC repeats twice as fast as NEC */
+        period_us = infrared_signal_get_repeat_period(infrared_signal_get_message(signal));
+    }
+
+    uint32_t period = period_us / 1000;
+    return period ? period : XREMOTE_TRANSMIT_HOLD_PERIOD;
+}
+
+bool xremote_transmitter_hold(XRemoteTransmitter* tx_ctx, InfraredSignal* signal) {
+    xremote_app_assert(signal, false);
+    xremote_transmitter_release(tx_ctx);
+
+    /* Frame in flight keeps its signal, the TX thread picks the new one on the next tick */
+    __atomic_store_n(&tx_ctx->hold_signal, signal, __ATOMIC_RELEASE);
+    __atomic_store_n(&tx_ctx->holding, true, __ATOMIC_SEQ_CST);
+
+    uint32_t period = xremote_transmitter_get_period(signal);
+    furi_timer_start(tx_ctx->timer, furi_ms_to_ticks(period));
+    return true;
+}
+
+void xremote_transmitter_release(XRemoteTransmitter* tx_ctx) {
+    xremote_app_assert_void(tx_ctx);
+    if(!__atomic_load_n(&tx_ctx->holding, __ATOMIC_SEQ_CST)) return;
+
+    /* Frame in flight is finished by the TX thread, no new ones are started */
+    __atomic_store_n(&tx_ctx->holding, false, __ATOMIC_SEQ_CST);
+    furi_timer_stop(tx_ctx->timer);
+}
@@ -0,0 +1,47 @@
+/*!
+ *  @file flipper-xremote/xremote_transmit.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Asynchronous infrared signal transmitter running in its own thread.
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <notification/notification.h>
+
+#include "infrared/infrared_signal.h"
+#include "xremote_diag.h"
+
+#define XREMOTE_TRANSMIT_QUEUE_SIZE 8
+#define XREMOTE_TRANSMIT_STACK_SIZE 1024
+
+/* Hold period follows the protocol or raw frame, this one is used when it is unknown */
+#define XREMOTE_TRANSMIT_HOLD_PERIOD  110
+#define XREMOTE_TRANSMIT_BLINK_PERIOD 250
+
+typedef struct XRemoteTransmitter XRemoteTransmitter;
+
+XRemoteTransmitter* xremote_transmitter_alloc(NotificationApp* notifications, XRemoteDiag* diag);
+void xremote_transmitter_free(XRemoteTransmitter* tx_ctx);
+
+/* Signal is referenced, not copied, and must stay valid until it is sent */
+bool xremote_transmitter_send(XRemoteTransmitter* tx_ctx, InfraredSignal* signal, int times);
+/* Sends signals back to back, array is referenced and must stay valid until sent */
+bool xremote_transmitter_send_batch(
+    XRemoteTransmitter* tx_ctx,
+    InfraredSignal** signals,
+    size_t count,
+    int times);
+/* Message is copied into the queue, nothing has to outlive the call */
+bool xremote_transmitter_send_message(
+    XRemoteTransmitter* tx_ctx,
+    const InfraredMessage* message,
+    int times);
+size_t xremote_transmitter_get_pending(XRemoteTransmitter* tx_ctx);
+void xremote_transmitter_flush(XRemoteTransmitter* tx_ctx);
+
+/* Keep sending repeat frames of the signal already sent in full until it is released */
+bool xremote_transmitter_hold(XRemoteTransmitter* tx_ctx, InfraredSignal* signal);
+void xremote_transmitter_release(XRemoteTransmitter* tx_ctx);
@@ -0,0 +1,402 @@
+/*!
+ *  @file flipper-xremote/xremote_universal.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Streaming brute-force of one button over a universal library.
+ */
+
+#include "xremote_universal.h"
+#include "views/xremote_universal_view.h"
+
+#include <toolbox/path.h>
+#include <toolbox/stream/stream.h>
+
+#define TAG "XRemoteUniversal"
+
+typedef struct {
+    uint32_t timings[XREMOTE_UNIVERSAL_TIMINGS];
+    InfraredSignal* signal;
+} XRemoteUniversalSlot;
+
+struct XRemoteUniversal {
+    XRemoteUniversalSlot slots[XREMOTE_UNIVERSAL_SLOTS];
+    uint8_t slot;
+
+    /* File offsets of the last matching records, replayed without scanning */
+    size_t history[XREMOTE_UNIVERSAL_HISTORY];
+    uint32_t cursor;
+    uint32_t count;
+    uint32_t skipped;
+
+    XRemoteAppContext* app_ctx;
+    XRemoteUniversalState state;
+    FuriString* record_name;
+    FuriString* name;
+    XRemoteView* view;
+    FuriTimer* timer;
+    FlipperFormat* ff;
+    int command;
+
+    size_t data_offset;
+    size_t scan_offset;
+    size_t file_size;
+};
+
+XRemoteAppContext* xremote_universal_get_app_context(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, NULL);
+    return universal->app_ctx;
+}
+
+XRemoteUniversalState xremote_universal_get_state(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, XRemoteUniversalStateIdle);
+    return universal->state;
+}
+
+const char* xremote_universal_get_state_str(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, "");
+    if(universal->state == XRemoteUniversalStateRunning) return "Sending";
+    if(universal->state == XRemoteUniversalStatePaused) return "Paused";
+    if(universal->state == XRemoteUniversalStateDone) return "Done";
+    return "Ready";
+}
+
+const char* xremote_universal_get_name(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, "");
+    return furi_string_get_cstr(universal->name);
+}
+
+const char* xremote_universal_get_command_name(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, "");
+    return xremote_button_get_name(universal->command);
+}
+
+uint32_t xremote_universal_get_position(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, 0);
+    return universal->count ? universal->cursor + 1 : 0;
+}
+
+uint32_t xremote_universal_get_count(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, 0);
+    return universal->count;
+}
+
+uint32_t xremote_universal_get_skipped(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, 0);
+    return universal->skipped;
+}
+
+float xremote_universal_get_progress(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, 0.0f);
+    size_t size = universal->file_size - universal->data_offset;
+    return size ? (float)(universal->scan_offset - universal->data_offset) / size : 0.0f;
+}
+
+static void xremote_universal_update_view(XRemoteUniversal* universal) {
+    if(universal->view == NULL) return;
+
+    with_view_model(
+        xremote_view_get_view(universal->view),
+        XRemoteViewModel * model,
+        { model->context = universal; },
+        true);
+}
+
+static bool xremote_universal_read_body(XRemoteUniversal* universal) {
+    XRemoteUniversalSlot* slot = &universal->slots[universal->slot];
+    return infrared_signal_read_body_ref(
+        slot->signal, universal->ff, slot->timings, XREMOTE_UNIVERSAL_TIMINGS);
+}
+
+static InfraredSignal* xremote_universal_load(XRemoteUniversal* universal, uint32_t index) {
+    Stream* stream = flipper_format_get_raw_stream(universal->ff);
+    size_t offset = universal->history[index % XREMOTE_UNIVERSAL_HISTORY];
+
+    if(!stream_seek(stream, offset, StreamOffsetFromStart)) return NULL;
+    if(!xremote_universal_read_body(universal)) return NULL;
+
+    universal->cursor = index;
+    return universal->slots[universal->slot].signal;
+}
+
+static InfraredSignal* xremote_universal_read_next(XRemoteUniversal* universal) {
+    Stream* stream = flipper_format_get_raw_stream(universal->ff);
+    const char* command = xremote_button_get_name(universal->command);
+
+    if(!stream_seek(stream, universal->scan_offset, StreamOffsetFromStart)) return NULL;
+
+    /* Only one record is in memory, everything else stays in the file */
+    while(flipper_format_read_string(universal->ff, "name", universal->record_name)) {
+        if(furi_string_cmpi_str(universal->record_name, command) != 0) continue;
+
+        size_t offset = stream_tell(stream);
+        bool loaded = xremote_universal_read_body(universal);
+        universal->scan_offset = stream_tell(stream);
+
+        if(!loaded) {
+            FURI_LOG_W(TAG, "skipping unsupported record at %u", offset);
+            universal->skipped++;
+            continue;
+        }
+
+        universal->history[universal->count % XREMOTE_UNIVERSAL_HISTORY] = offset;
+        universal->cursor = universal->count++;
+        return universal->slots[universal->slot].signal;
+    }
+
+    universal->scan_offset = universal->file_size;
+    return NULL;
+}
+
+static InfraredSignal* xremote_universal_advance(XRemoteUniversal* universal, bool forward) {
+    uint32_t cursor = universal->cursor;
+    uint32_t count = universal->count;
+
+    if(!forward) {
+        /* Only the records which are still in the history can be replayed */
+        if(!count || !cursor || cursor - 1 + XREMOTE_UNIVERSAL_HISTORY < count) return NULL;
+        return xremote_universal_load(universal, cursor - 1);
+    }
+
+    if(count && cursor + 1 < count) return xremote_universal_load(universal, cursor + 1);
+    return xremote_universal_read_next(universal);
+}
+
+static bool xremote_universal_is_slot_free(XRemoteUniversal* universal) {
+    /* Slot being filled was queued XREMOTE_UNIVERSAL_SLOTS sends ago */
+    XRemoteTransmitter* transmitter = universal->app_ctx->transmitter;
+    return xremote_transmitter_get_pending(transmitter) < XREMOTE_UNIVERSAL_SLOTS;
+}
+
+static bool xremote_universal_send(XRemoteUniversal* universal, InfraredSignal* signal) {
+    XRemoteAppContext* app_ctx = universal->app_ctx;
+    uint32_t repeat = app_ctx->app_settings->repeat_count;
+
+    XRemoteTransmitter* transmitter = app_ctx->transmitter;
+    bool sent = false;
+
+    /* Parsed records are copied into the queue, slot reuse never reaches the encode cache */
+    if(infrared_signal_is_raw(signal))
+        sent = xremote_transmitter_send(transmitter, signal, repeat);
+    else
+        sent = xremote_transmitter_send_message(
+            transmitter, infrared_signal_get_message(signal), repeat);
+
+    if(!sent) return false;
+    universal->slot = (universal->slot + 1) % XREMOTE_UNIVERSAL_SLOTS;
+
+    return true;
+}
+
+static void xremote_universal_run_step(XRemoteUniversal* universal) {
+    if(!xremote_universal_is_slot_free(universal)) return;
+    InfraredSignal* signal = xremote_universal_advance(universal, true);
+
+    if(signal == NULL) {
+        furi_timer_stop(universal->timer);
+        universal->state = XRemoteUniversalStateDone;
+    } else {
+        xremote_universal_send(universal, signal);
+    }
+
+    xremote_universal_update_view(universal);
+}
+
+static void xremote_universal_timer_callback(void* context) {
+    XRemoteUniversal* universal = context;
+    ViewDispatcher* view_disp = universal->app_ctx->view_dispatcher;
+    view_dispatcher_send_custom_event(view_disp, XRemoteEventUniversalStep);
+}
+
+static bool xremote_universal_custom_event_callback(void* context, uint32_t event) {
+    xremote_app_assert(context, false);
+    XRemoteUniversal* universal = context;
+
+    /* Records are read and queued from GUI thread, file and queue have one user */
+    if(event == XRemoteEventUniversalStep && universal->state == XRemoteUniversalStateRunning)
+        xremote_universal_run_step(universal);
+
+    return true;
+}
+
+void xremote_universal_reset(XRemoteUniversal* universal) {
+    xremote_app_assert_void(universal);
+    furi_timer_stop(universal->timer);
+
+    universal->state = XRemoteUniversalStateIdle;
+    universal->scan_offset = universal->data_offset;
+    universal->skipped = 0;
+    universal->cursor = 0;
+    universal->count = 0;
+}
+
+void xremote_universal_next_command(XRemoteUniversal* universal, bool forward) {
+    xremote_app_assert_void(universal);
+    if(universal->state != XRemoteUniversalStateIdle) return;
+
+    int step = forward ? 1 : XREMOTE_BUTTON_COUNT - 1;
+    universal->command = (universal->command + step) % XREMOTE_BUTTON_COUNT;
+}
+
+void xremote_universal_start(XRemoteUniversal* universal) {
+    xremote_app_assert_void(universal);
+    if(universal->state == XRemoteUniversalStateRunning) return;
+    if(universal->state == XRemoteUniversalStateDone) xremote_universal_reset(universal);
+
+    universal->state = XRemoteUniversalStateRunning;
+    furi_timer_start(universal->timer, 1);
+
+    dolphin_deed(DolphinDeedIrSend);
+    xremote_universal_run_step(universal);
+}
+
+void xremote_universal_pause(XRemoteUniversal* universal) {
+    xremote_app_assert_void(universal);
+    if(universal->state != XRemoteUniversalStateRunning) return;
+
+    furi_timer_stop(universal->timer);
+    universal->state = XRemoteUniversalStatePaused;
+    xremote_universal_update_view(universal);
+}
+
+bool xremote_universal_step(XRemoteUniversal* universal, bool forward) {
+    xremote_app_assert(universal, false);
+    XRemoteUniversalState state = universal->state;
+
+    if(state != XRemoteUniversalStatePaused && state != XRemoteUniversalStateDone) return false;
+    if(!xremote_universal_is_slot_free(universal)) return false;
+
+    InfraredSignal* signal = xremote_universal_advance(universal, forward);
+    xremote_app_assert(signal, false);
+
+    xremote_universal_update_view(universal);
+    return xremote_universal_send(universal, signal);
+}
+
+bool xremote_universal_resend(XRemoteUniversal* universal) {
+    xremote_app_assert(universal, false);
+    XRemoteUniversalState state = universal->state;
+
+    if(state != XRemoteUniversalStatePaused && state != XRemoteUniversalStateDone) return false;
+    if(!universal->count || !xremote_universal_is_slot_free(universal)) return false;
+
+    InfraredSignal* signal = xremote_universal_load(universal, universal->cursor);
+    xremote_app_assert(signal, false);
+
+    return xremote_universal_send(universal, signal);
+}
+
+static bool xremote_universal_open(XRemoteUniversal* universal, FuriString* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* header = furi_string_alloc();
+    universal->ff = flipper_format_buffered_file_alloc(storage);
+
+    FURI_LOG_I(TAG, "open library: \'%s\'", furi_string_get_cstr(path));
+    uint32_t version = 0;
+    bool success = false;
+
+    do {
+        /* Universal libraries and regular remotes share the record layout */
+        if(!flipper_format_buffered_file_open_existing(universal->ff, furi_string_get_cstr(path)))
+            break;
+        if(!flipper_format_read_header(universal->ff, header, &version)) break;
+        if(!furi_string_equal(header, "IR library file") &&
+           !furi_string_equal(header, "IR signals file"))
+            break;
+
+        Stream* stream = flipper_format_get_raw_stream(universal->ff);
+        universal->data_offset = stream_tell(stream);
+        universal->file_size = stream_size(stream);
+        success = true;
+    } while(false);
+
+    furi_string_free(header);
+    return success;
+}
+
+static void xremote_universal_free(XRemoteUniversal* universal) {
+    xremote_app_assert_void(universal);
+    furi_timer_stop(universal->timer);
+    furi_timer_free(universal->timer);
+
+    ViewDispatcher* view_disp = universal->app_ctx->view_dispatcher;
+    view_dispatcher_set_custom_event_callback(view_disp, NULL);
+    view_dispatcher_set_event_callback_context(view_disp, NULL);
+
+    /* Queued signals reference the timings of the slots */
+    xremote_transmitter_flush(universal->app_ctx->transmitter);
+
+    for(size_t i = 0; i < XREMOTE_UNIVERSAL_SLOTS; i++)
+        infrared_signal_free(universal->slots[i].signal);
+
+    flipper_format_free(universal->ff);
+    furi_record_close(RECORD_STORAGE);
+
+    furi_string_free(universal->record_name);
+    furi_string_free(universal->name);
+    free(universal);
+}
+
+static void xremote_universal_clear_callback(void* context) {
+    XRemoteUniversal* universal = context;
+    xremote_universal_free(universal);
+}
+
+static XRemoteUniversal*
+    xremote_universal_alloc_from_path(XRemoteAppContext* app_ctx, FuriString* path) {
+    XRemoteUniversal* universal = malloc(sizeof(XRemoteUniversal));
+    universal->command = xremote_button_get_index(XREMOTE_COMMAND_POWER);
+    universal->record_name = furi_string_alloc();
+    universal->name = furi_string_alloc();
+    universal->app_ctx = app_ctx;
+    universal->view = NULL;
+    universal->slot = 0;
+
+    for(size_t i = 0; i < XREMOTE_UNIVERSAL_SLOTS; i++)
+        universal->slots[i].signal = infrared_signal_alloc();
+
+    path_extract_filename(path, universal->name, true);
+    universal->data_offset = 0;
+    universal->file_size = 0;
+
+    universal->timer =
+        furi_timer_alloc(xremote_universal_timer_callback, FuriTimerTypePeriodic, universal);
+    view_dispatcher_set_custom_event_callback(
+        app_ctx->view_dispatcher, xremote_universal_custom_event_callback);
+    view_dispatcher_set_event_callback_context(app_ctx->view_dispatcher, universal);
+
+    bool success = xremote_universal_open(universal, path);
+    xremote_universal_reset(universal);
+
+    if(!success) {
+        xremote_universal_free(universal);
+        return NULL;
+    }
+
+    return universal;
+}
+
+static uint32_t xremote_universal_view_exit_callback(void* context) {
+    UNUSED(context);
+    return XRemoteViewSubmenu;
+}
+
+XRemoteApp* xremote_universal_alloc(XRemoteAppContext* app_ctx) {
+    FuriString* path = NULL;
+    XRemoteUniversal* universal = NULL;
+
+    /* Show file selection dialog, library stays open and is read record by record */
+    if(xremote_app_browser_select_file(&path, XREMOTE_APP_EXTENSION))
+        universal = xremote_universal_alloc_from_path(app_ctx, path);
+
+    if(path != NULL) furi_string_free(path);
+    xremote_app_assert(universal, NULL);
+
+    XRemoteApp* app = xremote_app_alloc(app_ctx);
+    xremote_app_view_alloc2(app, XRemoteViewUniversal, xremote_universal_view_alloc, universal);
+    xremote_app_view_set_previous_callback(app, xremote_universal_view_exit_callback);
+    xremote_app_set_user_context(app, universal, xremote_universal_clear_callback);
+
+    universal->view = app->view_ctx;
+    return app;
+}
@@ -0,0 +1,44 @@
+/*!
+ *  @file flipper-xremote/xremote_universal.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Streaming brute-force of one button over a universal library.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+
+/* Two slots, one on the air while the next record is read into the other */
+#define XREMOTE_UNIVERSAL_SLOTS   2
+#define XREMOTE_UNIVERSAL_TIMINGS 512
+#define XREMOTE_UNIVERSAL_HISTORY 16
+
+typedef enum {
+    XRemoteUniversalStateIdle,
+    XRemoteUniversalStateRunning,
+    XRemoteUniversalStatePaused,
+    XRemoteUniversalStateDone
+} XRemoteUniversalState;
+
+typedef struct XRemoteUniversal XRemoteUniversal;
+
+XRemoteAppContext* xremote_universal_get_app_context(XRemoteUniversal* universal);
+XRemoteUniversalState xremote_universal_get_state(XRemoteUniversal* universal);
+const char* xremote_universal_get_state_str(XRemoteUniversal* universal);
+const char* xremote_universal_get_name(XRemoteUniversal* universal);
+const char* xremote_universal_get_command_name(XRemoteUniversal* universal);
+uint32_t xremote_universal_get_position(XRemoteUniversal* universal);
+uint32_t xremote_universal_get_count(XRemoteUniversal* universal);
+uint32_t xremote_universal_get_skipped(XRemoteUniversal* universal);
+float xremote_universal_get_progress(XRemoteUniversal* universal);
+
+void xremote_universal_next_command(XRemoteUniversal* universal, bool forward);
+void xremote_universal_start(XRemoteUniversal* universal);
+void xremote_universal_pause(XRemoteUniversal* universal);
+void xremote_universal_reset(XRemoteUniversal* universal);
+bool xremote_universal_step(XRemoteUniversal* universal, bool forward);
+bool xremote_universal_resend(XRemoteUniversal* universal);
+
+XRemoteApp* xremote_universal_alloc(XRemoteAppContext* app_ctx);
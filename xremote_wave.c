@@ -0,0 +1,181 @@
+/*!
+ *  @file flipper-xremote/xremote_wave.c
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Downsampled level summary of a signal for the waveform view.
+ */
+
+#include "xremote_wave.h"
+
+XRemoteWave* xremote_wave_alloc() {
+    XRemoteWave* wave = malloc(sizeof(XRemoteWave));
+    xremote_app_assert(wave, NULL);
+
+    wave->data = NULL;
+    wave->capacity = 0;
+    xremote_wave_build(wave, NULL, 0);
+    return wave;
+}
+
+void xremote_wave_free(XRemoteWave* wave) {
+    xremote_app_assert_void(wave);
+    if(wave->data != NULL) free(wave->data);
+    free(wave);
+}
+
+static void xremote_wave_fill(XRemoteWave* wave, uint32_t start, uint32_t end, uint8_t level) {
+    uint8_t* columns = wave->columns[0];
+    size_t first = start / wave->column_us;
+    size_t last = (end - 1) / wave->column_us;
+    if(last >= wave->count[0]) last = wave->count[0] - 1;
+
+    for(size_t i = first; i <= last; i++) columns[i] |= level;
+}
+
+static size_t xremote_wave_layout(XRemoteWave* wave) {
+    size_t total = 0;
+    wave->levels = 0;
+
+    /* Coarser levels are added until the whole signal fits the narrowest screen */
+    for(size_t count = wave->count[0]; wave->levels < XREMOTE_WAVE_LEVELS;) {
+        wave->count[wave->levels++] = count;
+        total += count;
+
+        if(count <= XREMOTE_WAVE_FIT_COLUMNS) break;
+        count = (count + 1) / 2;
+    }
+
+    return total;
+}
+
+bool xremote_wave_build(XRemoteWave* wave, const uint32_t* timings, size_t size) {
+    xremote_app_assert(wave, false);
+    memset(wave->columns, 0, sizeof(wave->columns));
+    memset(wave->count, 0, sizeof(wave->count));
+
+    wave->timings_size = size;
+    wave->total_us = 0;
+    wave->column_us = 1;
+    wave->offset = 0;
+    wave->levels = 0;
+    wave->zoom = 0;
+
+    uint32_t shortest = UINT32_MAX;
+    for(size_t i = 0; i < size; i++) {
+        wave->total_us += timings[i];
+        if(timings[i] && timings[i] < shortest) shortest = timings[i];
+    }
+
+    xremote_app_assert(wave->total_us, false);
+
+    /* Half of the shortest pulse per column, so even that one has a column of its own */
+    uint32_t resolution = MAX(shortest / 2, (uint32_t)XREMOTE_WAVE_COLUMN_MIN_US);
+    uint32_t limit = (wave->total_us + XREMOTE_WAVE_COLUMNS_MAX - 1) / XREMOTE_WAVE_COLUMNS_MAX;
+    wave->column_us = MAX(resolution, limit);
+    wave->count[0] = (wave->total_us + wave->column_us - 1) / wave->column_us;
+
+    size_t total = xremote_wave_layout(wave);
+    if(total > wave->capacity) {
+        if(wave->data != NULL) free(wave->data);
+        wave->data = malloc(total);
+        wave->capacity = total;
+    }
+
+    memset(wave->data, 0, total);
+    for(size_t level = 0, offset = 0; level < wave->levels; level++) {
+        wave->columns[level] = &wave->data[offset];
+        offset += wave->count[level];
+    }
+
+    uint32_t time = 0;
+
+    /* Every pulse marks the columns it touches, even the ones shorter than a column */
+    for(size_t i = 0; i < size; i++) {
+        if(!timings[i]) continue;
+        uint8_t level = i % 2 ? XREMOTE_WAVE_LOW : XREMOTE_WAVE_HIGH;
+        xremote_wave_fill(wave, time, time + timings[i], level);
+        time += timings[i];
+    }
+
+    for(size_t level = 1; level < wave->levels; level++) {
+        uint8_t* src = wave->columns[level - 1];
+        uint8_t* dst = wave->columns[level];
+
+        for(size_t i = 0; i < wave->count[level]; i++)
+            dst[i] = src[i * 2] | (i * 2 + 1 < wave->count[level - 1] ? src[i * 2 + 1] : 0);
+    }
+
+    return true;
+}
+
+bool xremote_wave_build_signal(XRemoteWave* wave, InfraredSignal* signal) {
+    xremote_app_assert(wave, false);
+    xremote_app_assert(signal, false);
+
+    if(infrared_signal_is_raw(signal)) {
+        InfraredRawSignal* raw = infrared_signal_get_raw_signal(signal);
+        return xremote_wave_build(wave, raw->timings, raw->timings_size);
+    }
+
+    /* Summary does not keep the timings, the encoded frame is needed only while building */
+    uint32_t* timings = malloc(XREMOTE_WAVE_TIMINGS * sizeof(uint32_t));
+    InfraredMessage* message = infrared_signal_get_message(signal);
+    size_t size = infrared_signal_encode_message(message, 1, timings, XREMOTE_WAVE_TIMINGS);
+
+    bool success = xremote_wave_build(wave, timings, size);
+    free(timings);
+
+    return success;
+}
+
+uint8_t xremote_wave_get_column(XRemoteWave* wave, size_t column) {
+    xremote_app_assert(wave, 0);
+    size_t index = wave->offset + column;
+    if(wave->zoom >= wave->levels || index >= wave->count[wave->zoom]) return 0;
+    return wave->columns[wave->zoom][index];
+}
+
+uint32_t xremote_wave_get_column_us(XRemoteWave* wave) {
+    xremote_app_assert(wave, 0);
+    return wave->column_us << wave->zoom;
+}
+
+static void xremote_wave_clamp(XRemoteWave* wave, size_t width) {
+    size_t count = wave->count[wave->zoom];
+    if(wave->offset + width > count) wave->offset = count > width ? count - width : 0;
+}
+
+void xremote_wave_fit(XRemoteWave* wave, size_t width) {
+    xremote_app_assert_void(wave);
+    wave->offset = 0;
+    wave->zoom = 0;
+
+    /* Finest zoom level which shows the whole signal on the screen */
+    while(wave->zoom + 1 < wave->levels && wave->count[wave->zoom] > width)
+        wave->zoom++;
+}
+
+void xremote_wave_zoom(XRemoteWave* wave, int step, size_t width) {
+    xremote_app_assert_void(wave);
+    int zoom = (int)wave->zoom + step;
+    if(zoom < 0 || zoom >= wave->levels) return;
+
+    /* Keep the center of the screen in place while zooming */
+    size_t center = wave->offset + width / 2;
+    center = step > 0 ? center >> step : center << -step;
+    wave->offset = center > width / 2 ? center - width / 2 : 0;
+    wave->zoom = zoom;
+
+    xremote_wave_clamp(wave, width);
+}
+
+void xremote_wave_scroll(XRemoteWave* wave, int step, size_t width) {
+    xremote_app_assert_void(wave);
+    if(step < 0 && (size_t)-step > wave->offset)
+        wave->offset = 0;
+    else
+        wave->offset += step;
+
+    xremote_wave_clamp(wave, width);
+}
@@ -0,0 +1,59 @@
+/*!
+ *  @file flipper-xremote/xremote_wave.h
+    @license This project is released under the GNU GPLv3 License
+ *  @copyright (c) 2023 Sandro Kalatozishvili (s.kalatoz@gmail.com)
+ *
+ * @brief Downsampled level summary of a signal for the waveform view.
+ */
+
+#pragma once
+
+#include "xremote_app.h"
+#include "infrared/infrared_signal.h"
+
+/* Finest column is not wider than the shortest pulse, within these resolution limits */
+#define XREMOTE_WAVE_COLUMN_MIN_US 10
+#define XREMOTE_WAVE_COLUMNS_MAX   4096
+
+/* Every next zoom level halves the columns until the whole signal fits the screen */
+#define XREMOTE_WAVE_LEVELS      16
+#define XREMOTE_WAVE_FIT_COLUMNS 64
+
+/* Decoded messages are encoded to a single frame of at most this many timings */
+#define XREMOTE_WAVE_TIMINGS 512
+
+/* Min and max level seen within a column */
+#define XREMOTE_WAVE_LOW  (1 << 0)
+#define XREMOTE_WAVE_HIGH (1 << 1)
+
+typedef struct {
+    /* Level 0 is the finest, each column of level N covers two of level N - 1 */
+    uint8_t* columns[XREMOTE_WAVE_LEVELS];
+    size_t count[XREMOTE_WAVE_LEVELS];
+    uint8_t levels;
+
+    /* All levels share one buffer which grows with the longest signal built so far */
+    uint8_t* data;
+    size_t capacity;
+    uint32_t column_us;
+    uint32_t total_us;
+    size_t timings_size;
+
+    /* View position, offset is the first visible column of the current zoom level */
+    uint8_t zoom;
+    size_t offset;
+} XRemoteWave;
+
+XRemoteWave* xremote_wave_alloc();
+void xremote_wave_free(XRemoteWave* wave);
+
+bool xremote_wave_build(XRemoteWave* wave, const uint32_t* timings, size_t size);
+bool xremote_wave_build_signal(XRemoteWave* wave, InfraredSignal* signal);
+
+/* Column flags of the current zoom level, zero past the end of the signal */
+uint8_t xremote_wave_get_column(XRemoteWave* wave, size_t column);
+uint32_t xremote_wave_get_column_us(XRemoteWave* wave);
+
+void xremote_wave_fit(XRemoteWave* wave, size_t width);
+void xremote_wave_zoom(XRemoteWave* wave, int step, size_t width);
+void xremote_wave_scroll(XRemoteWave* wave, int step, size_t width);